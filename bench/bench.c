@@ -0,0 +1,190 @@
+/*!****************************************************************************
+* @file    bench.c
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Driver microbenchmarks on the register-level models of test/mock,
+*          cycle counts per benchmark printed as CSV
+* @note     Cycles are CLK_PER cycles of the model (simStat.cycles): time
+*           spent waiting for the peripherals plus the cost of every register
+*           access. Instructions between accesses are not counted, nor
+*           are accesses to unmodelled peripherals such as PORT
+*/
+
+/*!****************************************************************************
+* Include
+*/
+#include <stdio.h>
+#include "bench.h"
+#include "sim.h"
+#include "clock.h"
+#include "adc.h"
+#include "spi.h"
+#include "eeprom.h"
+
+/*!****************************************************************************
+* Local define
+*/
+#define BENCH_EE_CELL                           0
+
+/*!****************************************************************************
+* Local typedef
+*/
+typedef struct{
+    uint64_t            cycles;                                                 //Sum over calls
+    uint32_t            min;
+    uint32_t            max;
+    uint32_t            units;                                                  //Of the last call
+    uint16_t            calls;
+}benchStat_type;
+
+/*!****************************************************************************
+* Local function prototypes
+*/
+void benchAdd(eBenchId id, uint32_t units, uint64_t start);
+void benchAdc(eBenchId id, ADC_SAMPNUM_t smpAccNum, uint16_t samples);
+void benchSpi(eBenchId id, uint16_t size);
+void benchEeprom(eBenchId id, uint8_t size);
+void benchPrint(void);
+
+/*!****************************************************************************
+* MEMORY
+*/
+static const char *const benchName[benchIdNum] = {
+    [benchIdAdcAcc1]    = "adc_getSample_acc1",
+    [benchIdAdcAcc16]   = "adc_getSample_acc16",
+    [benchIdSpi1]       = "spi_transmitReceive_1",
+    [benchIdSpi16]      = "spi_transmitReceive_16",
+    [benchIdSpi64]      = "spi_transmitReceive_64",
+    [benchIdEeprom1]    = "eeprom_write_1",
+    [benchIdEeprom32]   = "eeprom_write_32",
+    [benchIdEeprom64]   = "eeprom_write_64",
+};
+static benchStat_type benchStat[benchIdNum];
+uint8_t benchTx[BENCH_SPI_SIZE_MAX];
+uint8_t benchRx[BENCH_SPI_SIZE_MAX];
+volatile uint16_t benchSink;                                                    //Keeps results alive
+
+int main(void){
+    eBenchId id;
+    uint8_t i;
+
+    sim_reset();
+    if((clock_init(CLKCTRL_CLKSEL_OSC20M_gc, CLKCTRL_PDIV_2X_gc, false, false, false) != drvNoError) ||
+       (adc_init(&ADC0, ADC_RESSEL_10BIT_gc, ADC_DUTYCYC_DUTY50_gc, ADC_ASDV_ASVOFF_gc, 0) != drvNoError) ||
+       (spi_init() != drvNoError)){
+        fprintf(stderr, "driver init failed\n");
+        return 1;
+    }
+    sei();
+    for(i = 0; i < BENCH_SPI_SIZE_MAX; i++){
+        benchTx[i] = i;
+    }
+    benchAdc(benchIdAdcAcc1, ADC_SAMPNUM_ACC1_gc, 1);
+    benchAdc(benchIdAdcAcc16, ADC_SAMPNUM_ACC16_gc, 16);
+    benchSpi(benchIdSpi1, 1);
+    benchSpi(benchIdSpi16, 16);
+    benchSpi(benchIdSpi64, 64);
+    benchEeprom(benchIdEeprom1, 1);
+    benchEeprom(benchIdEeprom32, 32);
+    benchEeprom(benchIdEeprom64, BENCH_EE_SIZE_MAX);
+    benchPrint();
+    for(id = 0; id < benchIdNum; id++){
+        if(benchStat[id].calls != BENCH_REPEAT){
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/*!****************************************************************************
+* @brief    Account one call
+* @param    id - benchmark
+* @param    units - work units of the call
+* @param    start - model cycle count before the call
+*/
+void benchAdd(eBenchId id, uint32_t units, uint64_t start){
+    benchStat_type *pStat = &benchStat[id];
+    uint32_t cyc = (uint32_t)(simStat.cycles - start);
+
+    if((pStat->calls == 0) || (cyc < pStat->min)) pStat->min = cyc;
+    if(cyc > pStat->max) pStat->max = cyc;
+    pStat->cycles += cyc;
+    pStat->units = units;
+    pStat->calls++;
+}
+
+/*!****************************************************************************
+* @brief    Single channel sample, units are accumulated conversions
+*/
+void benchAdc(eBenchId id, ADC_SAMPNUM_t smpAccNum, uint16_t samples){
+    adcChannel_type ch = adcChInit(ADC0, ADC_INITDLY_DLY0_gc, ADC_MUXPOS_AIN3_gc, 0, 0, 0, ADC_PRESC_DIV16_gc,
+                                   ADC_REFSEL_VDDREF_gc, VREF_ADC_REFSEL_1V1_gc, smpAccNum, ADC_WINCM_NONE_gc);
+    uint64_t start;
+    uint16_t data, refMv;
+    uint8_t overSampled, i;
+
+    for(i = 0; i < BENCH_REPEAT; i++){
+        start = simStat.cycles;
+        if(adc_getSample(ch, &data, &overSampled, &refMv) != drvNoError) return;
+        benchAdd(id, samples * ADC_MEASUREMENTS_NUM, start);
+        benchSink = data;
+    }
+}
+
+/*!****************************************************************************
+* @brief    Full duplex transfer, units are bytes
+*/
+void benchSpi(eBenchId id, uint16_t size){
+    uint64_t start;
+    uint8_t i;
+
+    for(i = 0; i < BENCH_REPEAT; i++){
+        start = simStat.cycles;
+        if(spi_transmitReceive(benchTx, benchRx, size) != drvNoError) return;
+        benchAdd(id, size, start);
+    }
+    benchSink = benchRx[0];
+}
+
+/*!****************************************************************************
+* @brief    Page aligned write including NVM wait, units are bytes
+*/
+void benchEeprom(eBenchId id, uint8_t size){
+    uint64_t start;
+    uint8_t i;
+
+    for(i = 0; i < BENCH_REPEAT; i++){
+        start = simStat.cycles;
+        if(eeprom_write(SIM_EEPROM(BENCH_EE_CELL), benchTx, size) != drvNoError) return;
+        benchAdd(id, size, start);
+    }
+}
+
+/*!****************************************************************************
+* @brief    One CSV row per benchmark
+*/
+void benchPrint(void){
+    benchStat_type *pStat;
+    double perCall;
+    eBenchId id;
+
+    printf("bench,calls,units,cycles_min,cycles_max,cycles_per_call,cycles_per_unit\n");
+    for(id = 0; id < benchIdNum; id++){
+        pStat = &benchStat[id];
+        if(pStat->calls == 0){
+            fprintf(stderr, "%s: not run\n", benchName[id]);
+            continue;
+        }
+        perCall = (double)pStat->cycles / pStat->calls;
+        printf("%s,%u,%u,%u,%u,%.1f,", benchName[id], pStat->calls, pStat->units, pStat->min, pStat->max, perCall);
+        if(pStat->units != 0){
+            printf("%.2f\n", perCall / pStat->units);
+        }else{
+            printf("\n");
+        }
+    }
+}
+
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
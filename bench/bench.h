@@ -0,0 +1,40 @@
+/*!****************************************************************************
+* @file    bench.h
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Benchmark identifiers and sizes
+*/
+
+#ifndef bench_H
+#define bench_H
+
+/*!****************************************************************************
+* Include
+*/
+#include <stdint.h>
+
+/*!****************************************************************************
+* User define
+*/
+#define BENCH_REPEAT                            8                               //Calls measured per benchmark
+#define BENCH_SPI_SIZE_MAX                      64
+#define BENCH_EE_SIZE_MAX                       64
+
+/*!****************************************************************************
+* User enum
+*/
+typedef enum{
+    benchIdAdcAcc1,
+    benchIdAdcAcc16,
+    benchIdSpi1,
+    benchIdSpi16,
+    benchIdSpi64,
+    benchIdEeprom1,
+    benchIdEeprom32,
+    benchIdEeprom64,
+    benchIdNum
+}eBenchId;
+
+#endif //bench_H
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
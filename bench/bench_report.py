@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+# Merge benchmark cycles, per-function flash size and stack usage into JSON
+#
+# bench_report.py --cycles bench.csv [--nm avr-nm --su-dir <dir> --obj <file.o>...] [--mcu attiny3217]
+#
+# Cycles are CLK_PER cycles of the host peripheral models. Flash size comes
+# from the target objects built with a section per function, before any
+# --gc-sections, so fully inlined functions do not appear. Stack usage is the
+# static frame reported by -fstack-usage, callees are not added. Without
+# objects the report holds cycles only.
+
+import argparse
+import csv
+import glob
+import json
+import os
+import subprocess
+import sys
+
+
+def read_cycles(path):
+    with open(path, newline='') as f:
+        rows = []
+        for row in csv.DictReader(f):
+            rows.append({
+                'bench': row['bench'],
+                'calls': int(row['calls']),
+                'units': int(row['units']),
+                'cycles_min': int(row['cycles_min']),
+                'cycles_max': int(row['cycles_max']),
+                'cycles_per_call': float(row['cycles_per_call']),
+                'cycles_per_unit': float(row['cycles_per_unit']) if row['cycles_per_unit'] else None,
+            })
+        return rows
+
+
+def read_sizes(nm, objs):
+    if not objs:
+        return {}
+    out = subprocess.run([nm, '--print-size', '--size-sort', '--radix=d'] + objs,
+                         check=True, capture_output=True, text=True).stdout
+    sizes = {}
+    for line in out.splitlines():
+        fields = line.split()
+        if len(fields) == 4 and fields[2] in ('t', 'T'):
+            sizes[fields[3]] = int(fields[1])
+    return sizes
+
+
+def read_stack(su_dir):
+    # file:line:col:function<TAB>bytes<TAB>static|dynamic|bounded
+    stack = {}
+    if not su_dir:
+        return stack
+    for path in glob.glob(os.path.join(su_dir, '*.su')):
+        with open(path) as f:
+            for line in f:
+                fields = line.rstrip('\n').split('\t')
+                if len(fields) != 3:
+                    continue
+                func = fields[0].rsplit(':', 1)[-1]
+                stack[func] = {'bytes': int(fields[1]), 'type': fields[2],
+                               'file': os.path.basename(path)[:-len('.su')] + '.c'}
+    return stack
+
+
+def main():
+    ap = argparse.ArgumentParser(description='Benchmark report as JSON')
+    ap.add_argument('--cycles', required=True)
+    ap.add_argument('--obj', nargs='*', default=[])
+    ap.add_argument('--nm', default='avr-nm')
+    ap.add_argument('--su-dir')
+    ap.add_argument('--mcu', default='attiny3217')
+    ap.add_argument('--out')
+    args = ap.parse_args()
+
+    sizes = read_sizes(args.nm, args.obj)
+    stack = read_stack(args.su_dir)
+    functions = []
+    for name in sorted(sizes):
+        entry = {'function': name, 'flash': sizes[name]}
+        if name in stack:
+            entry['file'] = stack[name]['file']
+            entry['stack'] = stack[name]['bytes']
+            entry['stack_type'] = stack[name]['type']
+        functions.append(entry)
+    report = {
+        'mcu': args.mcu,
+        'benchmarks': read_cycles(args.cycles),
+        'functions': functions,
+    }
+    text = json.dumps(report, indent=2) + '\n'
+    if args.out:
+        with open(args.out, 'w') as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,20 @@
+# avr-gcc cross toolchain for tinyAVR 1-series
+#
+#   cmake -S . -B build -DCMAKE_TOOLCHAIN_FILE=cmake/avr-gcc.cmake
+#
+# Compilers older than the 1-series need the Microchip device pack,
+# point TINYAVR_PACK_DIR at its root (the directory with gcc/ and include/)
+set(CMAKE_SYSTEM_NAME Generic)
+set(CMAKE_SYSTEM_PROCESSOR avr)
+
+find_program(CMAKE_C_COMPILER avr-gcc)
+find_program(CMAKE_AR avr-gcc-ar)
+find_program(CMAKE_RANLIB avr-gcc-ranlib)
+find_program(AVR_SIZE avr-size)
+
+# No -mmcu during compiler checks, nothing could be linked
+set(CMAKE_TRY_COMPILE_TARGET_TYPE STATIC_LIBRARY)
+
+set(CMAKE_FIND_ROOT_PATH_MODE_PROGRAM NEVER)
+set(CMAKE_FIND_ROOT_PATH_MODE_LIBRARY ONLY)
+set(CMAKE_FIND_ROOT_PATH_MODE_INCLUDE ONLY)
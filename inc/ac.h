@@ -0,0 +1,66 @@
+/*!****************************************************************************
+* @file    ac.h
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Analog comparator (AC) driver
+*/
+
+#ifndef ac_H
+#define ac_H
+
+/*!****************************************************************************
+* Include
+*/
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "drv_errors.h"
+#include "device.h"
+#include "vref.h"
+
+/*!****************************************************************************
+* User define
+*/
+#ifndef AC_NUM
+#define AC_NUM                                  DEV_AC_NUM                      //AC0..2 on 16/32 KB devices, AC0 only on others
+#endif
+
+#if (AC_NUM < 1) || (AC_NUM > DEV_AC_NUM)
+#error "AC_NUM must be in range 1..DEV_AC_NUM"
+#endif
+
+/*!****************************************************************************
+* User macro
+*/
+#define acCfgInit(muxPos, muxNeg, ref, hyst, intMode, invert, lowPower, outEn, runStdby) {muxPos, muxNeg, ref, hyst, intMode, invert, lowPower, outEn, runStdby}
+
+/*!****************************************************************************
+* User typedef
+*/
+//Called from ISR on the selected edge with comparator state after it
+typedef void (*acCb_type)(uint8_t acNum, bool state);
+
+typedef struct{
+    AC_MUXPOS_t         muxPos;                                                 //Positive input
+    AC_MUXNEG_t         muxNeg;                                                 //Negative input, DAC - DACn set by dac_init()
+    eVrefSel            ref;                                                    //Reference for AC_MUXNEG_VREF_gc
+    AC_HYSMODE_t        hyst;                                                   //Hysteresis
+    AC_INTMODE_t        intMode;                                                //Edge to call back on
+    bool                invert;                                                 //Invert output
+    bool                lowPower;                                               //Low power mode, longer propagation delay
+    bool                outEn;                                                  //Drive ACn OUT pin
+    bool                runStdby;                                               //Keep running in standby
+}acCfg_type;
+
+/*!****************************************************************************
+* Prototypes for the functions
+*/
+eDrvError ac_init(uint8_t acNum, const acCfg_type *pCfg, acCb_type cb);
+eDrvError ac_stop(uint8_t acNum);
+eDrvError ac_getState(uint8_t acNum, bool *pState);
+
+#endif //ac_H
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
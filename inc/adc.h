@@ -17,7 +17,9 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include "drv_errors.h"
-#include "timer.h"
+#include "device.h"
+#include "swtimer.h"
+#include "timeout.h"
 
 /*!****************************************************************************
 * User define
@@ -38,9 +40,8 @@
 #define ADC_VREF_4V34                           4340
 #define ADC_VREF_1V5                            1500
 #define ADC_RESOLUTION_LSB                      1024
-#define ADC_DELAY_MAX                           65535
-#define ADC_STABILIZE_TIME                      1000
 #define ADC_MEASUREMENTS_NUM                    2
+#define ADC_TIMEOUT_US                          100000                          //Single conversion incl. accumulation
 
 /*!****************************************************************************
 * User macro
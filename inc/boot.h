@@ -0,0 +1,62 @@
+/*!****************************************************************************
+* @file    boot.h
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Staged and deferred peripheral initialization with boot timing
+*/
+
+#ifndef boot_H
+#define boot_H
+
+/*!****************************************************************************
+* Include
+*/
+#include <avr/io.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "drv_errors.h"
+#include "swtimer.h"
+
+/*!****************************************************************************
+* User macro
+*/
+#define bootItemInit(init, stage)               {init, stage, 0, drvUnknownError, false}
+//Pin safe states before the C runtime clears RAM, body must not use RAM or return
+#define BOOT_EARLY(fn)                          void fn(void) __attribute__((naked, used, section(".init3")))
+
+/*!****************************************************************************
+* User enum
+*/
+typedef enum{
+    bootStageCritical = 0,                                                      //Pins and clock, right after reset
+    bootStageMain,                                                              //Needed before the main loop
+    bootStageDeferred,                                                          //Background queue or first use
+    bootStageNum
+}eBootStage;
+
+/*!****************************************************************************
+* User typedef
+*/
+typedef eDrvError (*bootInit_type)(void);
+
+typedef struct{
+    bootInit_type       init;                                                   //Initializer, wraps driver init call
+    eBootStage          stage;                                                  //Stage to run at
+    uint32_t            timeUs;                                                 //Time the initializer took
+    eDrvError           status;                                                 //Initializer result
+    bool                isDone;                                                 //Initializer has run
+}bootItem_type;
+
+/*!****************************************************************************
+* Prototypes for the functions
+*/
+eDrvError boot_init(bootItem_type *pItems, uint8_t num);
+eDrvError boot_runStage(eBootStage stage);
+eDrvError boot_poll(bool *pIsDone);
+eDrvError boot_ensure(bootItem_type *pItem);
+eDrvError boot_getStageUs(eBootStage stage, uint32_t *pUs);
+
+#endif //boot_H
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
@@ -0,0 +1,55 @@
+/*!****************************************************************************
+* @file    calendar.h
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Calendar and wall-clock time on the RTC (Unix time, 1970..2106)
+*/
+
+#ifndef calendar_H
+#define calendar_H
+
+/*!****************************************************************************
+* Include
+*/
+#include <avr/io.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "drv_errors.h"
+#include "rtc.h"
+
+/*!****************************************************************************
+* User define
+*/
+#define CALENDAR_CNT_PER_SEC                    32768UL                         //RTC counts per second, 32.768 kHz clock
+#define CALENDAR_TRIM_MAX_PPM                   10000                           //Drift trim range
+#define CALENDAR_SEC_PER_DAY                    86400UL
+
+/*!****************************************************************************
+* User typedef
+*/
+typedef struct{
+    uint16_t            year;                                                   //1970..2106
+    uint8_t             month;                                                  //1..12
+    uint8_t             day;                                                    //1..31
+    uint8_t             hour;                                                   //0..23
+    uint8_t             min;                                                    //0..59
+    uint8_t             sec;                                                    //0..59
+    uint8_t             wday;                                                   //0 - Sunday .. 6 - Saturday
+}calDate_type;
+
+/*!****************************************************************************
+* Prototypes for the functions
+*/
+eDrvError calendar_init(RTC_CLKSEL_t clkSel);
+eDrvError calendar_set(uint32_t epoch);
+eDrvError calendar_setDate(const calDate_type *pDate);
+eDrvError calendar_getEpoch(uint32_t *pEpoch, uint16_t *pSubSec);
+eDrvError calendar_getDate(calDate_type *pDate);
+eDrvError calendar_setTrim(int16_t ppm);
+eDrvError calendar_epochToDate(uint32_t epoch, calDate_type *pDate);
+eDrvError calendar_dateToEpoch(const calDate_type *pDate, uint32_t *pEpoch);
+
+#endif //calendar_H
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
@@ -0,0 +1,77 @@
+/*!****************************************************************************
+* @file    capture.h
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   TCB input capture driver (frequency and pulse-width measurement)
+*/
+
+#ifndef capture_H
+#define capture_H
+
+/*!****************************************************************************
+* Include
+*/
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "drv_errors.h"
+#include "device.h"
+
+/*!****************************************************************************
+* User define
+*/
+#ifndef CAPTURE_TCB0_EN
+#define CAPTURE_TCB0_EN                         (DEV_TCB_NUM > 1)               //Capture ISR on TCB0, swtimer's on one-TCB parts
+#endif
+#ifndef CAPTURE_TCB1_EN
+#define CAPTURE_TCB1_EN                         0                               //Capture ISR on TCB1
+#endif
+#ifndef CAPTURE_BUF_SIZE
+#define CAPTURE_BUF_SIZE                        8                               //Samples per channel, power of 2
+#endif
+#define CAPTURE_BUF_MASK                        (CAPTURE_BUF_SIZE - 1)
+#define CAPTURE_EV_CH_NUM                       4                               //Asynchronous EVSYS channels
+#define CAPTURE_US_HZ                           1000000UL
+
+#if (CAPTURE_TCB1_EN != 0) && (DEV_TCB_NUM < 2)
+#error "CAPTURE_TCB1_EN set but the device has no TCB1"
+#endif
+#if (CAPTURE_BUF_SIZE & CAPTURE_BUF_MASK) != 0
+#error "CAPTURE_BUF_SIZE must be a power of 2"
+#endif
+
+/*!****************************************************************************
+* User typedef
+*/
+typedef struct{
+    uint16_t            period;                                                 //Period in counter units (FRQ, FRQPW)
+    uint16_t            width;                                                  //Pulse width in counter units (PW, FRQPW)
+}captureSmp_type;
+
+typedef struct{
+    captureSmp_type     buf[CAPTURE_BUF_SIZE];                                  //Captured samples
+    volatile uint8_t    head;                                                   //Write index (ISR)
+    volatile uint8_t    tail;                                                   //Read index
+    volatile uint16_t   overruns;                                               //Samples dropped on full buffer
+    TCB_CNTMODE_t       mode;                                                   //Capture mode
+    uint16_t            usMul;                                                  //Counts to microseconds multiplier
+    uint8_t             usShift;                                                //Counts to microseconds shift
+    uint16_t            hzMant;                                                 //Counter clock mantissa
+    uint8_t             hzExp;                                                  //Counter clock exponent
+}captureCh_type;
+
+/*!****************************************************************************
+* Prototypes for the functions
+*/
+eDrvError capture_init(TCB_t *p, TCB_CNTMODE_t mode, TCB_CLKSEL_t clk, uint32_t clkHz, uint8_t evCh, uint8_t evGen, bool negEdge, bool filter);
+eDrvError capture_stop(TCB_t *p);
+eDrvError capture_get(TCB_t *p, captureSmp_type *pSmp, bool *pIsValid);
+eDrvError capture_getOverruns(TCB_t *p, uint16_t *pOverruns);
+eDrvError capture_toUs(TCB_t *p, uint16_t cnt, uint32_t *pUs);
+eDrvError capture_toHz(TCB_t *p, uint16_t cnt, uint32_t *pHz);
+
+#endif //capture_H
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
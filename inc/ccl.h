@@ -0,0 +1,77 @@
+/*!****************************************************************************
+* @file    ccl.h
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Configurable custom logic (CCL) LUT driver
+*/
+
+#ifndef ccl_H
+#define ccl_H
+
+/*!****************************************************************************
+* Include
+*/
+#include <avr/io.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "drv_errors.h"
+
+/*!****************************************************************************
+* User define
+*/
+#define CCL_LUT_NUM                             2                               //LUT0..1, one sequencer
+#define CCL_IN_NUM                              3                               //Inputs per LUT
+#define CCL_LUT_REG_NUM                         4                               //CTRLA, CTRLB, CTRLC, TRUTH
+//Truth table of a single input, combine with bitwise operators
+#define CCL_TRUTH_IN0                           0xAA
+#define CCL_TRUTH_IN1                           0xCC
+#define CCL_TRUTH_IN2                           0xF0
+
+/*!****************************************************************************
+* User macro
+*/
+#define cclLutInit(in0, in1, in2, truth, filter, edgeDet, clkIn2, outEn) {{in0, in1, in2}, truth, filter, edgeDet, clkIn2, outEn}
+
+/*!****************************************************************************
+* User enum
+*/
+typedef enum{
+    cclInMask = 0,                                                              //Input masked (low)
+    cclInFeedback,                                                              //Sequencer or own LUT output
+    cclInLink,                                                                  //Output of the other LUT
+    cclInEvent0,                                                                //EVSYS user LUTnEV0
+    cclInEvent1,                                                                //EVSYS user LUTnEV1
+    cclInIo,                                                                    //LUT input pin
+    cclInAc0,                                                                   //AC0 output
+    cclInTcb0,                                                                  //TCB0 WO
+    cclInTca0,                                                                  //TCA0 WOn, n - input number
+    cclInTcd0,                                                                  //TCD0 WOA / WOB / WOA
+    cclInUsart0,                                                                //XCK / TXD / XCK
+    cclInSpi0                                                                   //SCK / MOSI / SCK
+}eCclIn;
+
+/*!****************************************************************************
+* User typedef
+*/
+typedef struct{
+    eCclIn              in[CCL_IN_NUM];                                         //Input sources
+    uint8_t             truth;                                                  //Output for input combination IN2:IN1:IN0
+    CCL_FILTSEL_t       filter;                                                 //Synchronizer or filter on output
+    bool                edgeDet;                                                //Edge detector, needs filter
+    bool                clkIn2;                                                 //Clock sequential logic from input 2
+    bool                outEn;                                                  //Drive LUT output pin
+}cclLut_type;
+
+/*!****************************************************************************
+* Prototypes for the functions
+*/
+eDrvError ccl_init(bool runStdby);
+eDrvError ccl_setLut(uint8_t lut, const cclLut_type *pLut);
+eDrvError ccl_setTruth(uint8_t lut, uint8_t truth);
+eDrvError ccl_setSeq(CCL_SEQSEL_t seq);
+eDrvError ccl_enableLut(uint8_t lut, bool isEnabled);
+
+#endif //ccl_H
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
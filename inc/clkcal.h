@@ -0,0 +1,47 @@
+/*!****************************************************************************
+* @file    clkcal.h
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   OSC20M run-time calibration against a 32.768 kHz reference
+*/
+
+#ifndef clkcal_H
+#define clkcal_H
+
+/*!****************************************************************************
+* Include
+*/
+#include <avr/io.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "drv_errors.h"
+#include "capture.h"
+#include "clock.h"
+
+/*!****************************************************************************
+* User define
+*/
+#ifndef CLKCAL_SMP_NUM
+#define CLKCAL_SMP_NUM                          32                              //Reference periods per measurement, power of 2
+#endif
+#ifndef CLKCAL_DEADBAND_PPM
+#define CLKCAL_DEADBAND_PPM                     6000                            //Error left untrimmed, over half of OSC20MCALIBA step
+#endif
+#define CLKCAL_SKIP_NUM                         2                               //Periods dropped after a clock change
+
+#if (CLKCAL_SMP_NUM & (CLKCAL_SMP_NUM - 1)) != 0
+#error "CLKCAL_SMP_NUM must be a power of 2"
+#endif
+
+/*!****************************************************************************
+* Prototypes for the functions
+*/
+eDrvError clkcal_start(TCB_t *p, uint8_t evCh, uint8_t evGen, uint16_t refHz);
+eDrvError clkcal_stop(void);
+eDrvError clkcal_run(bool *pIsSettled);
+eDrvError clkcal_getHz(uint32_t *pHz);
+
+#endif //clkcal_H
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
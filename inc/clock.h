@@ -16,11 +16,51 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include "drv_errors.h"
+#include "timeout.h"
+
+/*!****************************************************************************
+* User define
+*/
+#define CLOCK_XOSC32K_TIMEOUT_US                3000000UL                       //Crystal start-up plus 64K cycles
+#define CLOCK_OSC20M_16M_HZ                     16000000UL                      //OSC20M with FREQSEL fuse at 16 MHz
+#define CLOCK_OSC20M_20M_HZ                     20000000UL                      //OSC20M with FREQSEL fuse at 20 MHz
+#define CLOCK_OSC32K_HZ                         32768UL
+#define CLOCK_XOSC32K_HZ                        32768UL
+#ifndef CLOCK_EXTCLK_HZ
+#define CLOCK_EXTCLK_HZ                         0                               //External clock on EXTCLK pin, 0 if not fitted
+#endif
+#ifndef CLOCK_CB_NUM
+#define CLOCK_CB_NUM                            8                               //Drivers to notify on clock change
+#endif
+#define CLOCK_SWITCH_POLLS                      60000U                          //Source switch wait, time base is frozen meanwhile
+#ifndef CLOCK_RETIME_PPM
+#define CLOCK_RETIME_PPM                        1000                            //Measured clock deviation to re-time drivers at
+#endif
+
+/*!****************************************************************************
+* User enum
+*/
+typedef enum{
+    clockEvPre = 0,                                                             //Clock is about to change
+    clockEvPost                                                                 //Clock has changed, re-time
+}eClockEv;
+
+/*!****************************************************************************
+* User typedef
+*/
+typedef eDrvError (*clockCb_type)(eClockEv ev, uint32_t hzOld, uint32_t hzNew);
 
 /*!****************************************************************************
 * Prototypes for the functions
 */
 eDrvError clock_init(CLKCTRL_CLKSEL_t clkSrc, CLKCTRL_PDIV_t pDiv, bool prscEn, bool runStby20M, bool runStby32K);
+eDrvError clock_initXosc32k(CLKCTRL_CSUT_t startUp, bool extClk, bool runStby);
+eDrvError clock_set(CLKCTRL_CLKSEL_t clkSrc, CLKCTRL_PDIV_t pDiv, bool prscEn);
+eDrvError clock_getHz(uint32_t *pHz);
+eDrvError clock_getNomHz(uint32_t *pHz);
+eDrvError clock_setMeasHz(uint32_t hz);
+eDrvError clock_register(clockCb_type cb);
+eDrvError clock_unregister(clockCb_type cb);
 
 #endif //clock_H
 /***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
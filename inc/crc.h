@@ -0,0 +1,48 @@
+/*!****************************************************************************
+* @file    crc.h
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Table-driven CRC8/CRC16/CRC32 with tables in flash
+*/
+
+#ifndef crc_H
+#define crc_H
+
+/*!****************************************************************************
+* Include
+*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "drv_errors.h"
+
+/*!****************************************************************************
+* User define
+*/
+//CRC-8/SMBUS: poly 0x07, not reflected, check "123456789" = 0xF4
+#define CRC8_INIT                               0x00
+//CRC-16/CCITT-FALSE: poly 0x1021, not reflected, check 0x29B1
+#define CRC16_INIT                              0xFFFF
+//CRC-32 (IEEE 802.3): poly 0x04C11DB7 reflected, check 0xCBF43926
+#define CRC32_INIT                              0xFFFFFFFFUL
+
+/*!****************************************************************************
+* User macro
+*/
+#define CRC32_FINAL(crc)                        ((uint32_t)((crc) ^ CRC32_INIT))
+
+/*!****************************************************************************
+* Prototypes for the functions
+*/
+//Byte tables: 256 entries, fastest. Nibble tables: 16 entries, for small flash
+//*pCrc carries the running value: start with CRCn_INIT, feed data in parts
+eDrvError crc_calc8(const uint8_t *pData, uint16_t size, uint8_t *pCrc);
+eDrvError crc_calc16(const uint8_t *pData, uint16_t size, uint16_t *pCrc);
+eDrvError crc_calc32(const uint8_t *pData, uint16_t size, uint32_t *pCrc);
+eDrvError crc_calc8Nib(const uint8_t *pData, uint16_t size, uint8_t *pCrc);
+eDrvError crc_calc16Nib(const uint8_t *pData, uint16_t size, uint16_t *pCrc);
+eDrvError crc_calc32Nib(const uint8_t *pData, uint16_t size, uint32_t *pCrc);
+
+#endif //crc_H
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
@@ -0,0 +1,34 @@
+/*!****************************************************************************
+* @file    crcscan.h
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Flash integrity check with CRCSCAN peripheral
+*/
+
+#ifndef crcscan_H
+#define crcscan_H
+
+/*!****************************************************************************
+* Include
+*/
+#include <avr/io.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "drv_errors.h"
+
+/*!****************************************************************************
+* User define
+*/
+#define CRCSCAN_POLLS_MAX                       UINT16_MAX                      //CPU is stalled during scan, BUSY is gone when it runs
+
+/*!****************************************************************************
+* Prototypes for the functions
+*/
+eDrvError crcscan_run(CRCSCAN_SRC_t src, bool *pIsOk);
+eDrvError crcscan_checkFlash(void);
+eDrvError crcscan_enableNmi(CRCSCAN_SRC_t src);
+
+#endif //crcscan_H
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
@@ -0,0 +1,44 @@
+/*!****************************************************************************
+* @file    dac.h
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   8-bit DAC driver (DAC0 output, DAC1/DAC2 comparator references)
+*/
+
+#ifndef dac_H
+#define dac_H
+
+/*!****************************************************************************
+* Include
+*/
+#include <avr/io.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "drv_errors.h"
+#include "device.h"
+#include "vref.h"
+
+/*!****************************************************************************
+* User define
+*/
+#ifndef DAC_NUM
+#define DAC_NUM                                 DEV_DAC_NUM                     //DAC0..2 on 16/32 KB devices, DAC0 only on others
+#endif
+#define DAC_STEPS                               256                             //8-bit resolution
+
+#if (DAC_NUM < 1) || (DAC_NUM > DEV_DAC_NUM)
+#error "DAC_NUM must be in range 1..DEV_DAC_NUM"
+#endif
+
+/*!****************************************************************************
+* Prototypes for the functions
+*/
+eDrvError dac_init(uint8_t dacNum, eVrefSel ref, bool outEn, bool runStdby);
+eDrvError dac_stop(uint8_t dacNum);
+eDrvError dac_set(uint8_t dacNum, uint8_t data);
+eDrvError dac_setMv(uint8_t dacNum, uint16_t mv);
+
+#endif //dac_H
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
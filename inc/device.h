@@ -0,0 +1,83 @@
+/*!****************************************************************************
+* @file    device.h
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Compile-time capability table of supported tinyAVR 1-series parts
+* @note     Device is taken from the -mmcu define of avr-gcc. Drivers size
+*           their tables and drop code of absent peripherals from these
+*           values, asking for an absent one is a build error
+*/
+
+#ifndef device_H
+#define device_H
+
+/*!****************************************************************************
+* Include
+*/
+#include <avr/io.h>
+
+/*!****************************************************************************
+* User define
+*/
+//Pins present per port, bit per pin; ADC1, AC1/2, DAC1/2 and TCB1 on 16/32 KB parts only
+#if defined(__AVR_ATtiny3217__)
+#define DEV_PIN_NUM                             24
+#define DEV_PORTA_PIN_MSK                       0xFF
+#define DEV_PORTB_PIN_MSK                       0xFF
+#define DEV_PORTC_PIN_MSK                       0x3F
+#define DEV_EEPROM_PAGE_SIZE                    64
+#define DEV_ADC_NUM                             2
+#define DEV_AC_NUM                              3
+#define DEV_DAC_NUM                             3
+#define DEV_TCB_NUM                             2
+#elif defined(__AVR_ATtiny1614__)
+#define DEV_PIN_NUM                             14
+#define DEV_PORTA_PIN_MSK                       0xFF
+#define DEV_PORTB_PIN_MSK                       0x0F
+#define DEV_PORTC_PIN_MSK                       0x00
+#define DEV_EEPROM_PAGE_SIZE                    32
+#define DEV_ADC_NUM                             2
+#define DEV_AC_NUM                              3
+#define DEV_DAC_NUM                             3
+#define DEV_TCB_NUM                             2
+#elif defined(__AVR_ATtiny816__)
+#define DEV_PIN_NUM                             20
+#define DEV_PORTA_PIN_MSK                       0xFF
+#define DEV_PORTB_PIN_MSK                       0x3F
+#define DEV_PORTC_PIN_MSK                       0x0F
+#define DEV_EEPROM_PAGE_SIZE                    32
+#define DEV_ADC_NUM                             1
+#define DEV_AC_NUM                              1
+#define DEV_DAC_NUM                             1
+#define DEV_TCB_NUM                             1
+#elif defined(__AVR_ATtiny417__)
+#define DEV_PIN_NUM                             24
+#define DEV_PORTA_PIN_MSK                       0xFF
+#define DEV_PORTB_PIN_MSK                       0xFF
+#define DEV_PORTC_PIN_MSK                       0x3F
+#define DEV_EEPROM_PAGE_SIZE                    32
+#define DEV_ADC_NUM                             1
+#define DEV_AC_NUM                              1
+#define DEV_DAC_NUM                             1
+#define DEV_TCB_NUM                             1
+#else
+#error "Device is not in the capability table of device.h"
+#endif
+#define DEV_TCD0_EN                             1                               //TCD0 on every 1-series part
+#define DEV_PORT_PIN_NUM                        8                               //PINnCTRL registers per port
+
+#if (DEV_EEPROM_PAGE_SIZE != EEPROM_PAGE_SIZE)
+#error "DEV_EEPROM_PAGE_SIZE doesn't match the device header"
+#endif
+
+/*!****************************************************************************
+* User macro
+*/
+//Pin number checked against the port, port must be given as PORTx token. Macros passing
+//their port argument on must paste DEV_##port##_PIN_MSK themselves, PORTx is expanded otherwise
+#define devPinCheck(port, pin)                  devPinMskCheck(DEV_##port##_PIN_MSK, pin)
+#define devPinMskCheck(msk, pin)                ((pin) + 0 * sizeof(char[(((msk) >> (pin)) & 1) ? 1 : -1]))
+
+#endif //device_H
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
@@ -16,11 +16,14 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include "drv_errors.h"
+#include "device.h"
+#include "timeout.h"
 
 /*!****************************************************************************
 * User define
 */
 #define EMPTY_BYTE                          0xFF
+#define EEPROM_TIMEOUT_US                   50000                               //Page erase / write cycle
 
 /*!****************************************************************************
 * Prototypes for the functions
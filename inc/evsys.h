@@ -0,0 +1,121 @@
+/*!****************************************************************************
+* @file    evsys.h
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Event system (EVSYS) routing
+*/
+
+#ifndef evsys_H
+#define evsys_H
+
+/*!****************************************************************************
+* Include
+*/
+#include <avr/io.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "drv_errors.h"
+#include "device.h"
+
+/*!****************************************************************************
+* User define
+*/
+#define EVSYS_ASYNC_CH_NUM                      4                               //ASYNCCH0..3
+#define EVSYS_SYNC_CH_NUM                       2                               //SYNCCH0..1
+#define EVSYS_MUX_OFF                           0x00                            //User not connected
+#define EVSYS_MUX_SYNCCH0                       0x01                            //User mux value selecting SYNCCH0
+#define EVSYS_MUX_ASYNCCH0                      0x03                            //ASYNCUSERn value selecting ASYNCCH0
+#define EVSYS_GEN_OFF                           0x00                            //Channel generator off
+
+#if (DEV_ADC_NUM > 1) && (DEV_TCB_NUM < 2)
+#error "ADC1 user index follows TCB1, eEvsysUser needs a gap for this device"
+#endif
+
+/*
+* Routes fixed at build time are listed in the file named by EVSYS_CFG_FILE:
+*   #define EVSYS_CHANNELS(X) \
+*       X(evChPwm, evsysChSync0, EVSYS_SYNCCH0_TCA0_OVF_LUNF_gc)
+*   #define EVSYS_ROUTES(X) \
+*       X(evChPwm, evsysUserAdc0)
+* A channel or a user listed twice fails the build with a redeclared
+* enumerator. Channel names become eEvsysCh constants
+*/
+#ifdef EVSYS_CFG_FILE
+#include EVSYS_CFG_FILE
+#endif
+#ifndef EVSYS_CHANNELS
+#define EVSYS_CHANNELS(X)
+#endif
+#ifndef EVSYS_ROUTES
+#define EVSYS_ROUTES(X)
+#endif
+
+/*!****************************************************************************
+* User macro
+*/
+#define EVSYS_X_CH_NAME(name, ch, gen)          name = ch,
+#define EVSYS_X_CH_ALLOC(name, ch, gen)         evsysAlloc_##ch,
+#define EVSYS_X_USER_ALLOC(name, user)          evsysAlloc_##user,
+
+/*!****************************************************************************
+* User enum
+*/
+typedef enum{
+    evsysChAsync0 = 0,
+    evsysChAsync1,
+    evsysChAsync2,
+    evsysChAsync3,
+    evsysChSync0,
+    evsysChSync1,
+    evsysChNum,
+    EVSYS_CHANNELS(EVSYS_X_CH_NAME)
+}eEvsysCh;
+
+//Users of absent instances are left out, ASYNCUSERn index is kept
+typedef enum{
+    evsysUserTcb0 = 0,                                                          //ASYNCUSER0
+    evsysUserAdc0,
+    evsysUserLut0Ev0,
+    evsysUserLut1Ev0,
+    evsysUserLut0Ev1,
+    evsysUserLut1Ev1,
+    evsysUserTcd0Ev0,
+    evsysUserTcd0Ev1,
+    evsysUserEvout0,
+    evsysUserEvout1,
+    evsysUserEvout2,
+#if (DEV_TCB_NUM > 1)
+    evsysUserTcb1,                                                              //ASYNCUSER11
+#endif
+#if (DEV_ADC_NUM > 1)
+    evsysUserAdc1,                                                              //ASYNCUSER12
+#endif
+    evsysUserTca0,                                                              //SYNCUSER0, sync channels only
+    evsysUserUsart0,                                                            //SYNCUSER1, sync channels only
+    evsysUserNum
+}eEvsysUser;
+
+//Build time allocation, duplicates don't compile
+enum{
+    EVSYS_CHANNELS(EVSYS_X_CH_ALLOC)
+    evsysAllocChNum
+};
+enum{
+    EVSYS_ROUTES(EVSYS_X_USER_ALLOC)
+    evsysAllocUserNum
+};
+
+/*!****************************************************************************
+* Prototypes for the functions
+*/
+eDrvError evsys_init(void);
+eDrvError evsys_setGen(eEvsysCh ch, uint8_t gen);
+eDrvError evsys_connect(eEvsysCh ch, eEvsysUser user);
+eDrvError evsys_disconnect(eEvsysUser user);
+eDrvError evsys_route(eEvsysCh ch, uint8_t gen, eEvsysUser user);
+eDrvError evsys_strobe(eEvsysCh ch);
+
+#endif //evsys_H
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
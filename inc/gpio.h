@@ -16,6 +16,7 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include "drv_errors.h"
+#include "device.h"
 
 /*!****************************************************************************
 * User define
@@ -46,7 +47,8 @@ typedef struct{
 /*!****************************************************************************
 * Macro functions
 */
-#define makepin(port, pin, pinDir, initState, pinInvEn, pullUpEn, inputSense)    {&port, pin, pinDir, initState, pinInvEn, pullUpEn, inputSense}
+//Port as PORTx token, pins absent on the device don't compile
+#define makepin(port, pin, pinDir, initState, pinInvEn, pullUpEn, inputSense)    {&port, devPinMskCheck(DEV_##port##_PIN_MSK, pin), pinDir, initState, pinInvEn, pullUpEn, inputSense}
                                     
 #define _gppin_set(port, npin)      (port->OUTSET = (1 << npin))
 #define _gppin_reset(port, npin)    (port->OUTCLR = (1 << npin))
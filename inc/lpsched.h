@@ -0,0 +1,74 @@
+/*!****************************************************************************
+* @file    lpsched.h
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Tickless low-power task scheduler on RTC compare and PIT
+*/
+
+#ifndef lpsched_H
+#define lpsched_H
+
+/*!****************************************************************************
+* Include
+*/
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "drv_errors.h"
+#include "rtc.h"
+#include "sleepctrl.h"
+
+/*!****************************************************************************
+* User define
+*/
+#ifndef LPSCHED_CLKSEL
+#define LPSCHED_CLKSEL                          RTC_CLKSEL_INT32K_gc            //RTC clock source
+#endif
+#ifndef LPSCHED_CLK_HZ
+#define LPSCHED_CLK_HZ                          32768UL                         //Scheduler counts per second, matches LPSCHED_CLKSEL
+#endif
+#ifndef LPSCHED_LAT_INIT_CNT
+#define LPSCHED_LAT_INIT_CNT                    1                               //Initial wake-up latency guess
+#endif
+#define LPSCHED_LAT_MAX_CNT                     16                              //Wake-up latency compensation limit
+#define LPSCHED_MIN_SLEEP_CNT                   4                               //Closer deadlines are spun, CMP sync takes 2-3 counts
+#define LPSCHED_SLEEP_MAX_CNT                   0xC000                          //Longest sleep, keeps CMP ahead of the counter
+#define LPSCHED_PD_MIN_CNT                      256                             //Shortest power-down sleep
+#define LPSCHED_PIT_EXP_MIN                     2                               //PIT period 2^2 counts
+#define LPSCHED_PIT_EXP_MAX                     15                              //PIT period 2^15 counts
+
+/*!****************************************************************************
+* User macro
+*/
+#define LPSCHED_MS_TO_CNT(ms)                   (((uint32_t)(ms) * LPSCHED_CLK_HZ + 999UL) / 1000UL)
+
+/*!****************************************************************************
+* User typedef
+*/
+typedef void (*lpTaskCb_type)(void *pArg);
+
+typedef struct lpTask_tag{
+    struct lpTask_tag   *pNext;                                                 //Next task by deadline
+    uint32_t            due;                                                    //Absolute deadline in counts
+    uint32_t            period;                                                 //Reload period in counts, 0 for one-shot
+    lpTaskCb_type       cb;                                                     //Callback, called from lpsched_run()
+    void                *pArg;                                                  //Callback argument
+    bool                isQueued;
+}lpTask_type;
+
+/*!****************************************************************************
+* Prototypes for the functions
+*/
+eDrvError lpsched_init(void);
+eDrvError lpsched_add(lpTask_type *pTask, uint32_t delay, uint32_t period, lpTaskCb_type cb, void *pArg);
+eDrvError lpsched_remove(lpTask_type *pTask);
+eDrvError lpsched_setMaxMode(SLPCTRL_SMODE_t mode);
+eDrvError lpsched_getTime(uint32_t *pNow);
+eDrvError lpsched_getLatency(uint8_t *pLat);
+eDrvError lpsched_run(void);
+
+#endif //lpsched_H
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
@@ -17,11 +17,34 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include "drv_errors.h"
+#include "swtimer.h"
+
+/*!****************************************************************************
+* User define
+*/
+#define MCU_DIAG_MAGIC                          0xD1A6                          //Diagnostics record was written before reset
+#define MCU_STACK_PAINT                         0xC5                            //Unused stack fill pattern
+#define MCU_STACK_GUARD                         32                              //Bytes below SP left unpainted
+
+/*!****************************************************************************
+* User typedef
+*/
+typedef struct{
+    uint16_t            magic;                                                  //MCU_DIAG_MAGIC
+    uint16_t            bootCnt;                                                //Boots since power-on
+    uint8_t             rstFr;                                                  //Reset causes of this boot, RSTCTRL.RSTFR
+    uint16_t            lastPc;                                                 //Last mark before reset, word address
+    uint16_t            stackMax;                                               //Deepest stack before reset, bytes
+    uint32_t            uptimeMs;                                               //Uptime at last mark before reset
+    uint16_t            chk;                                                    //Complement of the sum of the fields above
+}mcuDiag_type;
 
 /*!****************************************************************************
 * Prototypes for the functions
 */
 eDrvError mcu_options_init(void);
+eDrvError mcu_options_getDiag(mcuDiag_type *pDiag);
+eDrvError mcu_options_diagMark(void);
 eDrvError mcu_options_isPorRstSet(bool *pPorRst);
 eDrvError mcu_options_isSwRstEngd(bool *pSwRst);
 eDrvError mcu_options_isWdtRstEngd(bool *pWdtRst);
@@ -17,13 +17,40 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include "drv_errors.h"
+#include "timeout.h"
+#include "sleepctrl.h"
+
+/*!****************************************************************************
+ * User define
+ */
+#define RTC_SYNC_TIMEOUT_US                     50000                           //Register synchronization, 1 kHz clock worst
+#define RTC_US_MUL                              15625UL                         //Counts to microseconds numerator
+
+/*!****************************************************************************
+ * User typedef
+ */
+typedef void (*rtcCb_type)(uint8_t flags);                                      //Called from ISR with served INTFLAGS
+
+typedef struct{
+    uint16_t            cycles;                                                 //Waited periods (saturates)
+    uint16_t            overruns;                                               //Periods entered too late (saturates)
+    uint16_t            missed;                                                 //Overflows passed before the wait (saturates)
+    uint16_t            busyMax;                                                //Longest work of an on-time period, counts
+    uint32_t            lateMax;                                                //Worst lateness past the overflow, counts
+}rtcStat_type;
 
 /*!****************************************************************************
  * Prototypes for the functions
  */
 eDrvError rtc_init(RTC_CLKSEL_t clkSel, uint16_t compare, uint16_t period, RTC_PRESCALER_t pDiv, bool runStby);
 eDrvError rtc_waitOvf(uint16_t *pCntElapsed, bool *pIsCycBroken);
-eDrvError rtc_waitCmp(void);
+eDrvError rtc_waitCmp(uint16_t *pCntElapsed, bool *pIsCycBroken);
+eDrvError rtc_getStat(rtcStat_type *pStat);
+eDrvError rtc_clearStat(void);
+eDrvError rtc_setCmp(uint16_t compare);
+eDrvError rtc_setCnt(uint16_t cnt);
+eDrvError rtc_setCallback(rtcCb_type cb, uint8_t intMask);
+eDrvError rtc_setSleep(SLPCTRL_SMODE_t mode, bool isEnabled);
 
 #endif //rtc_H
 /***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
@@ -0,0 +1,78 @@
+/*!****************************************************************************
+* @file    sleepctrl.h
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Sleep controller (SLPCTRL)
+*/
+
+#ifndef sleepctrl_H
+#define sleepctrl_H
+
+/*!****************************************************************************
+* Include
+*/
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "drv_errors.h"
+
+/*!****************************************************************************
+* User define
+*/
+#define SLEEPCTRL_MODE_NUM                      3                               //Idle, standby, power-down
+#define SLEEPCTRL_LIMIT_NONE                    0                               //User doesn't limit sleep
+
+/*!****************************************************************************
+* User macro
+*/
+#define SLEEPCTRL_MODE_IDX(mode)                (((mode) & SLPCTRL_SMODE_gm) >> 1)
+
+/*!****************************************************************************
+* User enum
+*/
+typedef enum{
+    sleepUserApp = 0,
+    sleepUserUsart,
+    sleepUserAdc0,
+    sleepUserAdc1,
+    sleepUserTimA,
+    sleepUserTimB0,
+    sleepUserTimB1,
+    sleepUserCcl,
+    sleepUserAc,
+    sleepUserDac,
+    sleepUserTwi,
+    sleepUserTwis,
+    sleepUserSwtimer,
+    sleepUserNum
+}eSleepUser;
+
+/*!****************************************************************************
+* User typedef
+*/
+typedef eDrvError (*sleepTime_type)(uint32_t *pUs);
+
+//Time of standby and power-down stays 0 until sleepctrl_setTimeSource() sets a source running there
+typedef struct{
+    uint32_t            timeUs;                                                 //Time spent asleep (wraps)
+    uint16_t            count;                                                  //Times entered (saturates)
+}sleepStat_type;
+
+/*!****************************************************************************
+* Prototypes for the functions
+*/
+eDrvError sleepctrl_sleepIf(SLPCTRL_SMODE_t mode, volatile uint8_t *pFlags, uint8_t mask);
+eDrvError sleepctrl_sleep(volatile uint8_t *pFlags, uint8_t mask);
+eDrvError sleepctrl_setLimit(eSleepUser user, SLPCTRL_SMODE_t deepest);
+eDrvError sleepctrl_clearLimit(eSleepUser user);
+eDrvError sleepctrl_getMode(SLPCTRL_SMODE_t *pMode);
+eDrvError sleepctrl_setTimeSource(sleepTime_type getUs);
+eDrvError sleepctrl_getStat(SLPCTRL_SMODE_t mode, sleepStat_type *pStat);
+eDrvError sleepctrl_clearStat(void);
+
+#endif //sleepctrl_H
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
@@ -16,11 +16,20 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include "drv_errors.h"
+#include "timeout.h"
+
+/*!****************************************************************************
+* User define
+*/
+#ifndef SPI_SCK_HZ
+#define SPI_SCK_HZ                              156250UL                        //Default SCK, CLK / 128 at 20 MHz
+#endif
 
 /*!****************************************************************************
 * Prototypes for the functions
 */
 eDrvError spi_init(void);
+eDrvError spi_setSck(uint32_t sckHz);
 eDrvError spi_receive(uint8_t *pRxData, uint16_t size);
 eDrvError spi_transmitReceive(uint8_t *pTxData, uint8_t *pRxData, uint16_t size);
 
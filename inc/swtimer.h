@@ -0,0 +1,99 @@
+/*!****************************************************************************
+* @file    swtimer.h
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Software timer wheel multiplexed on a single TCB (tickless)
+*/
+
+#ifndef swtimer_H
+#define swtimer_H
+
+/*!****************************************************************************
+* Include
+*/
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "drv_errors.h"
+#include "device.h"
+
+/*!****************************************************************************
+* User define
+*/
+#ifndef SWTIMER_TCB_NUM
+#define SWTIMER_TCB_NUM                         (DEV_TCB_NUM - 1)               //TCB instance driving the wheel, last one
+#endif
+#ifndef SWTIMER_CLKSEL
+#define SWTIMER_CLKSEL                          TCB_CLKSEL_CLKDIV2_gc           //Counter clock
+#endif
+#ifndef SWTIMER_CLK_HZ
+#define SWTIMER_CLK_HZ                          10000000UL                      //Counter clock at 20 MHz CLK_PER, timestamp unit
+#endif
+#ifndef SWTIMER_CLK_DIV
+#define SWTIMER_CLK_DIV                         2                               //CLK_PER cycles per count, matches SWTIMER_CLKSEL
+#endif
+#ifndef SWTIMER_TICK_US
+#define SWTIMER_TICK_US                         100                             //Tick length in microseconds
+#endif
+#ifndef SWTIMER_LVL_NUM
+#define SWTIMER_LVL_NUM                         4                               //Wheel levels, 16 slots each
+#endif
+#define SWTIMER_LVL_BITS                        4
+#define SWTIMER_SLOT_NUM                        (1 << SWTIMER_LVL_BITS)
+#define SWTIMER_SLOT_MASK                       (SWTIMER_SLOT_NUM - 1)
+#define SWTIMER_MARGIN_CNT                      64                              //Minimum counts ahead when reprogramming
+#define SWTIMER_SLOT_IDLE                       0                               //Zero-initialized timer is idle
+
+#if (SWTIMER_TCB_NUM >= DEV_TCB_NUM)
+#error "SWTIMER_TCB_NUM names a TCB the device doesn't have"
+#elif (SWTIMER_TCB_NUM == 0)
+#define SWTIMER_TCB                             TCB0
+#define SWTIMER_TCB_vect                        TCB0_INT_vect
+#elif (SWTIMER_TCB_NUM == 1)
+#define SWTIMER_TCB                             TCB1
+#define SWTIMER_TCB_vect                        TCB1_INT_vect
+#else
+#error "SWTIMER_TCB_NUM must be 0 or 1"
+#endif
+#if (SWTIMER_LVL_NUM < 1) || (SWTIMER_LVL_NUM > 8)
+#error "SWTIMER_LVL_NUM must be in range 1..8"
+#endif
+
+/*!****************************************************************************
+* User macro
+*/
+#define SWTIMER_US_TO_TICKS(us)                 (((us) + SWTIMER_TICK_US - 1) / SWTIMER_TICK_US)
+#define SWTIMER_STAMP_TO_US(cnt)                ((cnt) / (SWTIMER_CLK_HZ / 1000000UL))
+
+/*!****************************************************************************
+* User typedef
+*/
+typedef void (*swTimerCb_type)(void *pArg);
+
+typedef struct swTimer_tag{
+    struct swTimer_tag  *pNext;                                                 //Next timer in slot
+    struct swTimer_tag  *pPrev;                                                 //Previous timer in slot
+    uint32_t            expires;                                                //Absolute expiry tick
+    uint32_t            period;                                                 //Reload period in ticks, 0 for one-shot
+    swTimerCb_type      cb;                                                     //Callback, called from ISR (optional)
+    void                *pArg;                                                  //Callback argument
+    volatile uint8_t    isExpired;                                              //Set on every expiry
+    uint8_t             slot;                                                   //Wheel slot + 1, SWTIMER_SLOT_IDLE if not queued
+}swTimer_type;
+
+/*!****************************************************************************
+* Prototypes for the functions
+*/
+eDrvError swtimer_init(void);
+eDrvError swtimer_start(swTimer_type *pTim, uint32_t ticks, uint32_t period, swTimerCb_type cb, void *pArg);
+eDrvError swtimer_cancel(swTimer_type *pTim);
+eDrvError swtimer_isExpired(swTimer_type *pTim, bool *pIsExpired);
+eDrvError swtimer_poll(void);
+eDrvError swtimer_getStamp(uint64_t *pStamp);
+eDrvError swtimer_getCnt(uint32_t *pCnt);
+
+#endif //swtimer_H
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
@@ -0,0 +1,74 @@
+/*!****************************************************************************
+* @file    timeout.h
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Timeout-bounded waits on the shared free-running time base
+*/
+
+#ifndef timeout_H
+#define timeout_H
+
+/*!****************************************************************************
+* Include
+*/
+#include <avr/io.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "drv_errors.h"
+#include "swtimer.h"
+
+/*!****************************************************************************
+* User define
+*/
+#define TIMEOUT_POLL_DIV                        8                               //Polls per time base read
+#define TIMEOUT_CNT_PER_US                      (SWTIMER_CLK_HZ / 1000000UL)
+#define TIMEOUT_COUNT_MAX                       UINT16_MAX
+
+/*!****************************************************************************
+* User enum
+*/
+typedef enum{
+    timeoutSiteAdcResRdy = 0,
+    timeoutSiteXosc32k,
+    timeoutSiteSpiRx,
+    timeoutSiteSpiTxRx,
+    timeoutSiteEepromErasePage,
+    timeoutSiteEepromErase,
+    timeoutSiteEepromWrite,
+    timeoutSiteRtcSync,
+    timeoutSiteRtcOvf,
+    timeoutSiteRtcCmp,
+    timeoutSiteRtcPitSync,
+    timeoutSiteTimAOvf,
+    timeoutSiteTimBOvf,
+    timeoutSiteTimDSync,
+    timeoutSiteTimDOvf,
+    timeoutSiteUsartTx,
+    timeoutSiteUsartRx,
+    timeoutSiteTwiXfer,
+    timeoutSiteTwiRecover,
+    timeoutSiteNum
+}eTimeoutSite;
+
+/*!****************************************************************************
+* User typedef
+*/
+typedef struct{
+    uint32_t            last;                                                   //Time base count at previous read
+    uint32_t            remain;                                                 //Counts left until expiry
+    uint8_t             polls;                                                  //Polls since previous read
+}timeout_type;
+
+/*!****************************************************************************
+* Prototypes for the functions
+*/
+eDrvError timeout_start(timeout_type *pTo, uint32_t us);
+eDrvError timeout_startCyc(timeout_type *pTo, uint32_t cycles);
+eDrvError timeout_check(timeout_type *pTo, eTimeoutSite site);
+eDrvError timeout_getCount(eTimeoutSite site, uint16_t *pCount);
+eDrvError timeout_clearCounts(void);
+
+#endif //timeout_H
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
@@ -17,6 +17,17 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include "drv_errors.h"
+#include "device.h"
+#include "timeout.h"
+#include "swtimer.h"
+
+/*!****************************************************************************
+* User define
+*/
+#define TIMD_CMP_MAX                            0x0FFF                          //TCD0 compare registers are 12 bit
+#define TIMD_EV_CH_NUM                          4                               //Asynchronous EVSYS channels
+#define TIMD_SYNC_TIMEOUT_US                    10000                           //ENRDY / CMDRDY synchronization
+#define TIMD_OVF_TIMEOUT_US                     250000                          //Longest period: 4096 x 256 x 2 counts
 
 /*!****************************************************************************
 * User enum
@@ -24,10 +35,25 @@
 typedef enum{
     timCntA0 = 0,
     timCntB0,
+#if (DEV_TCB_NUM > 1)
     timCntB1,
-    timCntD0
+#endif
+    timCntD0,
+    timCntNum
 }eTimNum;
 
+/*!****************************************************************************
+* User typedef
+*/
+typedef struct{
+    uint32_t            start;                                                  //Timestamp of current cycle start
+    uint32_t            lenMin;                                                 //Shortest cycle, timestamp units
+    uint32_t            lenMax;                                                 //Longest cycle, timestamp units
+    uint16_t            overruns;                                               //Broken cycles
+    uint16_t            cycles;                                                 //Measured cycles (saturates)
+    bool                isStarted;                                              //start is valid
+}timerCycStat_type;
+
 /*!****************************************************************************
 * Prototypes for the functions
 */
@@ -38,10 +64,15 @@ eDrvError timer_setPwmValue(register16_t *pReg, uint16_t value);
 eDrvError timer_initTimB(TCB_t *p, TCB_CNTMODE_t mode, TCB_CLKSEL_t clk);
 eDrvError timer_startTimB(TCB_t *p, uint16_t top);
 eDrvError timer_waitOvfTimB(TCB_t *p, uint16_t *pSysCycLen, bool *pIsCycBroken);
-eDrvError timer_initTimD(void);
+eDrvError timer_initTimD(TCD_CLKSEL_t clk, TCD_CNTPRES_t cntPres, TCD_SYNCPRES_t syncPres, TCD_WGMODE_t wgMode, uint8_t pwmOutputs);
+eDrvError timer_setFaultTimD(uint8_t evCh, uint8_t evGen, bool faultHigh, TCD_INPUTMODE_t inputMode);
 eDrvError timer_startTimD(uint16_t top);
+eDrvError timer_setPwmTimD(uint16_t duty, uint16_t deadTime);
+eDrvError timer_restartTimD(void);
 eDrvError timer_waitOvfTimD(uint16_t *pSysCycLen, bool *pIsCycBroken);
 eDrvError timer_isTimEnabled(eTimNum timCnt, bool *pIsEnable);
+eDrvError timer_getCycStat(eTimNum timCnt, timerCycStat_type *pStat);
+eDrvError timer_clearCycStat(eTimNum timCnt);
 
 #endif //timer_H
 /***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
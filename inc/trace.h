@@ -0,0 +1,167 @@
+/*!****************************************************************************
+* @file    trace.h
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Event trace into RAM ring buffer, time stamped by a free-running TCB
+* @note     Built only with TRACE_EN set, otherwise trace macros expand to
+*           nothing. An event costs a store of ID and counter under
+*           interrupt lock, traceScope() records its end on scope exit.
+*           Dump is decoded by tools/trace_decode.py
+*/
+
+#ifndef trace_H
+#define trace_H
+
+/*!****************************************************************************
+* Include
+*/
+#include <avr/io.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "drv_errors.h"
+#include "device.h"
+#include "swtimer.h"
+#include "capture.h"
+
+/*!****************************************************************************
+* User define
+*/
+#ifndef TRACE_EN
+#define TRACE_EN                                0                               //Tracing compiled in
+#endif
+#ifndef TRACE_BUF_SIZE
+#define TRACE_BUF_SIZE                          64                              //Events kept, power of 2
+#endif
+#ifndef TRACE_TCB_NUM
+#define TRACE_TCB_NUM                           0                               //TCB counting time stamps
+#endif
+#ifndef TRACE_CLKSEL
+#define TRACE_CLKSEL                            TCB_CLKSEL_CLKDIV2_gc           //Time stamp clock
+#endif
+#ifndef TRACE_CLK_DIV
+#define TRACE_CLK_DIV                           2                               //CLK_PER cycles per count, matches TRACE_CLKSEL
+#endif
+#ifndef TRACE_WRAP_EN
+#define TRACE_WRAP_EN                           1                               //Counter wrap is an event, keeps long gaps decodable
+#endif
+#define TRACE_BUF_MASK                          (TRACE_BUF_SIZE - 1)
+#define TRACE_END                               0x80                            //ID flag of scope end event
+#define TRACE_MAGIC0                            'T'
+#define TRACE_MAGIC1                            'R'
+#define TRACE_FMT_VER                           1
+#define TRACE_HDR_SIZE                          8                               //Magic, version, count, clock Hz
+#define TRACE_PIN_BIT_CNT_MIN                   16                              //Counts per bit-banged bit, loop overhead
+
+#if (TRACE_EN != 0)
+#if (TRACE_BUF_SIZE & TRACE_BUF_MASK) != 0 || (TRACE_BUF_SIZE > 128)
+#error "TRACE_BUF_SIZE must be a power of 2 up to 128"
+#endif
+#if (TRACE_TCB_NUM >= DEV_TCB_NUM) || (TRACE_TCB_NUM == SWTIMER_TCB_NUM)
+#error "No free TCB for trace time stamps, TRACE_TCB_NUM is absent or drives swtimer"
+#endif
+#if ((TRACE_TCB_NUM == 0) && (CAPTURE_TCB0_EN != 0)) || ((TRACE_TCB_NUM == 1) && (CAPTURE_TCB1_EN != 0))
+#error "TCB used by trace is also used by capture"
+#endif
+#if (TRACE_TCB_NUM == 0)
+#define TRACE_TCB                               TCB0
+#define TRACE_TCB_vect                          TCB0_INT_vect
+#else
+#define TRACE_TCB                               TCB1
+#define TRACE_TCB_vect                          TCB1_INT_vect
+#endif
+#endif
+
+/*!****************************************************************************
+* User enum
+*/
+//Scope events record ID on entry and ID | TRACE_END on exit
+typedef enum{
+    traceIdNone = 0,                                                            //Slot never written
+    traceIdWrap,                                                                //Time stamp counter wrapped
+    traceIdAdcSample,
+    traceIdSpiTxRx,
+    traceIdSpiRx,
+    traceIdEepromWrite,
+    traceIdTimAWait,
+    traceIdTimBWait,
+    traceIdTimDWait,
+    traceIdIsrSwtimer,
+    traceIdIsrCapture,
+    traceIdIsrRtc,
+    traceIdIsrPit,
+    traceIdIsrTwim,
+    traceIdIsrTwis,
+    traceIdIsrAc,
+    traceIdUser = 0x40,                                                         //Application events from here to 0x7F
+}eTraceId;
+
+/*!****************************************************************************
+* User typedef
+*/
+typedef struct{
+    uint8_t             id;
+    uint16_t            stamp;                                                  //TRACE_TCB count
+}traceEntry_type;
+
+//Byte sink for the dump, usart_transmit() fits
+typedef eDrvError (*traceOut_type)(uint8_t *pData, uint16_t size);
+
+/*!****************************************************************************
+* User macro
+*/
+#if (TRACE_EN != 0)
+#define traceEvent(id)                          trace_event(id)
+#define traceScope(id)                          uint8_t traceScopeId __attribute__((__cleanup__(traceScopeEnd))) = trace_event(id)
+#define traceIsTcb(p)                           ((p) == &TRACE_TCB)
+#else
+#define traceEvent(id)
+#define traceScope(id)
+#define traceIsTcb(p)                           0
+#endif
+
+/*!****************************************************************************
+* Prototypes for the functions
+*/
+eDrvError trace_init(void);
+eDrvError trace_clear(void);
+eDrvError trace_dump(traceOut_type out);
+eDrvError trace_setPin(PORT_t *port, uint8_t npin, uint32_t baud);
+eDrvError trace_pinTransmit(uint8_t *pData, uint16_t size);
+extern traceEntry_type traceBuf[TRACE_BUF_SIZE];
+extern uint8_t traceHead;
+extern volatile bool traceIsPaused;
+
+#if (TRACE_EN != 0)
+#include <util/atomic.h>
+
+/*!****************************************************************************
+* @brief    Record event
+* @param    id - event ID
+* @return   ID, so a scope keeps it for its end event
+*/
+static inline uint8_t trace_event(uint8_t id){
+    traceEntry_type *pEntry;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        if(!traceIsPaused){
+            pEntry = &traceBuf[traceHead];
+            pEntry->stamp = TRACE_TCB.CNT;
+            pEntry->id = id;
+            traceHead = (traceHead + 1) & TRACE_BUF_MASK;
+        }
+    }
+    return id;
+}
+
+/*!****************************************************************************
+* @brief    Scope end, called on leaving scope of traceScope()
+*/
+static inline void traceScopeEnd(uint8_t *pId){
+    trace_event(*pId | TRACE_END);
+}
+#endif
+
+#endif //trace_H
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
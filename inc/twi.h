@@ -0,0 +1,82 @@
+/*!****************************************************************************
+* @file    twi.h
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   TWI (I2C) master driver with queued interrupt-driven transactions
+*/
+
+#ifndef twi_H
+#define twi_H
+
+/*!****************************************************************************
+* Include
+*/
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "drv_errors.h"
+#include "timeout.h"
+
+/*!****************************************************************************
+* User define
+*/
+#ifndef TWI_SCL_HZ
+#define TWI_SCL_HZ                              400000UL                        //Default SCL
+#endif
+#ifndef TWI_RISE_NS
+#define TWI_RISE_NS                             100                             //SCL rise time, bus capacitance and pull-ups
+#endif
+#ifndef TWI_XFER_TIMEOUT_US
+#define TWI_XFER_TIMEOUT_US                     5000                            //Budget per transaction incl. clock stretching
+#endif
+#ifndef TWI_PORT
+#define TWI_PORT                                PORTB                           //Pins for bus recovery, default pinout
+#define TWI_SCL_PIN                             0
+#define TWI_SDA_PIN                             1
+#endif
+#define TWI_FM_HZ                               400000UL                        //Above this Fm+ drive is enabled
+#define TWI_BAUD_OFFSET                         10                              //Fixed SCL cycle part in CLK_PER cycles
+#define TWI_RECOVER_PULSES                      9                               //SCL pulses to release stuck slave
+#define TWI_RECOVER_HALF_US                     5                               //Half SCL period during recovery, 100 kHz
+#define TWI_ADDR_MAX                            0x7F                            //7-bit addressing
+
+/*!****************************************************************************
+* User macro
+*/
+#define twiXferInit(addr, pTx, txLen, pRx, rxLen, cb)   {NULL, addr, pTx, txLen, pRx, rxLen, cb, NULL, drvNoError, true}
+
+/*!****************************************************************************
+* User typedef
+*/
+struct twiXfer_tag;
+//Called from ISR when transaction is finished
+typedef void (*twiCb_type)(struct twiXfer_tag *pXfer);
+
+typedef struct twiXfer_tag{
+    struct twiXfer_tag  *pNext;                                                 //Next transaction in queue
+    uint8_t             addr;                                                   //7-bit slave address
+    const uint8_t       *pTx;                                                   //Data written first, e.g. register address
+    uint8_t             txLen;                                                  //Bytes to write, 0 for read only
+    uint8_t             *pRx;                                                   //Data read after repeated start
+    uint8_t             rxLen;                                                  //Bytes to read, 0 for write only
+    twiCb_type          cb;                                                     //Completion callback (optional)
+    void                *pArg;                                                  //Callback argument
+    volatile eDrvError  status;                                                 //Result, valid when done
+    volatile bool       isDone;                                                 //Transaction finished or not queued
+}twiXfer_type;
+
+/*!****************************************************************************
+* Prototypes for the functions
+*/
+eDrvError twi_init(uint32_t sclHz);
+eDrvError twi_setScl(uint32_t sclHz);
+eDrvError twi_submit(twiXfer_type *pXfer);
+eDrvError twi_isDone(twiXfer_type *pXfer, bool *pIsDone);
+eDrvError twi_wait(twiXfer_type *pXfer);
+eDrvError twi_recover(void);
+
+#endif //twi_H
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
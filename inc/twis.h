@@ -0,0 +1,41 @@
+/*!****************************************************************************
+* @file    twis.h
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   TWI (I2C) slave driver with register map emulation
+*/
+
+#ifndef twis_H
+#define twis_H
+
+/*!****************************************************************************
+* Include
+*/
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "drv_errors.h"
+
+/*!****************************************************************************
+* User define
+*/
+#define TWIS_ADDR_MAX                           0x7F                            //7-bit addressing
+#define TWIS_READ_PAD                           0xFF                            //Read beyond the map end
+
+/*!****************************************************************************
+* User typedef
+*/
+//Called from ISR after STOP of a write, reg - first register written
+typedef void (*twisCb_type)(uint8_t reg, uint8_t len);
+
+/*!****************************************************************************
+* Prototypes for the functions
+*/
+eDrvError twis_init(uint8_t addr, uint8_t *pMap, uint8_t size, const uint8_t *pWrMask, bool fmPlus, twisCb_type cb);
+eDrvError twis_stop(void);
+
+#endif //twis_H
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
@@ -3,7 +3,7 @@
  * @author  4eef
  * @version V1.0
  * @date    November 5, 2023
- * @brief   
+ * @brief   Asynchronous USART0 driver, 8N1
  */
 
 #ifndef usart_H
@@ -14,12 +14,17 @@
  */
 #include <avr/io.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include "drv_errors.h"
+#include "timeout.h"
 
 /*!****************************************************************************
  * User define
  */
+#define USART_BAUD_MIN                          64                              //Lowest BAUD register value
+#define USART_FRAME_BITS                        10                              //Start, 8 data, stop
+#define USART_RX_TIMEOUT_US                     100000                          //Budget per byte received
 
 /*!****************************************************************************
  * User enum
@@ -32,6 +37,10 @@
 /*!****************************************************************************
  * Prototypes for the functions
  */
+eDrvError usart_init(uint32_t baud);
+eDrvError usart_setBaud(uint32_t baud);
+eDrvError usart_transmit(uint8_t *pTxData, uint16_t size);
+eDrvError usart_receive(uint8_t *pRxData, uint16_t size);
 
 #endif //usart_H
 /***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
@@ -0,0 +1,76 @@
+/*!****************************************************************************
+* @file    vref.h
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Voltage reference (VREF) arbitration for ADC, DAC and AC
+*/
+
+#ifndef vref_H
+#define vref_H
+
+/*!****************************************************************************
+* Include
+*/
+#include <avr/io.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "drv_errors.h"
+#include "device.h"
+
+/*!****************************************************************************
+* User define
+*/
+#ifndef VREF_SETTLE_US
+#define VREF_SETTLE_US                          100                             //Reference start-up and settling
+#endif
+#define VREF_SEL_NONE                           0                               //Zero-initialized user holds nothing
+
+/*!****************************************************************************
+* User enum
+*/
+//Fields of absent instances are left out, DACn users follow each other
+typedef enum{
+    vrefUserAdc0 = 0,                                                           //ADC0REFSEL
+#if (DEV_ADC_NUM > 1)
+    vrefUserAdc1,                                                               //ADC1REFSEL
+#endif
+    vrefUserDac0,                                                               //DAC0REFSEL: DAC0, AC0 VREF input
+#if (DEV_DAC_NUM > 1)
+    vrefUserDac1,                                                               //DAC1REFSEL: DAC1, AC1 VREF input
+#endif
+#if (DEV_DAC_NUM > 2)
+    vrefUserDac2,                                                               //DAC2REFSEL: DAC2, AC2 VREF input
+#endif
+    vrefUserNum
+}eVrefUser;
+
+typedef enum{
+    vrefSel0V55 = 0,
+    vrefSel1V1,
+    vrefSel2V5,
+    vrefSel4V34,
+    vrefSel1V5,
+    vrefSelNum
+}eVrefSel;
+
+/*!****************************************************************************
+* User typedef
+*/
+typedef struct{
+    uint32_t            readyUs;                                                //Settled from this time on
+    uint8_t             sel;                                                    //Selection + 1, VREF_SEL_NONE if released
+    uint8_t             holders;                                                //Drivers using the selection
+}vrefUser_type;
+
+/*!****************************************************************************
+* Prototypes for the functions
+*/
+eDrvError vref_request(eVrefUser user, eVrefSel sel);
+eDrvError vref_release(eVrefUser user);
+eDrvError vref_waitReady(eVrefUser user);
+eDrvError vref_getMv(eVrefSel sel, uint16_t *pMv);
+
+#endif //vref_H
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
@@ -14,14 +14,39 @@
 #include <avr/io.h>
 #include <avr/wdt.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include "drv_errors.h"
+#include "swtimer.h"
+
+/*!****************************************************************************
+* User define
+*/
+#define WATCHDOG_TASK_NUM                       16                              //Supervised tasks, IDs 0..15
+#define WATCHDOG_CULPRIT_NONE                   0xFF                            //All tasks had checked in
+#define WATCHDOG_CLK_US                         (1000000UL * 8 / 1024)          //8 WDT cycles at 1.024 kHz
+#define WATCHDOG_WINDOW_MARGIN_PCT              25                              //OSCULP32K tolerance on closed window
+#define WATCHDOG_NOINIT_MAGIC                   0x5744                          //Record was written before reset
+
+/*!****************************************************************************
+* User typedef
+*/
+typedef struct{
+    uint16_t            magic;                                                  //WATCHDOG_NOINIT_MAGIC
+    uint16_t            pending;                                                //Tasks not checked in yet
+    uint16_t            pendingInv;                                             //Complement of pending
+}watchdogRec_type;
 
 /*!****************************************************************************
 * Prototypes for the functions
 */
 eDrvError watchdog_init(WDT_PERIOD_t period, WDT_WINDOW_t window);
 eDrvError watchdog_refresh(void);
+eDrvError watchdog_taskRegister(uint8_t taskId);
+eDrvError watchdog_taskUnregister(uint8_t taskId);
+eDrvError watchdog_checkIn(uint8_t taskId);
+eDrvError watchdog_supervise(void);
+eDrvError watchdog_getCulprit(uint8_t *pTaskId, bool *pIsValid);
 
 #endif //watchdog_H
 /***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
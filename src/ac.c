@@ -0,0 +1,205 @@
+/*!****************************************************************************
+* @file    ac.c
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Analog comparator (AC) driver
+*/
+
+/*!****************************************************************************
+* Include
+*/
+#include "ac.h"
+#include "sleepctrl.h"
+#include "trace.h"
+
+/*!****************************************************************************
+* Local function prototypes
+*/
+AC_t *acGetInst(uint8_t acNum);
+void acIsr(uint8_t acNum);
+eDrvError acUpdateSleep(void);
+
+/*!****************************************************************************
+* MEMORY
+*/
+acCb_type acCb[AC_NUM];                                                         //Edge callbacks
+bool acIsVrefHeld[AC_NUM];                                                      //Comparator holds DACnREFSEL
+
+/*!****************************************************************************
+* @brief    Initialize and enable analog comparator
+* @param    acNum - comparator number
+* @param    *pCfg - comparator configuration
+* @param    cb - edge callback, NULL to keep interrupt disabled
+* @note     Output is also an EVSYS generator and a CCL input (AC0), routed by
+*           evsys and ccl drivers. Input pins are set up by caller
+*/
+eDrvError ac_init(uint8_t acNum, const acCfg_type *pCfg, acCb_type cb){
+    eDrvError exitStatus = drvUnknownError;
+    AC_t *p;
+
+    //Check inputs
+    p = acGetInst(acNum);
+    if((p == NULL) || (pCfg == NULL)){
+        return drvBadParameter;
+    }
+    exitStatus = ac_stop(acNum);
+    if(exitStatus != drvNoError) return exitStatus;
+    //Internal reference is shared with DACn, settles before enabling
+    if(pCfg->muxNeg == AC_MUXNEG_VREF_gc){
+        exitStatus = vref_request((eVrefUser)(vrefUserDac0 + acNum), pCfg->ref);
+        if(exitStatus != drvNoError) return exitStatus;
+        acIsVrefHeld[acNum] = true;
+        exitStatus = vref_waitReady((eVrefUser)(vrefUserDac0 + acNum));
+        if(exitStatus != drvNoError) return exitStatus;
+    }
+    p->MUXCTRLA = ((pCfg->invert ? 1 : 0) << AC_INVERT_bp) | pCfg->muxPos | pCfg->muxNeg;
+    acCb[acNum] = cb;
+    p->STATUS = AC_CMP_bm;
+    p->INTCTRL = ((cb != NULL) ? 1 : 0) << AC_CMP_bp;
+    p->CTRLA = ((pCfg->runStdby ? 1 : 0) << AC_RUNSTDBY_bp) | ((pCfg->outEn ? 1 : 0) << AC_OUTEN_bp) | pCfg->intMode |
+               ((pCfg->lowPower ? 1 : 0) << AC_LPMODE_bp) | pCfg->hyst | (1 << AC_ENABLE_bp);
+    exitStatus = acUpdateSleep();
+
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Disable analog comparator and release its reference
+* @param    acNum - comparator number
+*/
+eDrvError ac_stop(uint8_t acNum){
+    eDrvError exitStatus = drvUnknownError;
+    AC_t *p;
+
+    //Check inputs
+    p = acGetInst(acNum);
+    if(p == NULL){
+        return drvBadParameter;
+    }
+    p->CTRLA = 0;
+    p->INTCTRL = 0;
+    p->STATUS = AC_CMP_bm;
+    acCb[acNum] = NULL;
+    if(acIsVrefHeld[acNum]){
+        acIsVrefHeld[acNum] = false;
+        if(vref_release((eVrefUser)(vrefUserDac0 + acNum)) != drvNoError) return drvHwError;
+    }
+    exitStatus = acUpdateSleep();
+
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Get comparator output state
+* @param    acNum - comparator number
+* @param    *pState - pointer to store state to, true if positive input is higher
+*/
+eDrvError ac_getState(uint8_t acNum, bool *pState){
+    eDrvError exitStatus = drvUnknownError;
+    AC_t *p;
+
+    //Check inputs
+    p = acGetInst(acNum);
+    if((p == NULL) || (pState == NULL)){
+        return drvBadParameter;
+    }
+    *pState = (p->STATUS & AC_STATE_bm) ? true : false;
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Get comparator instance
+* @param    acNum - comparator number
+* @return   Pointer to instance or NULL if there is no such comparator
+*/
+AC_t *acGetInst(uint8_t acNum){
+    switch(acNum){
+        case 0:
+            return &AC0;
+#if (AC_NUM > 1)
+        case 1:
+            return &AC1;
+#endif
+#if (AC_NUM > 2)
+        case 2:
+            return &AC2;
+#endif
+        default:
+            return NULL;
+    }
+}
+
+/*!****************************************************************************
+* @brief    Comparator interrupt, clears flag and calls back
+* @param    acNum - comparator number
+*/
+void acIsr(uint8_t acNum){
+    AC_t *p;
+
+    p = acGetInst(acNum);
+    p->STATUS = AC_CMP_bm;
+    if(acCb[acNum] != NULL){
+        acCb[acNum](acNum, (p->STATUS & AC_STATE_bm) ? true : false);
+    }
+}
+
+/*!****************************************************************************
+* @brief    Limit sleep while comparators are enabled
+*/
+eDrvError acUpdateSleep(void){
+    SLPCTRL_SMODE_t mode;
+    bool isEnabled;
+    uint8_t i;
+    AC_t *p;
+
+    isEnabled = false;
+    mode = SLPCTRL_SMODE_STDBY_gc;
+    for(i = 0; i < AC_NUM; i++){
+        p = acGetInst(i);
+        if((p->CTRLA & AC_ENABLE_bm) == 0){
+            continue;
+        }
+        isEnabled = true;
+        if((p->CTRLA & AC_RUNSTDBY_bm) == 0){
+            mode = SLPCTRL_SMODE_IDLE_gc;
+        }
+    }
+    if(!isEnabled){
+        return sleepctrl_clearLimit(sleepUserAc);
+    }
+
+    return sleepctrl_setLimit(sleepUserAc, mode);
+}
+
+/*!****************************************************************************
+* @brief    AC0 interrupt
+*/
+ISR(AC0_AC_vect){
+    traceScope(traceIdIsrAc);
+    acIsr(0);
+}
+
+#if (AC_NUM > 1)
+/*!****************************************************************************
+* @brief    AC1 interrupt
+*/
+ISR(AC1_AC_vect){
+    traceScope(traceIdIsrAc);
+    acIsr(1);
+}
+#endif
+
+#if (AC_NUM > 2)
+/*!****************************************************************************
+* @brief    AC2 interrupt
+*/
+ISR(AC2_AC_vect){
+    traceScope(traceIdIsrAc);
+    acIsr(2);
+}
+#endif
+
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
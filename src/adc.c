@@ -10,14 +10,36 @@
 * Include
 */
 #include "adc.h"
+#include "clock.h"
+#include "sleepctrl.h"
+#include "vref.h"
+#include "trace.h"
+
+/*!****************************************************************************
+* Local macro
+*/
+#if (DEV_ADC_NUM > 1)
+#define adcGetIdx(p)                            (((p) == &ADC0) ? 0 : 1)
+#else
+#define adcGetIdx(p)                            0
+#endif
 
 /*!****************************************************************************
 * Local function prototypes
 */
-eDrvError adcDelay(uint16_t time);
+eDrvError adcRetime(eClockEv ev, uint32_t hzOld, uint32_t hzNew);
+
+/*!****************************************************************************
+* MEMORY
+*/
+uint32_t adcRefHz;                                                              //System clock channel prescalers are meant for
+int8_t adcPrescShift;                                                           //Prescaler correction at current clock, powers of 2
+uint8_t adcRefSel[DEV_ADC_NUM];                                                 //Internal reference held per ADC, selection + 1
 
 /*!****************************************************************************
 * @brief    Initialize ADC module
+* @note     Channel prescalers are meant for the system clock at this call, ADC
+*           clock is kept on clock_set() changes by powers of two
 */
 eDrvError adc_init(ADC_t *p, ADC_RESSEL_t resolution, ADC_DUTYCYC_t dutyCyc, ADC_ASDV_t autoSmpDelay, uint8_t startEvent){
     eDrvError exitStatus = drvUnknownError;
@@ -37,8 +59,11 @@ eDrvError adc_init(ADC_t *p, ADC_RESSEL_t resolution, ADC_DUTYCYC_t dutyCyc, ADC
     p->EVCTRL   |= startEvent;
     p->DBGCTRL  &= ADC_DBGRUN_bm;
     p->DBGCTRL  |= ADC_DBG_RUN << ADC_DBGRUN_bp;
-    //Initialize delay timer
-    timer_initTimB(&TCB1, TCB_CNTMODE_SINGLE_gc, TCB_CLKSEL_CLKDIV2_gc);
+    //Reference settling timer, shared with other drivers
+    if(swtimer_init() != drvNoError) return drvHwError;
+    if(clock_getHz(&adcRefHz) != drvNoError) return drvHwError;
+    adcPrescShift = 0;
+    if(clock_register(adcRetime) != drvNoError) return drvHwError;
     
     exitStatus = drvNoError;
     return exitStatus;
@@ -49,7 +74,13 @@ eDrvError adc_init(ADC_t *p, ADC_RESSEL_t resolution, ADC_DUTYCYC_t dutyCyc, ADC
 */
 eDrvError adc_getSample(adcChannel_type adcChannel, uint16_t *pData, uint8_t *pOverSampled, uint16_t *pRefVolt){
     eDrvError exitStatus = drvUnknownError, drvExStatus;
-    uint8_t i;
+    eSleepUser user;
+    eVrefUser vrefUser;
+    eVrefSel sel;
+    timeout_type to;
+    int8_t presc;
+    uint8_t i, idx;
+    traceScope(traceIdAdcSample);
     
     //Perform checks
     if((pData == NULL) || (pOverSampled == NULL) || (pRefVolt == NULL)){
@@ -57,20 +88,22 @@ eDrvError adc_getSample(adcChannel_type adcChannel, uint16_t *pData, uint8_t *pO
     }
     
     //VREF
+    idx = adcGetIdx(adcChannel.p);
+    vrefUser = (eVrefUser)(vrefUserAdc0 + idx);
+    sel = (eVrefSel)(adcChannel.intRefSrc >> VREF_ADC0REFSEL_gp);
+    //Reference held for other channel settings is given back first
+    if((adcRefSel[idx] != VREF_SEL_NONE) && ((adcChannel.refSel != ADC_REFSEL_INTREF_gc) || (adcRefSel[idx] != sel + 1))){
+        if(vref_release(vrefUser) != drvNoError) return drvHwError;
+        adcRefSel[idx] = VREF_SEL_NONE;
+    }
     if(adcChannel.refSel == ADC_REFSEL_INTREF_gc){
-        if((adcChannel.p == &ADC0) && (VREF.CTRLA != adcChannel.intRefSrc)){
-            VREF.CTRLB &= ~VREF_ADC0REFEN_bm;
-            VREF.CTRLA &= ~VREF_ADC0REFSEL_gm;
-            VREF.CTRLA |= adcChannel.intRefSrc;
-            VREF.CTRLB |= 1 << VREF_ADC0REFEN_bp;
-        }else if((adcChannel.p == &ADC1) && (VREF.CTRLC != adcChannel.intRefSrc)){
-            VREF.CTRLD &= ~VREF_ADC1REFEN_bm;
-            VREF.CTRLC &= ~VREF_ADC1REFSEL_gm;
-            VREF.CTRLC |= adcChannel.intRefSrc;
-            VREF.CTRLD |= 1 << VREF_ADC1REFEN_bp;
+        if(adcRefSel[idx] == VREF_SEL_NONE){
+            drvExStatus = vref_request(vrefUser, sel);
+            if(drvExStatus != drvNoError) return drvExStatus;
+            adcRefSel[idx] = sel + 1;
         }
-        //Perform delay to stabilize ADC
-        drvExStatus = adcDelay(ADC_STABILIZE_TIME);
+        //Wait for reference to settle after a change only
+        drvExStatus = vref_waitReady(vrefUser);
         if(drvExStatus != drvNoError) return drvHwError;
         //Return reference voltage
         switch(adcChannel.intRefSrc){
@@ -138,8 +171,11 @@ eDrvError adc_getSample(adcChannel_type adcChannel, uint16_t *pData, uint8_t *pO
     adcChannel.p->SAMPCTRL |= adcChannel.smpCap << ADC_SAMPCAP_bp;
     adcChannel.p->CTRLA &= ~ADC_FREERUN_bm;
     adcChannel.p->CTRLA |= adcChannel.freerun << ADC_FREERUN_bp;
+    presc = (int8_t)(adcChannel.prescaler & ADC_PRESC_gm) + adcPrescShift;
+    if(presc < 0) presc = 0;
+    if(presc > (int8_t)ADC_PRESC_gm) presc = ADC_PRESC_gm;
     adcChannel.p->CTRLC &= ~ADC_PRESC_gm;
-    adcChannel.p->CTRLC |= adcChannel.prescaler;
+    adcChannel.p->CTRLC |= presc;
     adcChannel.p->CTRLC &= ~ADC_REFSEL_gm;
     adcChannel.p->CTRLC |= adcChannel.refSel;
     adcChannel.p->CTRLB &= ~ADC_SAMPNUM_gm;
@@ -147,10 +183,21 @@ eDrvError adc_getSample(adcChannel_type adcChannel, uint16_t *pData, uint8_t *pO
     adcChannel.p->CTRLE &= ~ADC_WINCM_gm;
     adcChannel.p->CTRLE |= adcChannel.wndCmp;
     adcChannel.p->CTRLA |= 1 << ADC_ENABLE_bp;
+    //Free running window comparator keeps converting after return
+    user = (eSleepUser)(sleepUserAdc0 + idx);
+    if(adcChannel.freerun && (adcChannel.wndCmp != ADC_WINCM_NONE_gc)){
+        drvExStatus = sleepctrl_setLimit(user, (adcChannel.p->CTRLA & ADC_RUNSTBY_bm) ? SLPCTRL_SMODE_STDBY_gc : SLPCTRL_SMODE_IDLE_gc);
+    }else{
+        drvExStatus = sleepctrl_clearLimit(user);
+    }
+    if(drvExStatus != drvNoError) return drvHwError;
     //Perform measurement
     for(i = 0; i < ADC_MEASUREMENTS_NUM; i++){
         adcChannel.p->COMMAND |= 1 << ADC_STCONV_bp;
-        while(!(adcChannel.p->INTFLAGS & ADC_RESRDY_bm));          //TO DO: add a timer
+        if(timeout_start(&to, ADC_TIMEOUT_US) != drvNoError) return drvHwError;
+        while(!(adcChannel.p->INTFLAGS & ADC_RESRDY_bm)){
+            if(timeout_check(&to, timeoutSiteAdcResRdy) != drvNoError) return drvHwError;
+        }
         *pData = adcChannel.p->RES;
     }
     
@@ -159,25 +206,31 @@ eDrvError adc_getSample(adcChannel_type adcChannel, uint16_t *pData, uint8_t *pO
 }
 
 /*!****************************************************************************
-* @brief    Delaying mechanism in microsecond resolution for ADC peripherals
-* @param    time - delay time in 0.1 x microseconds
+* @brief    Keep ADC clock on system clock change
+* @param    ev - before or after the switch
+* @param    hzOld - clock before the switch
+* @param    hzNew - clock after the switch
+* @note     Nearest power of two between the clock at adc_init() and the new one
 */
-eDrvError adcDelay(uint16_t time){
-    eDrvError exitStatus = drvUnknownError, drvExStatus;
-    uint16_t cycLen;
-    bool cycBrkn;
+eDrvError adcRetime(eClockEv ev, uint32_t hzOld, uint32_t hzNew){
+    int8_t shift;
     
-    //Check input
-    if(time > ADC_DELAY_MAX){
-        return drvBadParameter;
+    (void)hzOld;
+    if(ev != clockEvPost){
+        return drvNoError;
     }
-    drvExStatus = timer_startTimB(&TCB1, time);
-    if(drvExStatus != drvNoError) return drvHwError;
-    drvExStatus = timer_waitOvfTimB(&TCB1, &cycLen, &cycBrkn);
-    if((drvExStatus != drvNoError) || (cycBrkn == true)) return drvHwError;
+    shift = 0;
+    while((hzNew > adcRefHz + (adcRefHz >> 1)) && (shift < (int8_t)ADC_PRESC_gm)){
+        hzNew >>= 1;
+        shift++;
+    }
+    while((hzNew + (hzNew >> 1) < adcRefHz) && (shift > -(int8_t)ADC_PRESC_gm)){
+        hzNew <<= 1;
+        shift--;
+    }
+    adcPrescShift = shift;
     
-    exitStatus = drvNoError;
-    return exitStatus;
+    return drvNoError;
 }
 
 /***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
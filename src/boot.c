@@ -0,0 +1,169 @@
+/*!****************************************************************************
+* @file    boot.c
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Staged and deferred peripheral initialization with boot timing
+*/
+
+/*!****************************************************************************
+* Include
+*/
+#include "boot.h"
+
+/*!****************************************************************************
+* Local function prototypes
+*/
+eDrvError bootRun(bootItem_type *pItem);
+
+/*!****************************************************************************
+* MEMORY
+*/
+bootItem_type *bootItems;                                                       //Initializers table, owned by application
+uint8_t bootItemNum;
+uint8_t bootNext;                                                               //Next deferred item to look at
+uint32_t bootStageUs[bootStageNum];                                             //Time spent per stage
+
+/*!****************************************************************************
+* @brief    Set up table of initializers
+* @param    *pItems - initializers, run in table order within a stage
+* @param    num - number of initializers
+* @note     Time base is started here, its start-up is a few register writes
+*/
+eDrvError boot_init(bootItem_type *pItems, uint8_t num){
+    eDrvError exitStatus = drvUnknownError;
+    uint8_t i;
+
+    //Check inputs
+    if((pItems == NULL) || (num == 0)){
+        return drvBadParameter;
+    }
+    for(i = 0; i < num; i++){
+        if((pItems[i].init == NULL) || (pItems[i].stage >= bootStageNum)){
+            return drvBadParameter;
+        }
+        pItems[i].isDone = false;
+        pItems[i].timeUs = 0;
+        pItems[i].status = drvUnknownError;
+    }
+    for(i = 0; i < bootStageNum; i++){
+        bootStageUs[i] = 0;
+    }
+    bootItems = pItems;
+    bootItemNum = num;
+    bootNext = 0;
+    if(swtimer_init() != drvNoError) return drvHwError;
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Run all initializers of the stage which haven't run yet
+* @param    stage - stage to run
+* @return   drvHwError if any initializer failed, the rest are run regardless
+*/
+eDrvError boot_runStage(eBootStage stage){
+    eDrvError exitStatus = drvUnknownError;
+    uint8_t i;
+
+    //Check inputs
+    if(stage >= bootStageNum){
+        return drvBadParameter;
+    }
+    if(bootItems == NULL){
+        return drvHwError;
+    }
+    exitStatus = drvNoError;
+    for(i = 0; i < bootItemNum; i++){
+        if((bootItems[i].stage == stage) && !bootItems[i].isDone){
+            if(bootRun(&bootItems[i]) != drvNoError) exitStatus = drvHwError;
+        }
+    }
+
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Run one pending deferred initializer, to be called from main loop
+* @param    *pIsDone - true when no deferred initializer is left
+* @return   Result of the initializer run
+*/
+eDrvError boot_poll(bool *pIsDone){
+    eDrvError exitStatus = drvUnknownError;
+
+    //Check inputs
+    if(pIsDone == NULL){
+        return drvBadParameter;
+    }
+    if(bootItems == NULL){
+        return drvHwError;
+    }
+    //Skip the ones already started on first use
+    while((bootNext < bootItemNum) && ((bootItems[bootNext].stage != bootStageDeferred) || bootItems[bootNext].isDone)){
+        bootNext++;
+    }
+    exitStatus = drvNoError;
+    if(bootNext < bootItemNum){
+        exitStatus = bootRun(&bootItems[bootNext]);
+        bootNext++;
+    }
+    *pIsDone = (bootNext >= bootItemNum);
+
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Initialize on first use, to be called before using the peripheral
+* @param    *pItem - initializer from the table
+* @return   Result of the initializer (stored one if it has already run)
+*/
+eDrvError boot_ensure(bootItem_type *pItem){
+    //Check inputs
+    if(pItem == NULL){
+        return drvBadParameter;
+    }
+    if(pItem->isDone){
+        return pItem->status;
+    }
+
+    return bootRun(pItem);
+}
+
+/*!****************************************************************************
+* @brief    Get time spent in initializers of the stage
+* @param    stage - stage
+* @param    *pUs - pointer to store time to, microseconds
+*/
+eDrvError boot_getStageUs(eBootStage stage, uint32_t *pUs){
+    eDrvError exitStatus = drvUnknownError;
+
+    //Check inputs
+    if((stage >= bootStageNum) || (pUs == NULL)){
+        return drvBadParameter;
+    }
+    *pUs = bootStageUs[stage];
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Run initializer and measure it
+* @param    *pItem - initializer
+*/
+eDrvError bootRun(bootItem_type *pItem){
+    uint64_t start, end;
+
+    //Marked first, so the initializer may use other ones on first use itself
+    pItem->isDone = true;
+    swtimer_getStamp(&start);
+    pItem->status = pItem->init();
+    swtimer_getStamp(&end);
+    pItem->timeUs = SWTIMER_STAMP_TO_US(end - start);
+    bootStageUs[pItem->stage] += pItem->timeUs;
+
+    return pItem->status;
+}
+
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
@@ -0,0 +1,379 @@
+/*!****************************************************************************
+* @file    calendar.c
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Calendar and wall-clock time on the RTC (Unix time, 1970..2106)
+*/
+
+/*!****************************************************************************
+* Include
+*/
+#include "calendar.h"
+#include <util/atomic.h>
+
+/*!****************************************************************************
+* Local define
+*/
+#define CALENDAR_PPM_DIV                        1000000L
+#define CALENDAR_DAYS_0000_TO_1970              719468UL                        //Days from 0000-03-01 to 1970-01-01
+#define CALENDAR_DAYS_PER_ERA                   146097UL                        //400 years
+#define CALENDAR_EPOCH_DAYS_MAX                 49710UL                         //2106-02-07
+#define CALENDAR_EPOCH_SOD_MAX                  23295UL                         //06:28:15 that day
+#define CALENDAR_EPOCH_WDAY                     4                               //1970-01-01 was Thursday
+
+/*!****************************************************************************
+* Local function prototypes
+*/
+void calendarCivil(uint16_t days, calDate_type *pDate);
+void calendarHms(uint32_t sod, calDate_type *pDate);
+void calendarNextDay(calDate_type *pDate);
+uint8_t calendarMonthDays(uint16_t year, uint8_t month);
+void calendarRtcEvent(uint8_t flags);
+
+/*!****************************************************************************
+* MEMORY
+*/
+const uint8_t calMonthDays[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+volatile uint32_t calSec;                                                       //Unix time, seconds
+calDate_type calCache;                                                          //Date of the last read
+uint32_t calCacheDay0;                                                          //Unix time of cached midnight
+bool calCacheIsValid;
+int32_t calTrimAcc;                                                             //Trim error, 1e-6 counts
+int32_t calTrimFrac;                                                            //Trim per second, fraction of count
+int16_t calTrimWhole;                                                           //Trim per second, whole counts
+uint16_t calPer;                                                                //RTC period in use
+bool calIsInit;
+
+/*!****************************************************************************
+* @brief    Start calendar, takes over RTC
+* @param    clkSel - 32.768 kHz source (RTC_CLKSEL_TOSC32K_gc after clock_initXosc32k())
+* @note     Overflow interrupt counts seconds, global interrupts must be enabled
+*/
+eDrvError calendar_init(RTC_CLKSEL_t clkSel){
+    eDrvError exitStatus = drvUnknownError;
+
+    //Check inputs
+    if(clkSel == RTC_CLKSEL_INT1K_gc){
+        return drvBadParameter;
+    }
+    calIsInit = false;
+    calSec = 0;
+    calCacheIsValid = false;
+    calTrimAcc = 0;
+    calTrimFrac = 0;
+    calTrimWhole = 0;
+    calPer = CALENDAR_CNT_PER_SEC - 1;
+    if(rtc_init(clkSel, 0, calPer, RTC_PRESCALER_DIV1_gc, true) != drvNoError){
+        return drvHwError;
+    }
+    if(rtc_setCallback(calendarRtcEvent, RTC_OVF_bm) != drvNoError){
+        return drvHwError;
+    }
+    calIsInit = true;
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Set time
+* @param    epoch - Unix time, second starts now
+*/
+eDrvError calendar_set(uint32_t epoch){
+    eDrvError exitStatus = drvUnknownError;
+
+    //Check state
+    if(!calIsInit){
+        return drvHwError;
+    }
+    if(rtc_setCnt(0) != drvNoError){
+        return drvHwError;
+    }
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        RTC.INTFLAGS = RTC_OVF_bm;
+        calSec = epoch;
+    }
+    calCacheIsValid = false;
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Set time from date
+* @param    *pDate - date and time, wday is ignored
+*/
+eDrvError calendar_setDate(const calDate_type *pDate){
+    eDrvError exitStatus = drvUnknownError;
+    uint32_t epoch;
+
+    exitStatus = calendar_dateToEpoch(pDate, &epoch);
+    if(exitStatus != drvNoError){
+        return exitStatus;
+    }
+
+    return calendar_set(epoch);
+}
+
+/*!****************************************************************************
+* @brief    Get time
+* @param    *pEpoch - pointer to store Unix time to
+* @param    *pSubSec - pointer to store fraction of second to (RTC counts), NULL if not needed
+*/
+eDrvError calendar_getEpoch(uint32_t *pEpoch, uint16_t *pSubSec){
+    eDrvError exitStatus = drvUnknownError;
+    uint32_t sec;
+    uint16_t cnt;
+
+    //Check inputs
+    if(pEpoch == NULL){
+        return drvBadParameter;
+    }
+    if(!calIsInit){
+        return drvHwError;
+    }
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        cnt = RTC.CNT;
+        sec = calSec;
+        //Second which isn't counted yet
+        if((RTC.INTFLAGS & RTC_OVF_bm) && (cnt < (CALENDAR_CNT_PER_SEC / 2))){
+            sec++;
+        }
+    }
+    *pEpoch = sec;
+    if(pSubSec != NULL){
+        *pSubSec = cnt;
+    }
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Get date and time
+* @param    *pDate - pointer to store date to
+* @note     Date of the previous call is reused: within a day this costs two
+*           multiplications, crossing midnight one increment. Thread context only
+*/
+eDrvError calendar_getDate(calDate_type *pDate){
+    eDrvError exitStatus = drvUnknownError;
+    uint32_t epoch, sod;
+
+    //Check inputs
+    if(pDate == NULL){
+        return drvBadParameter;
+    }
+    exitStatus = calendar_getEpoch(&epoch, NULL);
+    if(exitStatus != drvNoError){
+        return exitStatus;
+    }
+    sod = epoch - calCacheDay0;
+    if(calCacheIsValid && (sod < CALENDAR_SEC_PER_DAY)){
+        //Same day
+    }else if(calCacheIsValid && (sod < 2 * CALENDAR_SEC_PER_DAY)){
+        calendarNextDay(&calCache);
+        calCacheDay0 += CALENDAR_SEC_PER_DAY;
+        sod -= CALENDAR_SEC_PER_DAY;
+    }else{
+        calendar_epochToDate(epoch, &calCache);
+        sod = (uint32_t)calCache.hour * 3600 + (uint16_t)calCache.min * 60 + calCache.sec;
+        calCacheDay0 = epoch - sod;
+        calCacheIsValid = true;
+    }
+    calendarHms(sod, &calCache);
+    *pDate = calCache;
+
+    return drvNoError;
+}
+
+/*!****************************************************************************
+* @brief    Trim calendar drift
+* @param    ppm - measured error, positive if calendar runs fast
+* @note     Whole counts are added to every second, the fraction is spread over seconds
+*/
+eDrvError calendar_setTrim(int16_t ppm){
+    eDrvError exitStatus = drvUnknownError;
+    int32_t counts;
+
+    //Check inputs
+    if((ppm > CALENDAR_TRIM_MAX_PPM) || (ppm < -CALENDAR_TRIM_MAX_PPM)){
+        return drvBadParameter;
+    }
+    //Counts per second in 1e-6 units
+    counts = (int32_t)ppm * (int32_t)CALENDAR_CNT_PER_SEC;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        calTrimWhole = counts / CALENDAR_PPM_DIV;
+        calTrimFrac = counts - (int32_t)calTrimWhole * CALENDAR_PPM_DIV;
+        calTrimAcc = 0;
+    }
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Convert Unix time to date
+* @param    epoch - Unix time
+* @param    *pDate - pointer to store date to
+* @note     Constant divisions only, no loops over years or months
+*/
+eDrvError calendar_epochToDate(uint32_t epoch, calDate_type *pDate){
+    eDrvError exitStatus = drvUnknownError;
+    uint16_t days;
+
+    //Check inputs
+    if(pDate == NULL){
+        return drvBadParameter;
+    }
+    days = epoch / CALENDAR_SEC_PER_DAY;
+    calendarCivil(days, pDate);
+    calendarHms(epoch - (uint32_t)days * CALENDAR_SEC_PER_DAY, pDate);
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Convert date to Unix time
+* @param    *pDate - date and time, wday is ignored
+* @param    *pEpoch - pointer to store Unix time to
+*/
+eDrvError calendar_dateToEpoch(const calDate_type *pDate, uint32_t *pEpoch){
+    eDrvError exitStatus = drvUnknownError;
+    uint32_t days, sod;
+    uint16_t year, yoe, era, doy;
+    uint8_t month;
+
+    //Check inputs
+    if((pDate == NULL) || (pEpoch == NULL)){
+        return drvBadParameter;
+    }
+    if((pDate->year < 1970) || (pDate->month < 1) || (pDate->month > 12) || (pDate->day < 1)){
+        return drvBadParameter;
+    }
+    if((pDate->day > calendarMonthDays(pDate->year, pDate->month)) || (pDate->hour > 23) || (pDate->min > 59) || (pDate->sec > 59)){
+        return drvBadParameter;
+    }
+    //Year starts in March, leap day is the last one
+    year = pDate->year - ((pDate->month <= 2) ? 1 : 0);
+    month = (pDate->month > 2) ? pDate->month - 3 : pDate->month + 9;
+    era = year / 400;
+    yoe = year - era * 400;
+    doy = (153 * month + 2) / 5 + pDate->day - 1;
+    days = (uint32_t)era * CALENDAR_DAYS_PER_ERA + (uint32_t)yoe * 365 + yoe / 4 - yoe / 100 + doy - CALENDAR_DAYS_0000_TO_1970;
+    sod = (uint32_t)pDate->hour * 3600 + (uint16_t)pDate->min * 60 + pDate->sec;
+    if((days > CALENDAR_EPOCH_DAYS_MAX) || ((days == CALENDAR_EPOCH_DAYS_MAX) && (sod > CALENDAR_EPOCH_SOD_MAX))){
+        return drvBadParameter;
+    }
+    *pEpoch = days * CALENDAR_SEC_PER_DAY + sod;
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Days since 1970-01-01 to year, month, day and weekday
+* @param    days - days since epoch
+* @param    *pDate - pointer to store date to
+*/
+void calendarCivil(uint16_t days, calDate_type *pDate){
+    uint32_t z, era, doe;
+    uint16_t yoe, doy, mp;
+
+    //Count from 0000-03-01 so that leap day ends the year
+    z = days + CALENDAR_DAYS_0000_TO_1970;
+    era = z / CALENDAR_DAYS_PER_ERA;
+    doe = z - era * CALENDAR_DAYS_PER_ERA;
+    yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    doy = doe - (365 * (uint32_t)yoe + yoe / 4 - yoe / 100);
+    //(5 * doy + 2) / 153 and (153 * mp + 2) / 5 by multiplication, exact in range
+    mp = ((uint32_t)(5 * doy + 2) * 857) >> 17;
+    pDate->day = doy - (((uint32_t)(153 * mp + 2) * 1639) >> 13) + 1;
+    pDate->month = (mp < 10) ? mp + 3 : mp - 9;
+    pDate->year = yoe + era * 400 + ((pDate->month <= 2) ? 1 : 0);
+    pDate->wday = (days + CALENDAR_EPOCH_WDAY) % 7;
+}
+
+/*!****************************************************************************
+* @brief    Seconds of day to hours, minutes and seconds
+* @param    sod - seconds since midnight
+* @param    *pDate - pointer to store time to
+*/
+void calendarHms(uint32_t sod, calDate_type *pDate){
+    uint16_t rem;
+
+    //sod / 3600 and rem / 60 by multiplication, exact in range
+    pDate->hour = (sod * 37283UL) >> 27;
+    rem = sod - (uint32_t)pDate->hour * 3600;
+    pDate->min = ((uint32_t)rem * 2185) >> 17;
+    pDate->sec = rem - pDate->min * 60;
+}
+
+/*!****************************************************************************
+* @brief    Advance date by one day
+* @param    *pDate - date to advance
+*/
+void calendarNextDay(calDate_type *pDate){
+    pDate->wday = (pDate->wday == 6) ? 0 : pDate->wday + 1;
+    if(pDate->day < calendarMonthDays(pDate->year, pDate->month)){
+        pDate->day++;
+        return;
+    }
+    pDate->day = 1;
+    if(pDate->month < 12){
+        pDate->month++;
+        return;
+    }
+    pDate->month = 1;
+    pDate->year++;
+}
+
+/*!****************************************************************************
+* @brief    Number of days in month
+* @param    year - year
+* @param    month - month 1..12
+*/
+uint8_t calendarMonthDays(uint16_t year, uint8_t month){
+    if((month == 2) && ((year & 3) == 0) && (((year % 100) != 0) || ((year % 400) == 0))){
+        return 29;
+    }
+
+    return calMonthDays[month - 1];
+}
+
+/*!****************************************************************************
+* @brief    RTC overflow: count second and apply drift trim, called from RTC ISR
+* @param    flags - served interrupt flags
+*/
+void calendarRtcEvent(uint8_t flags){
+    int16_t adj;
+    uint16_t per;
+
+    if((flags & RTC_OVF_bm) == 0){
+        return;
+    }
+    calSec++;
+    //Length of the second which has just started
+    adj = calTrimWhole;
+    calTrimAcc += calTrimFrac;
+    if(calTrimAcc >= CALENDAR_PPM_DIV){
+        calTrimAcc -= CALENDAR_PPM_DIV;
+        adj++;
+    }else if(calTrimAcc <= -CALENDAR_PPM_DIV){
+        calTrimAcc += CALENDAR_PPM_DIV;
+        adj--;
+    }
+    per = CALENDAR_CNT_PER_SEC - 1 + adj;
+    if(per != calPer){
+        if(RTC.STATUS & RTC_PERBUSY_bm){
+            //Previous write is still synchronizing, keep the error for later
+            calTrimAcc += (int32_t)(per - calPer) * CALENDAR_PPM_DIV;
+        }else{
+            RTC.PER = per;
+            calPer = per;
+        }
+    }
+}
+
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
@@ -0,0 +1,347 @@
+/*!****************************************************************************
+* @file    capture.c
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   TCB input capture driver (frequency and pulse-width measurement)
+*/
+
+/*!****************************************************************************
+* Include
+*/
+#include "capture.h"
+#include "evsys.h"
+#include "trace.h"
+#include <util/atomic.h>
+
+/*!****************************************************************************
+* Local define
+*/
+#define CAPTURE_RECIP_ITER                      3                               //Newton-Raphson iterations
+
+/*!****************************************************************************
+* Local macro
+*/
+#if (DEV_TCB_NUM > 1)
+#define captureEvUser(p)                        (((p) == &TCB0) ? evsysUserTcb0 : evsysUserTcb1)
+#else
+#define captureEvUser(p)                        evsysUserTcb0
+#endif
+
+/*!****************************************************************************
+* Local function prototypes
+*/
+captureCh_type *captureGetCh(TCB_t *p);
+void captureIsr(TCB_t *p, captureCh_type *pCh);
+uint32_t captureRecip(uint16_t cnt, uint8_t *pNorm);
+
+/*!****************************************************************************
+* MEMORY
+*/
+#if (CAPTURE_TCB0_EN != 0)
+captureCh_type captureCh0;
+#endif
+#if (CAPTURE_TCB1_EN != 0)
+captureCh_type captureCh1;
+#endif
+
+/*!****************************************************************************
+* @brief    Initialize TCB in one of input capture modes fed from EVSYS
+* @param    *p - timer instance
+* @param    mode - TCB_CNTMODE_FRQ_gc, TCB_CNTMODE_PW_gc or TCB_CNTMODE_FRQPW_gc
+* @param    clk - clock prescaler setting
+* @param    clkHz - resulting counter clock frequency, used for scaling
+* @param    evCh - asynchronous event channel number (0..3)
+* @param    evGen - generator for the channel (e.g. EVSYS_ASYNCCH0_PORTA_PIN3_gc)
+* @param    negEdge - start measurement on negative edge
+* @param    filter - enable input capture noise cancellation
+* @note     Global interrupts must be enabled by application
+*/
+eDrvError capture_init(TCB_t *p, TCB_CNTMODE_t mode, TCB_CLKSEL_t clk, uint32_t clkHz, uint8_t evCh, uint8_t evGen, bool negEdge, bool filter){
+    eDrvError exitStatus = drvUnknownError;
+    captureCh_type *pCh;
+    uint32_t quot, rem;
+    uint8_t shift;
+
+    //Check inputs
+    pCh = captureGetCh(p);
+    if((pCh == NULL) || (evCh >= CAPTURE_EV_CH_NUM) || (clkHz < CAPTURE_US_HZ / UINT16_MAX)){
+        return drvBadParameter;
+    }
+    if((mode != TCB_CNTMODE_FRQ_gc) && (mode != TCB_CNTMODE_PW_gc) && (mode != TCB_CNTMODE_FRQPW_gc)){
+        return drvBadParameter;
+    }
+    //Counts to microseconds: us = (cnt * usMul) >> usShift, usMul normalized to 16 bits
+    quot = CAPTURE_US_HZ / clkHz;
+    rem = CAPTURE_US_HZ % clkHz;
+    shift = 0;
+    while((quot < 0x8000) && (shift < 31)){
+        quot <<= 1;
+        rem <<= 1;
+        if(rem >= clkHz){
+            rem -= clkHz;
+            quot |= 1;
+        }
+        shift++;
+    }
+    //Counter clock as 16 bit mantissa and exponent for Hz conversion
+    pCh->hzExp = 0;
+    while(clkHz > UINT16_MAX){
+        clkHz = (clkHz + 1) >> 1;
+        pCh->hzExp++;
+    }
+    pCh->hzMant = clkHz;
+    pCh->usMul = quot;
+    pCh->usShift = shift;
+    pCh->mode = mode;
+    pCh->head = 0;
+    pCh->tail = 0;
+    pCh->overruns = 0;
+    //Set up timer
+    p->CTRLA &= ~TCB_ENABLE_bm;
+    p->CTRLA &= ~TCB_CLKSEL_gm;
+    p->CTRLA |= clk;
+    p->CTRLB &= ~TCB_CNTMODE_gm;
+    p->CTRLB |= mode;
+    p->EVCTRL = (1 << TCB_CAPTEI_bp) | ((negEdge ? 1 : 0) << TCB_EDGE_bp) | ((filter ? 1 : 0) << TCB_FILTER_bp);
+    //Route the event channel to the timer
+    exitStatus = evsys_route((eEvsysCh)(evsysChAsync0 + evCh), evGen, captureEvUser(p));
+    if(exitStatus != drvNoError) return exitStatus;
+    //Clear pending capture and enable interrupt
+    p->INTFLAGS = TCB_CAPT_bm;
+    p->INTCTRL |= 1 << TCB_CAPT_bp;
+    p->CTRLA |= 1 << TCB_ENABLE_bp;
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Stop capturing and disable interrupt
+* @param    *p - timer instance
+*/
+eDrvError capture_stop(TCB_t *p){
+    eDrvError exitStatus = drvUnknownError;
+
+    //Check inputs
+    if(captureGetCh(p) == NULL){
+        return drvBadParameter;
+    }
+    //Stop timer
+    p->CTRLA &= ~TCB_ENABLE_bm;
+    p->INTCTRL &= ~TCB_CAPT_bm;
+    p->EVCTRL &= ~TCB_CAPTEI_bm;
+    p->INTFLAGS = TCB_CAPT_bm;
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Fetch oldest captured sample
+* @param    *p - timer instance
+* @param    *pSmp - pointer to store the sample to
+* @param    *pIsValid - false if there was no sample in buffer
+*/
+eDrvError capture_get(TCB_t *p, captureSmp_type *pSmp, bool *pIsValid){
+    eDrvError exitStatus = drvUnknownError;
+    captureCh_type *pCh;
+    uint8_t tail;
+
+    //Check inputs
+    pCh = captureGetCh(p);
+    if((pCh == NULL) || (pSmp == NULL) || (pIsValid == NULL)){
+        return drvBadParameter;
+    }
+    //Buffer is written by ISR only at head, so tail slot is safe to copy
+    tail = pCh->tail;
+    if(tail == pCh->head){
+        *pIsValid = false;
+    }else{
+        *pSmp = pCh->buf[tail];
+        pCh->tail = (tail + 1) & CAPTURE_BUF_MASK;
+        *pIsValid = true;
+    }
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Get number of samples dropped because of full buffer
+* @param    *p - timer instance
+* @param    *pOverruns - pointer to store the counter to
+*/
+eDrvError capture_getOverruns(TCB_t *p, uint16_t *pOverruns){
+    eDrvError exitStatus = drvUnknownError;
+    captureCh_type *pCh;
+
+    //Check inputs
+    pCh = captureGetCh(p);
+    if((pCh == NULL) || (pOverruns == NULL)){
+        return drvBadParameter;
+    }
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        *pOverruns = pCh->overruns;
+    }
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Convert counter units to microseconds using precomputed multiplier
+* @param    *p - timer instance
+* @param    cnt - value in counter units
+* @param    *pUs - pointer to store the result to
+*/
+eDrvError capture_toUs(TCB_t *p, uint16_t cnt, uint32_t *pUs){
+    eDrvError exitStatus = drvUnknownError;
+    captureCh_type *pCh;
+
+    //Check inputs
+    pCh = captureGetCh(p);
+    if((pCh == NULL) || (pUs == NULL)){
+        return drvBadParameter;
+    }
+    *pUs = ((uint32_t)cnt * pCh->usMul) >> pCh->usShift;
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Convert period in counter units to frequency, no runtime division
+* @param    *p - timer instance
+* @param    cnt - period in counter units
+* @param    *pHz - pointer to store the result to (0 for zero period)
+*/
+eDrvError capture_toHz(TCB_t *p, uint16_t cnt, uint32_t *pHz){
+    eDrvError exitStatus = drvUnknownError;
+    captureCh_type *pCh;
+    uint32_t recip;
+    uint8_t norm;
+    int8_t shift;
+
+    //Check inputs
+    pCh = captureGetCh(p);
+    if((pCh == NULL) || (pHz == NULL)){
+        return drvBadParameter;
+    }
+    if(cnt == 0){
+        *pHz = 0;
+        return drvNoError;
+    }
+    //Hz = clk / cnt = hzMant * 2^hzExp * recip * 2^norm / 2^31
+    recip = captureRecip(cnt, &norm);
+    shift = 31 - norm - pCh->hzExp;
+    if(shift >= 0){
+        *pHz = (pCh->hzMant * recip) >> shift;
+    }else{
+        *pHz = (pCh->hzMant * recip) << -shift;
+    }
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Get channel state for timer instance
+* @param    *p - timer instance
+* @return   Pointer to channel or NULL if capture is disabled for the instance
+*/
+captureCh_type *captureGetCh(TCB_t *p){
+    (void)p;                                                                    //Both disabled on one-TCB parts
+#if (CAPTURE_TCB0_EN != 0)
+    if(p == &TCB0) return &captureCh0;
+#endif
+#if (CAPTURE_TCB1_EN != 0)
+    if(p == &TCB1) return &captureCh1;
+#endif
+    return NULL;
+}
+
+/*!****************************************************************************
+* @brief    Reciprocal of counter value by Newton-Raphson, multiplications only
+* @param    cnt - value to invert (non-zero)
+* @param    *pNorm - number of bits value was shifted left to normalize
+* @return   2^31 / (cnt << *pNorm), in range (2^15, 2^16]
+*/
+uint32_t captureRecip(uint16_t cnt, uint8_t *pNorm){
+    uint32_t y, t;
+    uint8_t norm, i;
+
+    //Normalize to [2^15, 2^16)
+    norm = 0;
+    while((cnt & 0x8000) == 0){
+        cnt <<= 1;
+        norm++;
+    }
+    //Linear estimate 2^15 * (48/17 - 32/17 * cnt / 2^16), error below 1/17
+    y = 92521UL - (((uint32_t)cnt * 61681UL) >> 16);
+    //Each iteration y = y * (2 - cnt * y / 2^31) doubles precision
+    for(i = 0; i < CAPTURE_RECIP_ITER; i++){
+        t = 0 - (uint32_t)cnt * y;
+        y = (y * (t >> 16)) >> 15;
+    }
+    *pNorm = norm;
+
+    return y;
+}
+
+/*!****************************************************************************
+* @brief    Store capture result to the ring buffer
+* @param    *p - timer instance
+* @param    *pCh - channel state
+*/
+void captureIsr(TCB_t *p, captureCh_type *pCh){
+    captureSmp_type smp;
+    uint8_t head, next;
+
+    //Reading CCMP clears CAPT flag and re-arms the capture
+    switch(pCh->mode){
+        case TCB_CNTMODE_FRQ_gc:
+            smp.period = p->CCMP;
+            smp.width = 0;
+            break;
+        case TCB_CNTMODE_PW_gc:
+            smp.period = 0;
+            smp.width = p->CCMP;
+            break;
+        default:
+            smp.period = p->CNT;
+            smp.width = p->CCMP;
+            break;
+    }
+    p->INTFLAGS = TCB_CAPT_bm;
+    head = pCh->head;
+    next = (head + 1) & CAPTURE_BUF_MASK;
+    if(next == pCh->tail){
+        pCh->overruns++;
+    }else{
+        pCh->buf[head] = smp;
+        pCh->head = next;
+    }
+}
+
+#if (CAPTURE_TCB0_EN != 0)
+/*!****************************************************************************
+* @brief    TCB0 capture interrupt
+*/
+ISR(TCB0_INT_vect){
+    traceScope(traceIdIsrCapture);
+    captureIsr(&TCB0, &captureCh0);
+}
+#endif
+
+#if (CAPTURE_TCB1_EN != 0)
+/*!****************************************************************************
+* @brief    TCB1 capture interrupt
+*/
+ISR(TCB1_INT_vect){
+    traceScope(traceIdIsrCapture);
+    captureIsr(&TCB1, &captureCh1);
+}
+#endif
+
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
@@ -0,0 +1,235 @@
+/*!****************************************************************************
+* @file    ccl.c
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Configurable custom logic (CCL) LUT driver
+*/
+
+/*!****************************************************************************
+* Include
+*/
+#include "ccl.h"
+#include "sleepctrl.h"
+#include <util/atomic.h>
+
+/*!****************************************************************************
+* Local define
+*/
+#define CCL_REG_CTRLA                           0
+#define CCL_REG_CTRLB                           1
+#define CCL_REG_CTRLC                           2
+#define CCL_REG_TRUTH                           3
+
+/*!****************************************************************************
+* Local function prototypes
+*/
+volatile uint8_t *cclLutReg(uint8_t lut);
+bool cclUnlock(void);
+void cclLock(bool isEnabled);
+eDrvError cclUpdateSleep(void);
+
+/*!****************************************************************************
+* @brief    Initialize CCL with all LUTs disabled
+* @param    runStdby - keep clocked logic (filter, edge detector, sequencer)
+*                      running in standby
+* @note     Output pins direction is set up by caller
+*/
+eDrvError ccl_init(bool runStdby){
+    eDrvError exitStatus = drvUnknownError;
+    volatile uint8_t *pReg;
+    uint8_t lut;
+
+    CCL.CTRLA = 0;
+    CCL.SEQCTRL0 = CCL_SEQSEL_DISABLE_gc;
+    for(lut = 0; lut < CCL_LUT_NUM; lut++){
+        pReg = cclLutReg(lut);
+        pReg[CCL_REG_CTRLA] = 0;
+        pReg[CCL_REG_CTRLB] = 0;
+        pReg[CCL_REG_CTRLC] = 0;
+        pReg[CCL_REG_TRUTH] = 0;
+    }
+    CCL.CTRLA = ((runStdby ? 1 : 0) << CCL_RUNSTDBY_bp) | (1 << CCL_ENABLE_bp);
+    exitStatus = cclUpdateSleep();
+
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Configure and enable LUT
+* @param    lut - LUT number
+* @param    *pLut - LUT configuration
+* @note     Configuration is enable-protected, CCL is stopped for a few cycles
+*           and outputs of other LUTs go low meanwhile
+*/
+eDrvError ccl_setLut(uint8_t lut, const cclLut_type *pLut){
+    eDrvError exitStatus = drvUnknownError;
+    volatile uint8_t *pReg;
+    bool isEnabled;
+    uint8_t i;
+
+    //Check inputs
+    if((lut >= CCL_LUT_NUM) || (pLut == NULL) || ((pLut->filter & ~CCL_FILTSEL_gm) != 0)){
+        return drvBadParameter;
+    }
+    for(i = 0; i < CCL_IN_NUM; i++){
+        if(pLut->in[i] > cclInSpi0){
+            return drvBadParameter;
+        }
+    }
+    //Edge detector works on filter output
+    if(pLut->edgeDet && (pLut->filter == CCL_FILTSEL_DISABLE_gc)){
+        return drvBadParameter;
+    }
+    pReg = cclLutReg(lut);
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        isEnabled = cclUnlock();
+        pReg[CCL_REG_CTRLA] = 0;
+        pReg[CCL_REG_CTRLB] = (pLut->in[1] << CCL_INSEL1_gp) | (pLut->in[0] << CCL_INSEL0_gp);
+        pReg[CCL_REG_CTRLC] = pLut->in[2] << CCL_INSEL2_gp;
+        pReg[CCL_REG_TRUTH] = pLut->truth;
+        pReg[CCL_REG_CTRLA] = ((pLut->edgeDet ? 1 : 0) << CCL_EDGEDET_bp) | ((pLut->clkIn2 ? 1 : 0) << CCL_CLKSRC_bp) |
+                              pLut->filter | ((pLut->outEn ? 1 : 0) << CCL_OUTEN_bp) | (1 << CCL_ENABLE_bp);
+        cclLock(isEnabled);
+    }
+    exitStatus = cclUpdateSleep();
+
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Change truth table of LUT
+* @param    lut - LUT number
+* @param    truth - output for input combination IN2:IN1:IN0
+*/
+eDrvError ccl_setTruth(uint8_t lut, uint8_t truth){
+    eDrvError exitStatus = drvUnknownError;
+    bool isEnabled;
+
+    //Check inputs
+    if(lut >= CCL_LUT_NUM){
+        return drvBadParameter;
+    }
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        isEnabled = cclUnlock();
+        cclLutReg(lut)[CCL_REG_TRUTH] = truth;
+        cclLock(isEnabled);
+    }
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Set sequencer fed by LUT0 and LUT1 outputs
+* @param    seq - CCL_SEQSEL_DISABLE_gc, DFF, JK, LATCH or RS
+* @note     Sequencer output replaces LUT0 output
+*/
+eDrvError ccl_setSeq(CCL_SEQSEL_t seq){
+    eDrvError exitStatus = drvUnknownError;
+    bool isEnabled;
+
+    //Check inputs
+    if((seq & ~CCL_SEQSEL_gm) != 0){
+        return drvBadParameter;
+    }
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        isEnabled = cclUnlock();
+        CCL.SEQCTRL0 = seq;
+        cclLock(isEnabled);
+    }
+    exitStatus = cclUpdateSleep();
+
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Enable or disable LUT keeping its configuration
+* @param    lut - LUT number
+* @param    isEnabled - LUT state
+*/
+eDrvError ccl_enableLut(uint8_t lut, bool isEnabled){
+    eDrvError exitStatus = drvUnknownError;
+    volatile uint8_t *pReg;
+    bool isCclEnabled;
+
+    //Check inputs
+    if(lut >= CCL_LUT_NUM){
+        return drvBadParameter;
+    }
+    pReg = cclLutReg(lut);
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        isCclEnabled = cclUnlock();
+        if(isEnabled){
+            pReg[CCL_REG_CTRLA] |= CCL_ENABLE_bm;
+        }else{
+            pReg[CCL_REG_CTRLA] &= ~CCL_ENABLE_bm;
+        }
+        cclLock(isCclEnabled);
+    }
+    exitStatus = cclUpdateSleep();
+
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Registers of LUT
+* @param    lut - LUT number
+*/
+volatile uint8_t *cclLutReg(uint8_t lut){
+    return &(&CCL.LUT0CTRLA)[lut * CCL_LUT_REG_NUM];
+}
+
+/*!****************************************************************************
+* @brief    Stop CCL to make configuration writable
+* @return   true if CCL was enabled
+*/
+bool cclUnlock(void){
+    bool isEnabled;
+
+    isEnabled = (CCL.CTRLA & CCL_ENABLE_bm) ? true : false;
+    CCL.CTRLA &= ~CCL_ENABLE_bm;
+
+    return isEnabled;
+}
+
+/*!****************************************************************************
+* @brief    Restart CCL after configuration change
+* @param    isEnabled - state before cclUnlock()
+*/
+void cclLock(bool isEnabled){
+    if(isEnabled){
+        CCL.CTRLA |= CCL_ENABLE_bm;
+    }
+}
+
+/*!****************************************************************************
+* @brief    Limit sleep while clocked logic is in use
+* @note     Combinational LUTs work without clock in any sleep mode
+*/
+eDrvError cclUpdateSleep(void){
+    volatile uint8_t *pReg;
+    bool isClocked;
+    uint8_t lut, seq;
+
+    isClocked = false;
+    seq = CCL.SEQCTRL0 & CCL_SEQSEL_gm;
+    for(lut = 0; lut < CCL_LUT_NUM; lut++){
+        pReg = cclLutReg(lut);
+        if((pReg[CCL_REG_CTRLA] & CCL_ENABLE_bm) == 0){
+            continue;
+        }
+        //Filter, edge detector and flip-flops run on the LUT clock
+        if((pReg[CCL_REG_CTRLA] & (CCL_FILTSEL_gm | CCL_EDGEDET_bm)) ||
+           (seq == CCL_SEQSEL_DFF_gc) || (seq == CCL_SEQSEL_JK_gc)){
+            isClocked = true;
+        }
+    }
+    if(!isClocked || ((CCL.CTRLA & CCL_ENABLE_bm) == 0)){
+        return sleepctrl_clearLimit(sleepUserCcl);
+    }
+
+    return sleepctrl_setLimit(sleepUserCcl, (CCL.CTRLA & CCL_RUNSTDBY_bm) ? SLPCTRL_SMODE_STDBY_gc : SLPCTRL_SMODE_IDLE_gc);
+}
+
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
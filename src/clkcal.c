@@ -0,0 +1,201 @@
+/*!****************************************************************************
+* @file    clkcal.c
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   OSC20M run-time calibration against a 32.768 kHz reference
+*/
+
+/*!****************************************************************************
+* Include
+*/
+#include "clkcal.h"
+
+/*!****************************************************************************
+* Local function prototypes
+*/
+void clkcalRestart(void);
+eDrvError clkcalRetime(eClockEv ev, uint32_t hzOld, uint32_t hzNew);
+
+/*!****************************************************************************
+* MEMORY
+*/
+TCB_t *clkCalTcb;                                                               //Capture timer, NULL if stopped
+uint16_t clkCalRefHz;                                                           //Reference event frequency
+uint32_t clkCalSum;                                                             //CLK_PER cycles of accumulated periods
+uint32_t clkCalHz;                                                              //Last measured CLK_PER, 0 if none
+uint8_t clkCalSmpCnt;                                                           //Accumulated periods
+uint8_t clkCalSkip;                                                             //Periods to drop
+bool clkCalIsSettled;
+
+/*!****************************************************************************
+* @brief    Start measuring system clock against reference events
+* @param    *p - capture timer (its capture ISR has to be enabled)
+* @param    evCh - asynchronous event channel number (0..3)
+* @param    evGen - reference generator, e.g. RTC PIT output on the channel
+* @param    refHz - reference event frequency, CLK_PER / refHz must fit 16 bits
+* @note     Reference comes from the 32.768 kHz crystal (clock_initXosc32k()) or
+*           OSCULP32K selected as RTC clock. Run clkcal_run() in background
+*/
+eDrvError clkcal_start(TCB_t *p, uint8_t evCh, uint8_t evGen, uint16_t refHz){
+    eDrvError exitStatus = drvUnknownError;
+    uint32_t hz;
+
+    //Check inputs
+    if((p == NULL) || (refHz == 0)){
+        return drvBadParameter;
+    }
+    if(clock_getHz(&hz) != drvNoError){
+        return drvHwError;
+    }
+    if((hz / refHz) > UINT16_MAX){
+        return drvBadParameter;
+    }
+    //Period capture at CLK_PER, counts are system clock cycles
+    exitStatus = capture_init(p, TCB_CNTMODE_FRQ_gc, TCB_CLKSEL_CLKDIV1_gc, hz, evCh, evGen, false, false);
+    if(exitStatus != drvNoError) return exitStatus;
+    if(clock_register(clkcalRetime) != drvNoError) return drvHwError;
+    clkCalTcb = p;
+    clkCalRefHz = refHz;
+    clkCalHz = 0;
+    clkcalRestart();
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Stop measurement, trim and published frequency are kept
+*/
+eDrvError clkcal_stop(void){
+    eDrvError exitStatus = drvUnknownError;
+
+    //Check state
+    if(clkCalTcb == NULL){
+        return drvHwError;
+    }
+    clock_unregister(clkcalRetime);
+    exitStatus = capture_stop(clkCalTcb);
+    clkCalTcb = NULL;
+
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Background calibration step, to be called more often than the
+*           capture buffer fills up
+* @param    *pIsSettled - true when the clock is within the dead band
+* @note     Every CLKCAL_SMP_NUM periods the clock is measured. OSC20M is
+*           trimmed by one OSC20MCALIBA step while the error is beyond the dead
+*           band, otherwise the measured frequency is published to the drivers.
+*           Other clock sources and a locked calibration are only measured
+*/
+eDrvError clkcal_run(bool *pIsSettled){
+    eDrvError exitStatus = drvUnknownError;
+    captureSmp_type smp;
+    uint32_t hz, hzNom, thr;
+    bool isValid, isTrim;
+    uint8_t cal;
+
+    //Check inputs
+    if(pIsSettled == NULL){
+        return drvBadParameter;
+    }
+    if(clkCalTcb == NULL){
+        return drvHwError;
+    }
+    //Accumulate periods
+    for(;;){
+        if(capture_get(clkCalTcb, &smp, &isValid) != drvNoError) return drvHwError;
+        if(!isValid){
+            *pIsSettled = clkCalIsSettled;
+            return drvNoError;
+        }
+        if(clkCalSkip != 0){
+            clkCalSkip--;
+            continue;
+        }
+        clkCalSum += smp.period;
+        if(++clkCalSmpCnt == CLKCAL_SMP_NUM){
+            break;
+        }
+    }
+    hz = ((uint64_t)clkCalSum * clkCalRefHz) / CLKCAL_SMP_NUM;
+    clkCalHz = hz;
+    clkcalRestart();
+    if(clock_getNomHz(&hzNom) != drvNoError){
+        return drvHwError;
+    }
+    //Trim OSC20M towards nominal, higher CAL20M is faster
+    isTrim = ((CLKCTRL.MCLKCTRLA & CLKCTRL_CLKSEL_gm) == CLKCTRL_CLKSEL_OSC20M_gc) && !(CLKCTRL.OSC20MCALIBB & CLKCTRL_LOCK_bm);
+    thr = (hzNom / 1000) * CLKCAL_DEADBAND_PPM / 1000;
+    cal = CLKCTRL.OSC20MCALIBA & CLKCTRL_CAL20M_gm;
+    if(isTrim && (hz > hzNom + thr) && (cal > 0)){
+        cal--;
+    }else if(isTrim && (hz + thr < hzNom) && (cal < CLKCTRL_CAL20M_gm)){
+        cal++;
+    }else{
+        isTrim = false;
+    }
+    if(isTrim){
+        _PROTECTED_WRITE(CLKCTRL.OSC20MCALIBA, (CLKCTRL.OSC20MCALIBA & ~CLKCTRL_CAL20M_gm) | cal);
+        clkCalIsSettled = false;
+        exitStatus = drvNoError;
+    }else{
+        //Clock won't get closer, drivers take the measured one
+        exitStatus = clock_setMeasHz(hz);
+        clkCalIsSettled = true;
+    }
+    *pIsSettled = clkCalIsSettled;
+
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Get last measured system clock frequency
+* @param    *pHz - pointer to store frequency to, Hz
+* @return   drvHwError if there was no measurement yet
+*/
+eDrvError clkcal_getHz(uint32_t *pHz){
+    eDrvError exitStatus = drvUnknownError;
+
+    //Check inputs
+    if(pHz == NULL){
+        return drvBadParameter;
+    }
+    if(clkCalHz == 0){
+        return drvHwError;
+    }
+    *pHz = clkCalHz;
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Start new measurement, dropping periods which may be disturbed
+*/
+void clkcalRestart(void){
+    clkCalSum = 0;
+    clkCalSmpCnt = 0;
+    clkCalSkip = CLKCAL_SKIP_NUM;
+}
+
+/*!****************************************************************************
+* @brief    Restart measurement on clock change
+* @param    ev - before or after the switch
+* @param    hzOld - clock before the switch
+* @param    hzNew - clock after the switch
+*/
+eDrvError clkcalRetime(eClockEv ev, uint32_t hzOld, uint32_t hzNew){
+    (void)hzOld;
+    (void)hzNew;
+    if(ev == clockEvPost){
+        clkcalRestart();
+        clkCalIsSettled = false;
+    }
+
+    return drvNoError;
+}
+
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
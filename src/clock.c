@@ -10,51 +10,359 @@
 * Include
 */
 #include "clock.h"
+#include <util/atomic.h>
+
+/*!****************************************************************************
+* Local function prototypes
+*/
+uint32_t clockCalcHz(CLKCTRL_CLKSEL_t clkSrc, CLKCTRL_PDIV_t pDiv, bool prscEn);
+eDrvError clockNotify(eClockEv ev, uint32_t hzOld, uint32_t hzNew);
+
+/*!****************************************************************************
+* MEMORY
+*/
+const uint8_t clockPdivDiv[] = {2, 4, 8, 16, 32, 64, 0, 0, 6, 10, 12, 24, 48, 0, 0, 0};   //Prescaler by PDIV, 0 - reserved
+uint32_t clockHz;                                                               //Current CLK_PER (measured if published), 0 until first read
+clockCb_type clockCb[CLOCK_CB_NUM];                                             //Drivers to re-time
 
 /*!****************************************************************************
 * @brief    System clock settings initializer
+* @note     Boot setup. Drivers already registered (e.g. time base started by
+*           boot_init()) are re-timed. Use clock_set() to change clock afterwards
 */
 eDrvError clock_init(CLKCTRL_CLKSEL_t clkSrc, CLKCTRL_PDIV_t pDiv, bool prscEn, bool runStby20M, bool runStby32K){
     eDrvError exitStatus = drvUnknownError;
+    uint32_t hzOld, hzNew;
     uint8_t temp;
     
-    temp = 0;
-    temp &= ~CLKCTRL_CLKOUT_bm;                                                 //Disable CLKOUT
-    temp &= ~CLKCTRL_CLKSEL_gm;
-    temp |= clkSrc;
-    _PROTECTED_WRITE(CLKCTRL.MCLKCTRLA, temp);
+    hzNew = clockCalcHz(clkSrc, pDiv, prscEn);
+    if((hzNew == 0) || (clock_getHz(&hzOld) != drvNoError)){
+        return drvBadParameter;
+    }
+    exitStatus = drvNoError;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        if(clockNotify(clockEvPre, hzOld, hzNew) != drvNoError) exitStatus = drvHwError;
+        
+        temp = 0;
+        temp &= ~CLKCTRL_CLKOUT_bm;                                             //Disable CLKOUT
+        temp &= ~CLKCTRL_CLKSEL_gm;
+        temp |= clkSrc;
+        _PROTECTED_WRITE(CLKCTRL.MCLKCTRLA, temp);
+        
+        temp = 0;
+        temp &= ~CLKCTRL_PDIV_gm;
+        temp |= pDiv & CLKCTRL_PDIV_gm;
+        if(prscEn){
+            temp |= CLKCTRL_PEN_bm;
+        }else{
+            temp &= ~CLKCTRL_PEN_bm;
+        }
+        _PROTECTED_WRITE(CLKCTRL.MCLKCTRLB, temp);                              //Divisor and enable in one write
+        
+        temp = 0;
+        if(runStby20M){
+            temp |= 1 << CLKCTRL_RUNSTDBY_bp;
+        }else{
+            temp &= ~CLKCTRL_RUNSTDBY_bm;
+        }
+        _PROTECTED_WRITE(CLKCTRL.OSC20MCTRLA, temp);
+        
+        temp = 0;
+        if(runStby32K){
+            temp |= 1 << CLKCTRL_RUNSTDBY_bp;
+        }else{
+            temp &= ~CLKCTRL_RUNSTDBY_bm;
+        }
+        _PROTECTED_WRITE(CLKCTRL.OSC32KCTRLA, temp);
+        
+        clockHz = hzNew;
+        if(clockNotify(clockEvPost, hzOld, hzNew) != drvNoError) exitStatus = drvHwError;
+    }
     
-    temp = 0;
-    temp &= ~CLKCTRL_PDIV_gm;
-    temp |= pDiv;
-    _PROTECTED_WRITE(CLKCTRL.MCLKCTRLB, temp);
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Start external 32.768 kHz crystal oscillator and wait until it is stable
+* @param    startUp - start-up time in oscillator cycles
+* @param    extClk - external clock on TOSC1 instead of crystal
+* @param    runStby - keep oscillator running in all modes, even if not requested
+* @note     Oscillator is forced on for the wait. Without runStby it stops
+*           until a peripheral (e.g. RTC) requests it, then starts up again
+*/
+eDrvError clock_initXosc32k(CLKCTRL_CSUT_t startUp, bool extClk, bool runStby){
+    eDrvError exitStatus = drvUnknownError;
+    timeout_type to;
+    uint8_t temp;
+    
+    //SEL and CSUT can be changed only while oscillator is disabled
+    temp = CLKCTRL.XOSC32KCTRLA & ~CLKCTRL_ENABLE_bm;
+    _PROTECTED_WRITE(CLKCTRL.XOSC32KCTRLA, temp);
+    temp &= ~(CLKCTRL_CSUT_gm | CLKCTRL_SEL_bm);
+    temp |= startUp;
+    if(extClk){
+        temp |= CLKCTRL_SEL_bm;
+    }
+    _PROTECTED_WRITE(CLKCTRL.XOSC32KCTRLA, temp);
+    //Force it on and wait for stable clock
+    temp |= CLKCTRL_ENABLE_bm | CLKCTRL_RUNSTDBY_bm;
+    _PROTECTED_WRITE(CLKCTRL.XOSC32KCTRLA, temp);
+    if(timeout_start(&to, CLOCK_XOSC32K_TIMEOUT_US) != drvNoError) return drvHwError;
+    while((CLKCTRL.MCLKSTATUS & CLKCTRL_XOSC32KS_bm) == 0){
+        if(timeout_check(&to, timeoutSiteXosc32k) != drvNoError) return drvHwError;
+    }
+    if(!runStby){
+        temp &= ~CLKCTRL_RUNSTDBY_bm;
+        _PROTECTED_WRITE(CLKCTRL.XOSC32KCTRLA, temp);
+    }
     
-    temp = 0;
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Switch system clock at runtime and re-time registered drivers
+* @param    clkSrc - main clock source
+* @param    pDiv - main clock prescaler divisor
+* @param    prscEn - prescaler enable
+* @return   drvHwError if the new source did not start in time (the switch stays
+*           pending in hardware) or a driver could not re-time to the new clock
+* @note     Runs with interrupts disabled. Drivers are notified before and after
+*           the switch, transfers in progress should be finished by the caller.
+*           Not to be called from software timer callbacks
+*/
+eDrvError clock_set(CLKCTRL_CLKSEL_t clkSrc, CLKCTRL_PDIV_t pDiv, bool prscEn){
+    eDrvError exitStatus = drvUnknownError;
+    uint32_t hzOld, hzNew;
+    uint16_t polls;
+    uint8_t temp;
+    
+    //Check inputs
+    hzNew = clockCalcHz(clkSrc, pDiv, prscEn);
+    if(hzNew == 0){
+        return drvBadParameter;
+    }
+    //Crystal is started by clock_initXosc32k(), switching to a stopped one stalls
+    if((clkSrc == CLKCTRL_CLKSEL_XOSC32K_gc) && !(CLKCTRL.MCLKSTATUS & CLKCTRL_XOSC32KS_bm)){
+        return drvHwError;
+    }
+    if(clock_getHz(&hzOld) != drvNoError){
+        return drvHwError;
+    }
+    temp = pDiv & CLKCTRL_PDIV_gm;
     if(prscEn){
         temp |= CLKCTRL_PEN_bm;
-    }else{
-        temp &= ~CLKCTRL_PEN_bm;
     }
-    _PROTECTED_WRITE(CLKCTRL.MCLKCTRLB, temp);
+    exitStatus = drvNoError;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        if(clockNotify(clockEvPre, hzOld, hzNew) != drvNoError) exitStatus = drvHwError;
+        if((CLKCTRL.MCLKCTRLA & CLKCTRL_CLKSEL_gm) != clkSrc){
+            //Slowest prescaler in between, so neither old nor new setting is exceeded
+            _PROTECTED_WRITE(CLKCTRL.MCLKCTRLB, CLKCTRL_PDIV_64X_gc | CLKCTRL_PEN_bm);
+            _PROTECTED_WRITE(CLKCTRL.MCLKCTRLA, (CLKCTRL.MCLKCTRLA & ~CLKCTRL_CLKSEL_gm) | clkSrc);
+            //Time base is frozen by its own pre-change callback, count polls instead
+            for(polls = 0; (CLKCTRL.MCLKSTATUS & CLKCTRL_SOSC_bm) && (polls < CLOCK_SWITCH_POLLS); polls++);
+            if(CLKCTRL.MCLKSTATUS & CLKCTRL_SOSC_bm) exitStatus = drvHwError;
+        }
+        _PROTECTED_WRITE(CLKCTRL.MCLKCTRLB, temp);
+        clockHz = hzNew;
+        if(clockNotify(clockEvPost, hzOld, hzNew) != drvNoError) exitStatus = drvHwError;
+    }
     
-    temp = 0;
-    if(runStby20M){
-        temp |= 1 << CLKCTRL_RUNSTDBY_bp;
-    }else{
-        temp &= ~CLKCTRL_RUNSTDBY_bm;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Get current system (peripheral) clock frequency
+* @param    *pHz - pointer to store frequency to, Hz
+* @note     Derived from clock registers until clock_init() or clock_set() is run.
+*           Measured frequency once published by clock_setMeasHz()
+*/
+eDrvError clock_getHz(uint32_t *pHz){
+    eDrvError exitStatus = drvUnknownError;
+    
+    //Check inputs
+    if(pHz == NULL){
+        return drvBadParameter;
+    }
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        if(clockHz == 0){
+            clockHz = clockCalcHz(CLKCTRL.MCLKCTRLA & CLKCTRL_CLKSEL_gm, CLKCTRL.MCLKCTRLB & CLKCTRL_PDIV_gm, (CLKCTRL.MCLKCTRLB & CLKCTRL_PEN_bm) != 0);
+        }
+        *pHz = clockHz;
+    }
+    if(*pHz == 0){
+        return drvHwError;
     }
-    _PROTECTED_WRITE(CLKCTRL.OSC20MCTRLA, temp);
     
-    temp = 0;
-    if(runStby32K){
-        temp |= 1 << CLKCTRL_RUNSTDBY_bp;
-    }else{
-        temp &= ~CLKCTRL_RUNSTDBY_bm;
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Get nominal system clock frequency of current clock settings
+* @param    *pHz - pointer to store frequency to, Hz
+*/
+eDrvError clock_getNomHz(uint32_t *pHz){
+    eDrvError exitStatus = drvUnknownError;
+    
+    //Check inputs
+    if(pHz == NULL){
+        return drvBadParameter;
+    }
+    *pHz = clockCalcHz(CLKCTRL.MCLKCTRLA & CLKCTRL_CLKSEL_gm, CLKCTRL.MCLKCTRLB & CLKCTRL_PDIV_gm, (CLKCTRL.MCLKCTRLB & CLKCTRL_PEN_bm) != 0);
+    if(*pHz == 0){
+        return drvHwError;
     }
-    _PROTECTED_WRITE(CLKCTRL.OSC32KCTRLA, temp);
     
     exitStatus = drvNoError;
     return exitStatus;
 }
 
+/*!****************************************************************************
+* @brief    Publish measured system clock frequency
+* @param    hz - measured CLK_PER frequency
+* @return   drvHwError if a driver could not re-time to the measured clock
+* @note     Drivers are re-timed only if it deviates from the current frequency
+*           by more than CLOCK_RETIME_PPM
+*/
+eDrvError clock_setMeasHz(uint32_t hz){
+    eDrvError exitStatus = drvUnknownError;
+    uint32_t hzOld, diff;
+    
+    //Check inputs
+    if(hz == 0){
+        return drvBadParameter;
+    }
+    if(clock_getHz(&hzOld) != drvNoError){
+        return drvHwError;
+    }
+    diff = (hz > hzOld) ? (hz - hzOld) : (hzOld - hz);
+    if(diff <= (hzOld / 1000) * CLOCK_RETIME_PPM / 1000){
+        return drvNoError;
+    }
+    exitStatus = drvNoError;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        if(clockNotify(clockEvPre, hzOld, hz) != drvNoError) exitStatus = drvHwError;
+        clockHz = hz;
+        if(clockNotify(clockEvPost, hzOld, hz) != drvNoError) exitStatus = drvHwError;
+    }
+    
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Register driver to be notified on clock change
+* @param    cb - re-timing callback, called with interrupts disabled
+* @note     Safe to call repeatedly, a callback is registered only once
+*/
+eDrvError clock_register(clockCb_type cb){
+    eDrvError exitStatus = drvUnknownError;
+    uint8_t i, free;
+    
+    //Check inputs
+    if(cb == NULL){
+        return drvBadParameter;
+    }
+    exitStatus = drvHwError;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        free = CLOCK_CB_NUM;
+        for(i = 0; i < CLOCK_CB_NUM; i++){
+            if(clockCb[i] == cb){
+                free = i;
+                break;
+            }
+            if((clockCb[i] == NULL) && (free == CLOCK_CB_NUM)){
+                free = i;
+            }
+        }
+        if(free < CLOCK_CB_NUM){
+            clockCb[free] = cb;
+            exitStatus = drvNoError;
+        }
+    }
+    
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Stop notifying driver on clock change
+* @param    cb - callback to remove
+*/
+eDrvError clock_unregister(clockCb_type cb){
+    eDrvError exitStatus = drvUnknownError;
+    uint8_t i;
+    
+    //Check inputs
+    if(cb == NULL){
+        return drvBadParameter;
+    }
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        for(i = 0; i < CLOCK_CB_NUM; i++){
+            if(clockCb[i] == cb){
+                clockCb[i] = NULL;
+            }
+        }
+    }
+    
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Peripheral clock frequency of clock setting
+* @param    clkSrc - main clock source
+* @param    pDiv - main clock prescaler divisor
+* @param    prscEn - prescaler enable
+* @return   Frequency in Hz, 0 if setting is invalid
+*/
+uint32_t clockCalcHz(CLKCTRL_CLKSEL_t clkSrc, CLKCTRL_PDIV_t pDiv, bool prscEn){
+    uint32_t hz;
+    
+    switch(clkSrc){
+        case CLKCTRL_CLKSEL_OSC20M_gc:
+            hz = ((FUSE.OSCCFG & FUSE_FREQSEL_gm) == FREQSEL_16MHZ_gc) ? CLOCK_OSC20M_16M_HZ : CLOCK_OSC20M_20M_HZ;
+            break;
+        case CLKCTRL_CLKSEL_OSCULP32K_gc:
+            hz = CLOCK_OSC32K_HZ;
+            break;
+        case CLKCTRL_CLKSEL_XOSC32K_gc:
+            hz = CLOCK_XOSC32K_HZ;
+            break;
+        case CLKCTRL_CLKSEL_EXTCLK_gc:
+            hz = CLOCK_EXTCLK_HZ;
+            break;
+        default:
+            return 0;
+    }
+    if(prscEn){
+        if((pDiv & ~CLKCTRL_PDIV_gm) || (clockPdivDiv[pDiv >> CLKCTRL_PDIV_gp] == 0)){
+            return 0;
+        }
+        hz /= clockPdivDiv[pDiv >> CLKCTRL_PDIV_gp];
+    }
+    
+    return hz;
+}
+
+/*!****************************************************************************
+* @brief    Call registered drivers
+* @param    ev - before or after the switch
+* @param    hzOld - clock before the switch
+* @param    hzNew - clock after the switch
+* @return   drvHwError if any driver failed, all drivers are called regardless
+*/
+eDrvError clockNotify(eClockEv ev, uint32_t hzOld, uint32_t hzNew){
+    eDrvError exitStatus = drvNoError;
+    uint8_t i;
+    
+    for(i = 0; i < CLOCK_CB_NUM; i++){
+        if((clockCb[i] != NULL) && (clockCb[i](ev, hzOld, hzNew) != drvNoError)){
+            exitStatus = drvHwError;
+        }
+    }
+    
+    return exitStatus;
+}
+
 /***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
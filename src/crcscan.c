@@ -0,0 +1,83 @@
+/*!****************************************************************************
+* @file    crcscan.c
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Flash integrity check with CRCSCAN peripheral
+*/
+
+/*!****************************************************************************
+* Include
+*/
+#include "crcscan.h"
+
+/*!****************************************************************************
+* @brief    Check CRC of flash section
+* @param    src - CRCSCAN_SRC_FLASH_gc, APPLICATION_gc or BOOT_gc
+* @param    *pIsOk - pointer to store the result to
+* @note     Checksum (CRC16-CCITT) must be stored in the last two bytes of the
+*           section by the build. Only priority mode exists on this family: the
+*           CPU is stalled while the section is read, about one cycle per byte.
+*           Run it at boot (bootStageDeferred) or from the idle loop
+*/
+eDrvError crcscan_run(CRCSCAN_SRC_t src, bool *pIsOk){
+    eDrvError exitStatus = drvUnknownError;
+    uint16_t polls;
+
+    //Check inputs
+    if(((src & ~CRCSCAN_SRC_gm) != 0) || (pIsOk == NULL)){
+        return drvBadParameter;
+    }
+    //Configuration is locked while enabled, NMI enable can't be undone
+    if(CRCSCAN.CTRLA & (CRCSCAN_ENABLE_bm | CRCSCAN_NMIEN_bm)){
+        return drvHwError;
+    }
+    CRCSCAN.CTRLB = CRCSCAN_MODE_PRIORITY_gc | src;
+    CRCSCAN.CTRLA = 1 << CRCSCAN_ENABLE_bp;
+    for(polls = 0; CRCSCAN.STATUS & CRCSCAN_BUSY_bm; polls++){
+        if(polls == CRCSCAN_POLLS_MAX) return drvHwError;
+    }
+    *pIsOk = (CRCSCAN.STATUS & CRCSCAN_OK_bm) ? true : false;
+    CRCSCAN.CTRLA = 1 << CRCSCAN_RESET_bp;
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Check CRC of the whole flash, for use as boot item initializer
+* @return   drvHwError if the image is corrupted
+*/
+eDrvError crcscan_checkFlash(void){
+    eDrvError exitStatus = drvUnknownError;
+    bool isOk;
+
+    exitStatus = crcscan_run(CRCSCAN_SRC_FLASH_gc, &isOk);
+    if(exitStatus != drvNoError) return exitStatus;
+
+    return isOk ? drvNoError : drvHwError;
+}
+
+/*!****************************************************************************
+* @brief    Scan section and raise non-maskable interrupt on mismatch
+* @param    src - CRCSCAN_SRC_FLASH_gc, APPLICATION_gc or BOOT_gc
+* @note     Stays enabled until reset, CRCSCAN_NMI_vect handles the failure
+*/
+eDrvError crcscan_enableNmi(CRCSCAN_SRC_t src){
+    eDrvError exitStatus = drvUnknownError;
+
+    //Check inputs
+    if((src & ~CRCSCAN_SRC_gm) != 0){
+        return drvBadParameter;
+    }
+    if(CRCSCAN.CTRLA & (CRCSCAN_ENABLE_bm | CRCSCAN_NMIEN_bm)){
+        return drvHwError;
+    }
+    CRCSCAN.CTRLB = CRCSCAN_MODE_PRIORITY_gc | src;
+    CRCSCAN.CTRLA = (1 << CRCSCAN_NMIEN_bp) | (1 << CRCSCAN_ENABLE_bp);
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
@@ -0,0 +1,171 @@
+/*!****************************************************************************
+* @file    dac.c
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   8-bit DAC driver (DAC0 output, DAC1/DAC2 comparator references)
+*/
+
+/*!****************************************************************************
+* Include
+*/
+#include "dac.h"
+#include "sleepctrl.h"
+
+/*!****************************************************************************
+* Local function prototypes
+*/
+DAC_t *dacGetInst(uint8_t dacNum);
+eDrvError dacUpdateSleep(void);
+
+/*!****************************************************************************
+* MEMORY
+*/
+uint16_t dacRefMv[DAC_NUM];                                                     //Reference of enabled DAC, 0 if disabled
+
+/*!****************************************************************************
+* @brief    Initialize and enable DAC
+* @param    dacNum - DAC number, DACn is the DAC input of ACn
+* @param    ref - reference voltage, shared with ACn VREF input
+* @param    outEn - drive DAC0 OUT pin (DAC0 only)
+* @param    runStdby - keep running in standby
+*/
+eDrvError dac_init(uint8_t dacNum, eVrefSel ref, bool outEn, bool runStdby){
+    eDrvError exitStatus = drvUnknownError;
+    DAC_t *p;
+
+    //Check inputs
+    p = dacGetInst(dacNum);
+    if((p == NULL) || (outEn && (dacNum != 0))){
+        return drvBadParameter;
+    }
+    exitStatus = dac_stop(dacNum);
+    if(exitStatus != drvNoError) return exitStatus;
+    exitStatus = vref_request((eVrefUser)(vrefUserDac0 + dacNum), ref);
+    if(exitStatus != drvNoError) return exitStatus;
+    vref_getMv(ref, &dacRefMv[dacNum]);
+    exitStatus = vref_waitReady((eVrefUser)(vrefUserDac0 + dacNum));
+    if(exitStatus != drvNoError) return exitStatus;
+    p->DATA = 0;
+    p->CTRLA = ((runStdby ? 1 : 0) << DAC_RUNSTDBY_bp) | ((outEn ? 1 : 0) << DAC_OUTEN_bp) | (1 << DAC_ENABLE_bp);
+    exitStatus = dacUpdateSleep();
+
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Disable DAC and release its reference
+* @param    dacNum - DAC number
+*/
+eDrvError dac_stop(uint8_t dacNum){
+    eDrvError exitStatus = drvUnknownError;
+    DAC_t *p;
+
+    //Check inputs
+    p = dacGetInst(dacNum);
+    if(p == NULL){
+        return drvBadParameter;
+    }
+    p->CTRLA = 0;
+    if(dacRefMv[dacNum] != 0){
+        dacRefMv[dacNum] = 0;
+        if(vref_release((eVrefUser)(vrefUserDac0 + dacNum)) != drvNoError) return drvHwError;
+    }
+    exitStatus = dacUpdateSleep();
+
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Set DAC output code
+* @param    dacNum - DAC number
+* @param    data - output is data / 256 of the reference
+*/
+eDrvError dac_set(uint8_t dacNum, uint8_t data){
+    eDrvError exitStatus = drvUnknownError;
+    DAC_t *p;
+
+    //Check inputs
+    p = dacGetInst(dacNum);
+    if(p == NULL){
+        return drvBadParameter;
+    }
+    p->DATA = data;
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Set DAC output voltage
+* @param    dacNum - DAC number
+* @param    mv - voltage in millivolts, saturates at full scale
+*/
+eDrvError dac_setMv(uint8_t dacNum, uint16_t mv){
+    eDrvError exitStatus = drvUnknownError;
+    uint32_t data;
+
+    //Check inputs
+    if((dacGetInst(dacNum) == NULL) || (dacRefMv[dacNum] == 0)){
+        return drvBadParameter;
+    }
+    data = ((uint32_t)mv * DAC_STEPS + (dacRefMv[dacNum] >> 1)) / dacRefMv[dacNum];
+    if(data > UINT8_MAX){
+        data = UINT8_MAX;
+    }
+    exitStatus = dac_set(dacNum, (uint8_t)data);
+
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Get DAC instance
+* @param    dacNum - DAC number
+* @return   Pointer to instance or NULL if there is no such DAC
+*/
+DAC_t *dacGetInst(uint8_t dacNum){
+    switch(dacNum){
+        case 0:
+            return &DAC0;
+#if (DAC_NUM > 1)
+        case 1:
+            return &DAC1;
+#endif
+#if (DAC_NUM > 2)
+        case 2:
+            return &DAC2;
+#endif
+        default:
+            return NULL;
+    }
+}
+
+/*!****************************************************************************
+* @brief    Limit sleep while DACs are enabled
+*/
+eDrvError dacUpdateSleep(void){
+    SLPCTRL_SMODE_t mode;
+    bool isEnabled;
+    uint8_t i;
+    DAC_t *p;
+
+    isEnabled = false;
+    mode = SLPCTRL_SMODE_STDBY_gc;
+    for(i = 0; i < DAC_NUM; i++){
+        p = dacGetInst(i);
+        if((p->CTRLA & DAC_ENABLE_bm) == 0){
+            continue;
+        }
+        isEnabled = true;
+        if((p->CTRLA & DAC_RUNSTDBY_bm) == 0){
+            mode = SLPCTRL_SMODE_IDLE_gc;
+        }
+    }
+    if(!isEnabled){
+        return sleepctrl_clearLimit(sleepUserDac);
+    }
+
+    return sleepctrl_setLimit(sleepUserDac, mode);
+}
+
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
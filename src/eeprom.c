@@ -10,6 +10,7 @@
 * Include
 */
 #include "eeprom.h"
+#include "trace.h"
 
 /*!****************************************************************************
 * @brief    Erase EEPROM particular page
@@ -18,6 +19,7 @@
 */
 eDrvError eeprom_erasePage(uint8_t *pAddr){
     eDrvError exitStatus = drvUnknownError;
+    timeout_type to;
     
     //Perform checks
     if(pAddr == NULL){
@@ -30,10 +32,14 @@ eDrvError eeprom_erasePage(uint8_t *pAddr){
     *pAddr = EMPTY_BYTE;
     _PROTECTED_WRITE_SPM(NVMCTRL.CTRLA, NVMCTRL_CMD_PAGEERASE_gc);
     //Check flags
+    if(timeout_start(&to, EEPROM_TIMEOUT_US) != drvNoError) return drvHwError;
     while(NVMCTRL.STATUS & NVMCTRL_EEBUSY_bm){
         if(NVMCTRL.STATUS & NVMCTRL_WRERROR_bm){
             return drvHwError;
         }
+        if(timeout_check(&to, timeoutSiteEepromErasePage) != drvNoError){
+            return drvHwError;
+        }
     }
     
     exitStatus = drvNoError;
@@ -47,6 +53,7 @@ eDrvError eeprom_erasePage(uint8_t *pAddr){
 */
 eDrvError eeprom_erase(void){
     eDrvError exitStatus = drvUnknownError;
+    timeout_type to;
     
     //Perform check
     if(NVMCTRL.STATUS & NVMCTRL_EEBUSY_bm){
@@ -55,10 +62,14 @@ eDrvError eeprom_erase(void){
     //Perform EEPROM erase
     _PROTECTED_WRITE_SPM(NVMCTRL.CTRLA, NVMCTRL_CMD_EEERASE_gc);
     //Check flags
+    if(timeout_start(&to, EEPROM_TIMEOUT_US) != drvNoError) return drvHwError;
     while(NVMCTRL.STATUS & NVMCTRL_EEBUSY_bm){
         if(NVMCTRL.STATUS & NVMCTRL_WRERROR_bm){
             return drvHwError;
         }
+        if(timeout_check(&to, timeoutSiteEepromErase) != drvNoError){
+            return drvHwError;
+        }
     }
     
     exitStatus = drvNoError;
@@ -105,6 +116,8 @@ eDrvError eeprom_read(uint8_t *pAddr, uint8_t *pData, uint8_t num){
 */
 eDrvError eeprom_write(uint8_t *pAddr, uint8_t *pData, uint8_t num){
     eDrvError exitStatus = drvUnknownError;
+    timeout_type to;
+    traceScope(traceIdEepromWrite);
     
     //Check pointers and EEPROM status
     if((pAddr == NULL) || (pData == NULL)){
@@ -120,10 +133,14 @@ eDrvError eeprom_write(uint8_t *pAddr, uint8_t *pData, uint8_t num){
         if((((uint16_t)pAddr % EEPROM_PAGE_SIZE) == 0) || (num == 0)){
             _PROTECTED_WRITE_SPM(NVMCTRL.CTRLA, NVMCTRL_CMD_PAGEERASEWRITE_gc);
             //Check flags
+            if(timeout_start(&to, EEPROM_TIMEOUT_US) != drvNoError) return drvHwError;
             while(NVMCTRL.STATUS & NVMCTRL_EEBUSY_bm){
                 if(NVMCTRL.STATUS & NVMCTRL_WRERROR_bm){
                     return drvHwError;
                 }
+                if(timeout_check(&to, timeoutSiteEepromWrite) != drvNoError){
+                    return drvHwError;
+                }
             }
             //Writing data is done
             if(num == 0){
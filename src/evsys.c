@@ -0,0 +1,255 @@
+/*!****************************************************************************
+* @file    evsys.c
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Event system (EVSYS) routing
+*/
+
+/*!****************************************************************************
+* Include
+*/
+#include "evsys.h"
+#include <util/atomic.h>
+
+/*!****************************************************************************
+* Local define
+*/
+#define EVSYS_USER_NONE                         0                               //User not connected, zero-initialized
+#define EVSYS_X_CH_INIT(name, ch, gen)          if(evsysSetGen(ch, gen) != drvNoError) return drvBadParameter; evsysChFixed |= 1 << (ch);
+#define EVSYS_X_USER_INIT(name, user)           if(evsysConnect(name, user) != drvNoError) return drvBadParameter; evsysUserFixed |= (uint16_t)1 << (user);
+
+/*!****************************************************************************
+* Local function prototypes
+*/
+eDrvError evsysSetGen(eEvsysCh ch, uint8_t gen);
+eDrvError evsysConnect(eEvsysCh ch, eEvsysUser user);
+void evsysRelease(eEvsysUser user);
+volatile uint8_t *evsysUserReg(eEvsysUser user);
+
+/*!****************************************************************************
+* MEMORY
+*/
+uint8_t evsysChGen[evsysChNum];                                                 //Generator on channel
+uint8_t evsysChUsers[evsysChNum];                                               //Users connected to channel
+uint8_t evsysUserCh[evsysUserNum];                                              //Channel + 1 of user, EVSYS_USER_NONE if off
+uint8_t evsysChFixed;                                                           //Channels allocated at build time
+uint16_t evsysUserFixed;                                                        //Users routed at build time
+
+/*!****************************************************************************
+* @brief    Disconnect all users and apply routes fixed at build time
+*/
+eDrvError evsys_init(void){
+    eDrvError exitStatus = drvUnknownError;
+    uint8_t i;
+
+    evsysChFixed = 0;
+    evsysUserFixed = 0;
+    for(i = 0; i < evsysUserNum; i++){
+        *evsysUserReg((eEvsysUser)i) = EVSYS_MUX_OFF;
+        evsysUserCh[i] = EVSYS_USER_NONE;
+    }
+    for(i = 0; i < evsysChNum; i++){
+        evsysChUsers[i] = 0;
+        evsysSetGen((eEvsysCh)i, EVSYS_GEN_OFF);
+    }
+    EVSYS_CHANNELS(EVSYS_X_CH_INIT)
+    EVSYS_ROUTES(EVSYS_X_USER_INIT)
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Set generator of the channel
+* @param    ch - event channel
+* @param    gen - generator, group configuration of the channel (e.g.
+*                 EVSYS_ASYNCCH0_PORTA_PIN3_gc)
+* @return   drvBadParameter if the channel is allocated at build time to other
+*           generator, drvHwError if users of other generator are connected
+*/
+eDrvError evsys_setGen(eEvsysCh ch, uint8_t gen){
+    eDrvError exitStatus = drvUnknownError;
+
+    //Check inputs
+    if(ch >= evsysChNum){
+        return drvBadParameter;
+    }
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        if(evsysChGen[ch] == gen){
+            exitStatus = drvNoError;
+        }else if(evsysChFixed & (1 << ch)){
+            exitStatus = drvBadParameter;
+        }else if(evsysChUsers[ch] != 0){
+            exitStatus = drvHwError;
+        }else{
+            exitStatus = evsysSetGen(ch, gen);
+        }
+    }
+
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Connect user to the channel, user is moved from its previous one
+* @param    ch - event channel
+* @param    user - event user
+* @note     Peripheral event input (e.g. ADC STARTEI, TCB CAPTEI) is enabled by
+*           its driver
+*/
+eDrvError evsys_connect(eEvsysCh ch, eEvsysUser user){
+    eDrvError exitStatus = drvUnknownError;
+
+    //Check inputs
+    if((ch >= evsysChNum) || (user >= evsysUserNum)){
+        return drvBadParameter;
+    }
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        if(evsysUserCh[user] == ch + 1){
+            exitStatus = drvNoError;
+        }else if(evsysUserFixed & ((uint16_t)1 << user)){
+            exitStatus = drvBadParameter;
+        }else{
+            exitStatus = evsysConnect(ch, user);
+        }
+    }
+
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Disconnect user from its channel
+* @param    user - event user
+*/
+eDrvError evsys_disconnect(eEvsysUser user){
+    eDrvError exitStatus = drvUnknownError;
+
+    //Check inputs
+    if((user >= evsysUserNum) || (evsysUserFixed & ((uint16_t)1 << user))){
+        return drvBadParameter;
+    }
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        evsysRelease(user);
+        *evsysUserReg(user) = EVSYS_MUX_OFF;
+    }
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Set generator of the channel and connect user to it
+* @param    ch - event channel
+* @param    gen - generator, group configuration of the channel
+* @param    user - event user
+*/
+eDrvError evsys_route(eEvsysCh ch, uint8_t gen, eEvsysUser user){
+    eDrvError exitStatus = drvUnknownError;
+
+    //User leaves the channel first, the generator may then change
+    if((user < evsysUserNum) && (evsysUserCh[user] == ch + 1) && (evsysChGen[ch] != gen)){
+        exitStatus = evsys_disconnect(user);
+        if(exitStatus != drvNoError) return exitStatus;
+    }
+    exitStatus = evsys_setGen(ch, gen);
+    if(exitStatus != drvNoError) return exitStatus;
+    exitStatus = evsys_connect(ch, user);
+
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Issue software event on the channel
+* @param    ch - event channel
+*/
+eDrvError evsys_strobe(eEvsysCh ch){
+    eDrvError exitStatus = drvUnknownError;
+
+    //Check inputs
+    if(ch >= evsysChNum){
+        return drvBadParameter;
+    }
+    if(ch < evsysChSync0){
+        EVSYS.ASYNCSTROBE = 1 << ch;
+    }else{
+        EVSYS.SYNCSTROBE = 1 << (ch - evsysChSync0);
+    }
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Write channel generator
+* @param    ch - event channel
+* @param    gen - generator
+*/
+eDrvError evsysSetGen(eEvsysCh ch, uint8_t gen){
+    if(ch >= evsysChNum){
+        return drvBadParameter;
+    }
+    if(ch < evsysChSync0){
+        (&EVSYS.ASYNCCH0)[ch] = gen;
+    }else{
+        (&EVSYS.SYNCCH0)[ch - evsysChSync0] = gen;
+    }
+    evsysChGen[ch] = gen;
+
+    return drvNoError;
+}
+
+/*!****************************************************************************
+* @brief    Write user multiplexer and account channel users
+* @param    ch - event channel
+* @param    user - event user
+* @return   drvBadParameter if the user can't listen to the channel
+*/
+eDrvError evsysConnect(eEvsysCh ch, eEvsysUser user){
+    uint8_t mux;
+
+    if((ch >= evsysChNum) || (user >= evsysUserNum)){
+        return drvBadParameter;
+    }
+    if(ch >= evsysChSync0){
+        mux = EVSYS_MUX_SYNCCH0 + (ch - evsysChSync0);
+    }else if(user < evsysUserTca0){
+        mux = EVSYS_MUX_ASYNCCH0 + ch;
+    }else{
+        //Synchronous users can't listen to asynchronous channels
+        return drvBadParameter;
+    }
+    evsysRelease(user);
+    *evsysUserReg(user) = mux;
+    evsysUserCh[user] = ch + 1;
+    evsysChUsers[ch]++;
+
+    return drvNoError;
+}
+
+/*!****************************************************************************
+* @brief    Account user leaving its channel
+* @param    user - event user
+*/
+void evsysRelease(eEvsysUser user){
+    uint8_t ch;
+
+    ch = evsysUserCh[user];
+    if(ch != EVSYS_USER_NONE){
+        evsysChUsers[ch - 1]--;
+        evsysUserCh[user] = EVSYS_USER_NONE;
+    }
+}
+
+/*!****************************************************************************
+* @brief    User multiplexer register
+* @param    user - event user
+*/
+volatile uint8_t *evsysUserReg(eEvsysUser user){
+    if(user < evsysUserTca0){
+        return &(&EVSYS.ASYNCUSER0)[user];
+    }
+
+    return &(&EVSYS.SYNCUSER0)[user - evsysUserTca0];
+}
+
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
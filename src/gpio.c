@@ -45,6 +45,11 @@ eDrvError gpio_init(pinMode_type *pinsMode, uint32_t pinNum){
 */
 eDrvError gppin_init(PORT_t *port, uint8_t npin, uint8_t pinDir, uint8_t initState, uint8_t pinInvEn, uint8_t pullUpEn, PORT_ISC_t inputSense){
     eDrvError exitStatus = drvUnknownError;
+    
+    //Pins present are checked by makepin() at compile time
+    if(npin >= DEV_PORT_PIN_NUM){
+        return drvBadParameter;
+    }
     //Set pin direction
     if(pinDir != 0){
         port->DIRSET = (1<<npin);
@@ -59,35 +64,8 @@ eDrvError gppin_init(PORT_t *port, uint8_t npin, uint8_t pinDir, uint8_t initSta
         port->OUTCLR = (1<<npin);
     }
     
-    //Set pin controls
-    switch(npin){
-        case 0:
-            port->PIN0CTRL = (pinInvEn << PORT_INVEN_bp) | (pullUpEn << PORT_PULLUPEN_bp) | (inputSense);
-            break;
-        case 1:
-            port->PIN1CTRL = (pinInvEn << PORT_INVEN_bp) | (pullUpEn << PORT_PULLUPEN_bp) | (inputSense);
-            break;
-        case 2:
-            port->PIN2CTRL = (pinInvEn << PORT_INVEN_bp) | (pullUpEn << PORT_PULLUPEN_bp) | (inputSense);
-            break;
-        case 3:
-            port->PIN3CTRL = (pinInvEn << PORT_INVEN_bp) | (pullUpEn << PORT_PULLUPEN_bp) | (inputSense);
-            break;
-        case 4:
-            port->PIN4CTRL = (pinInvEn << PORT_INVEN_bp) | (pullUpEn << PORT_PULLUPEN_bp) | (inputSense);
-            break;
-        case 5:
-            port->PIN5CTRL = (pinInvEn << PORT_INVEN_bp) | (pullUpEn << PORT_PULLUPEN_bp) | (inputSense);
-            break;
-        case 6:
-            port->PIN6CTRL = (pinInvEn << PORT_INVEN_bp) | (pullUpEn << PORT_PULLUPEN_bp) | (inputSense);
-            break;
-        case 7:
-            port->PIN7CTRL = (pinInvEn << PORT_INVEN_bp) | (pullUpEn << PORT_PULLUPEN_bp) | (inputSense);
-            break;
-        default:
-            break;
-    }
+    //Set pin controls, PINnCTRL registers follow each other
+    (&port->PIN0CTRL)[npin] = (pinInvEn << PORT_INVEN_bp) | (pullUpEn << PORT_PULLUPEN_bp) | (inputSense);
     
     exitStatus = drvNoError;
     return exitStatus;
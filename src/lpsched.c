@@ -0,0 +1,422 @@
+/*!****************************************************************************
+* @file    lpsched.c
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Tickless low-power task scheduler on RTC compare and PIT
+*/
+
+/*!****************************************************************************
+* Include
+*/
+#include "lpsched.h"
+#include "trace.h"
+#include <util/atomic.h>
+
+/*!****************************************************************************
+* Local define
+*/
+#define LPSCHED_WAKE_PIT                        0x80                            //Next to RTC_OVF_bm and RTC_CMP_bm
+#define LPSCHED_PIT_OFF                         0
+#define LPSCHED_PIT_ALIGN                       1                               //Waiting for the first PIT edge
+#define LPSCHED_PIT_CNT                         2                               //RTC is stopped, PIT keeps time
+#define LPSCHED_CNT_SPAN                        0x10000UL
+
+/*!****************************************************************************
+* Local function prototypes
+*/
+uint32_t lpschedNow(void);
+void lpschedLink(lpTask_type *pTask);
+void lpschedUnlink(lpTask_type *pTask);
+eDrvError lpschedStandby(uint32_t due);
+eDrvError lpschedPowerDown(uint32_t due, uint32_t dist);
+eDrvError lpschedPitSync(void);
+void lpschedRtcEvent(uint8_t flags);
+
+/*!****************************************************************************
+* MEMORY
+*/
+lpTask_type *lpSchedHead;                                                       //Tasks sorted by deadline
+volatile uint32_t lpSchedBase;                                                  //Time at RTC count zero
+volatile uint8_t lpSchedWake;                                                   //Wake-up reasons
+volatile uint8_t lpSchedPitState;
+uint16_t lpSchedPitCnt;                                                         //Counts per PIT period
+uint8_t lpSchedLat;                                                             //Wake-up latency compensation
+SLPCTRL_SMODE_t lpSchedMaxMode;
+bool lpSchedIsInit;
+
+/*!****************************************************************************
+* @brief    Initialize scheduler, takes over RTC and PIT
+* @note     RTC runs free at LPSCHED_CLK_HZ, time wraps every 2^32 counts
+*           (36 hours at 32768 Hz). Global interrupts must be enabled
+*/
+eDrvError lpsched_init(void){
+    eDrvError exitStatus = drvUnknownError;
+
+    lpSchedHead = NULL;
+    lpSchedBase = 0;
+    lpSchedWake = 0;
+    lpSchedPitState = LPSCHED_PIT_OFF;
+    lpSchedLat = LPSCHED_LAT_INIT_CNT;
+    lpSchedMaxMode = SLPCTRL_SMODE_STDBY_gc;
+    if(rtc_init(LPSCHED_CLKSEL, 0, 0xFFFF, RTC_PRESCALER_DIV1_gc, true) != drvNoError){
+        return drvHwError;
+    }
+    if(rtc_setCallback(lpschedRtcEvent, RTC_OVF_bm | RTC_CMP_bm) != drvNoError){
+        return drvHwError;
+    }
+    lpSchedIsInit = true;
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Schedule (or reschedule) task
+* @param    *pTask - task to schedule, owned by caller
+* @param    delay - counts until first run
+* @param    period - reload period in counts, 0 for one-shot
+* @param    cb - function to run
+* @param    *pArg - callback argument
+*/
+eDrvError lpsched_add(lpTask_type *pTask, uint32_t delay, uint32_t period, lpTaskCb_type cb, void *pArg){
+    eDrvError exitStatus = drvUnknownError;
+
+    //Check inputs
+    if((pTask == NULL) || (cb == NULL) || (delay > INT32_MAX) || (period > INT32_MAX)){
+        return drvBadParameter;
+    }
+    if(!lpSchedIsInit){
+        return drvHwError;
+    }
+    //List is touched from thread context only
+    if(pTask->isQueued){
+        lpschedUnlink(pTask);
+    }
+    pTask->due = lpschedNow() + delay;
+    pTask->period = period;
+    pTask->cb = cb;
+    pTask->pArg = pArg;
+    lpschedLink(pTask);
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Remove task from schedule
+* @param    *pTask - task to remove
+*/
+eDrvError lpsched_remove(lpTask_type *pTask){
+    eDrvError exitStatus = drvUnknownError;
+
+    //Check inputs
+    if(pTask == NULL){
+        return drvBadParameter;
+    }
+    if(pTask->isQueued){
+        lpschedUnlink(pTask);
+    }
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Set deepest sleep mode scheduler may use
+* @param    mode - idle, standby or power-down
+* @note     Power-down stops RTC, time is kept by PIT then (coarser, see lpsched_run)
+*/
+eDrvError lpsched_setMaxMode(SLPCTRL_SMODE_t mode){
+    eDrvError exitStatus = drvUnknownError;
+
+    //Check inputs
+    if((mode != SLPCTRL_SMODE_IDLE_gc) && (mode != SLPCTRL_SMODE_STDBY_gc) && (mode != SLPCTRL_SMODE_PDOWN_gc)){
+        return drvBadParameter;
+    }
+    lpSchedMaxMode = mode;
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Get scheduler time
+* @param    *pNow - pointer to store time to (counts at LPSCHED_CLK_HZ)
+*/
+eDrvError lpsched_getTime(uint32_t *pNow){
+    eDrvError exitStatus = drvUnknownError;
+
+    //Check inputs
+    if(pNow == NULL){
+        return drvBadParameter;
+    }
+    if(!lpSchedIsInit){
+        return drvHwError;
+    }
+    *pNow = lpschedNow();
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Get current wake-up latency compensation
+* @param    *pLat - pointer to store latency to (counts)
+*/
+eDrvError lpsched_getLatency(uint8_t *pLat){
+    eDrvError exitStatus = drvUnknownError;
+
+    //Check inputs
+    if(pLat == NULL){
+        return drvBadParameter;
+    }
+    *pLat = lpSchedLat;
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Run due tasks, then sleep until the next deadline or any interrupt
+* @note     Call from the main loop forever. Deadlines closer than
+*           LPSCHED_MIN_SLEEP_CNT are spun. Power-down is used for sleeps of
+*           LPSCHED_PD_MIN_CNT and more; it is woken by PIT periods of up to
+*           half of the remaining time, each wake-up may add up to one count.
+*           Other interrupt waking the core from power-down loses the part of
+*           PIT period slept
+*/
+eDrvError lpsched_run(void){
+    lpTask_type *pTask;
+    SLPCTRL_SMODE_t mode;
+    uint32_t now, dist;
+
+    //Check state
+    if(!lpSchedIsInit){
+        return drvHwError;
+    }
+    //Run due tasks
+    now = lpschedNow();
+    while((lpSchedHead != NULL) && ((int32_t)(lpSchedHead->due - now) <= 0)){
+        pTask = lpSchedHead;
+        lpschedUnlink(pTask);
+        if(pTask->period != 0){
+            //Keep phase, periods which were missed are skipped
+            do{
+                pTask->due += pTask->period;
+            }while((int32_t)(pTask->due - now) <= 0);
+            lpschedLink(pTask);
+        }
+        pTask->cb(pTask->pArg);
+        now = lpschedNow();
+    }
+    //Sleep until the nearest deadline
+    dist = LPSCHED_SLEEP_MAX_CNT;
+    if((lpSchedHead != NULL) && ((lpSchedHead->due - now) < dist)){
+        dist = lpSchedHead->due - now;
+    }
+    if(dist <= (uint32_t)LPSCHED_MIN_SLEEP_CNT + lpSchedLat){
+        return drvNoError;
+    }
+    //PIT counts time in power-down only, drivers must allow it too
+    if((lpSchedMaxMode == SLPCTRL_SMODE_PDOWN_gc) && (dist >= LPSCHED_PD_MIN_CNT) &&
+       (sleepctrl_getMode(&mode) == drvNoError) && (mode == SLPCTRL_SMODE_PDOWN_gc)){
+        return lpschedPowerDown(now + dist, dist);
+    }
+
+    return lpschedStandby(now + dist);
+}
+
+/*!****************************************************************************
+* @brief    Scheduler time
+* @return   Counts at LPSCHED_CLK_HZ
+*/
+uint32_t lpschedNow(void){
+    uint32_t now;
+    uint16_t cnt;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        cnt = RTC.CNT;
+        now = lpSchedBase;
+        //Overflow which isn't served yet
+        if((RTC.INTFLAGS & RTC_OVF_bm) && (cnt < (LPSCHED_CNT_SPAN / 2))){
+            now += LPSCHED_CNT_SPAN;
+        }
+    }
+
+    return now + cnt;
+}
+
+/*!****************************************************************************
+* @brief    Insert task to the list keeping deadline order
+* @param    *pTask - task to insert
+*/
+void lpschedLink(lpTask_type *pTask){
+    lpTask_type **ppPos;
+
+    ppPos = &lpSchedHead;
+    while((*ppPos != NULL) && ((int32_t)((*ppPos)->due - pTask->due) <= 0)){
+        ppPos = &(*ppPos)->pNext;
+    }
+    pTask->pNext = *ppPos;
+    *ppPos = pTask;
+    pTask->isQueued = true;
+}
+
+/*!****************************************************************************
+* @brief    Remove task from the list
+* @param    *pTask - task to remove
+*/
+void lpschedUnlink(lpTask_type *pTask){
+    lpTask_type **ppPos;
+
+    ppPos = &lpSchedHead;
+    while((*ppPos != NULL) && (*ppPos != pTask)){
+        ppPos = &(*ppPos)->pNext;
+    }
+    if(*ppPos != NULL){
+        *ppPos = pTask->pNext;
+    }
+    pTask->isQueued = false;
+}
+
+/*!****************************************************************************
+* @brief    Sleep in standby (or idle) until RTC compare
+* @param    due - deadline to wake up at
+*/
+eDrvError lpschedStandby(uint32_t due){
+    SLPCTRL_SMODE_t mode;
+    uint32_t target;
+    int32_t late;
+
+    //Wake up early by the latency seen before
+    target = due - lpSchedLat;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        lpSchedWake &= ~RTC_CMP_bm;
+    }
+    if(rtc_setCmp((uint16_t)target) != drvNoError){
+        return drvHwError;
+    }
+    //Compare synchronization takes a few counts, it must still be ahead
+    if((int32_t)(target - lpschedNow()) < 1){
+        return drvNoError;
+    }
+    mode = (lpSchedMaxMode == SLPCTRL_SMODE_IDLE_gc) ? SLPCTRL_SMODE_IDLE_gc : SLPCTRL_SMODE_STDBY_gc;
+    if(sleepctrl_sleepIf(mode, &lpSchedWake, RTC_CMP_bm) != drvNoError){
+        return drvHwError;
+    }
+    //Track latency: late by a count raises it, early by more than a count lowers it
+    if(lpSchedWake & RTC_CMP_bm){
+        late = (int32_t)(lpschedNow() - due);
+        if((late > 0) && (lpSchedLat < LPSCHED_LAT_MAX_CNT)){
+            lpSchedLat++;
+        }else if((late < -1) && (lpSchedLat > 0)){
+            lpSchedLat--;
+        }
+    }
+
+    return drvNoError;
+}
+
+/*!****************************************************************************
+* @brief    Sleep in power-down, time is counted in PIT periods meanwhile
+* @param    due - deadline
+* @param    dist - counts left until the deadline
+* @note     PIT phase is unknown, so the core waits for the first PIT edge in
+*           standby (RTC counting) and goes to power-down on PIT edges only
+*/
+eDrvError lpschedPowerDown(uint32_t due, uint32_t dist){
+    eDrvError exitStatus = drvNoError;
+    SLPCTRL_SMODE_t mode;
+    uint8_t exp;
+
+    //Longest PIT period up to half of the distance
+    exp = LPSCHED_PIT_EXP_MAX;
+    while((exp > LPSCHED_PIT_EXP_MIN) && (((uint32_t)1 << exp) > (dist >> 1))){
+        exp--;
+    }
+    lpSchedPitCnt = (uint16_t)1 << exp;
+    if(lpschedPitSync() != drvNoError) return drvHwError;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        lpSchedPitState = LPSCHED_PIT_ALIGN;
+        RTC.PITINTFLAGS = RTC_PI_bm;
+        RTC.PITINTCTRL = RTC_PI_bm;
+    }
+    RTC.PITCTRLA = ((exp - 1) << RTC_PERIOD_gp) | RTC_PITEN_bm;
+    for(;;){
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+            lpSchedWake &= ~LPSCHED_WAKE_PIT;
+        }
+        if(lpSchedPitState == LPSCHED_PIT_CNT){
+            //The rest is slept in standby
+            if((int32_t)(due - lpschedNow()) < 2 * (int32_t)lpSchedPitCnt){
+                break;
+            }
+            //A driver became active, PIT periods wouldn't match time asleep
+            if((sleepctrl_getMode(&mode) != drvNoError) || (mode != SLPCTRL_SMODE_PDOWN_gc)){
+                break;
+            }
+        }else{
+            mode = SLPCTRL_SMODE_STDBY_gc;
+        }
+        if(sleepctrl_sleepIf(mode, &lpSchedWake, LPSCHED_WAKE_PIT) != drvNoError){
+            exitStatus = drvHwError;
+            break;
+        }
+        //Woken by something else, let application handle it
+        if((lpSchedWake & LPSCHED_WAKE_PIT) == 0){
+            break;
+        }
+    }
+    //RTC takes over again
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        lpSchedPitState = LPSCHED_PIT_OFF;
+        RTC.PITINTCTRL = 0;
+    }
+    if(lpschedPitSync() != drvNoError) return drvHwError;
+    RTC.PITCTRLA = 0;
+
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Wait until PIT register synchronization is done
+*/
+eDrvError lpschedPitSync(void){
+    timeout_type to;
+
+    if(timeout_start(&to, RTC_SYNC_TIMEOUT_US) != drvNoError) return drvHwError;
+    while(RTC.PITSTATUS & RTC_CTRLBUSY_bm){
+        if(timeout_check(&to, timeoutSiteRtcPitSync) != drvNoError) return drvHwError;
+    }
+
+    return drvNoError;
+}
+
+/*!****************************************************************************
+* @brief    RTC overflow and compare events, called from RTC ISR
+* @param    flags - served interrupt flags
+*/
+void lpschedRtcEvent(uint8_t flags){
+    if(flags & RTC_OVF_bm){
+        lpSchedBase += LPSCHED_CNT_SPAN;
+    }
+    lpSchedWake |= flags;
+}
+
+/*!****************************************************************************
+* @brief    Periodic interrupt timer interrupt
+*/
+ISR(RTC_PIT_vect){
+    traceScope(traceIdIsrPit);
+    RTC.PITINTFLAGS = RTC_PI_bm;
+    if(lpSchedPitState == LPSCHED_PIT_CNT){
+        //RTC was stopped for the whole period
+        lpSchedBase += lpSchedPitCnt;
+    }else if(lpSchedPitState == LPSCHED_PIT_ALIGN){
+        lpSchedPitState = LPSCHED_PIT_CNT;
+    }
+    lpSchedWake |= LPSCHED_WAKE_PIT;
+}
+
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
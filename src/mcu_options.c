@@ -10,12 +10,116 @@
 * Include
 */
 #include "mcu_options.h"
+#include <util/atomic.h>
 
 /*!****************************************************************************
-* @brief    
+* Local function prototypes
+*/
+uint16_t mcuDiagChk(mcuDiag_type *pDiag);
+
+/*!****************************************************************************
+* MEMORY
+*/
+extern uint8_t __heap_start;                                                    //End of static data, from linker
+mcuDiag_type mcuDiagRec __attribute__((section(".noinit")));                    //Running record, survives reset
+mcuDiag_type mcuDiag;                                                           //Snapshot taken at boot
+uint8_t *mcuStackLow;                                                           //Lowest stack byte found used
+bool mcuIsInit;
+
+/*!****************************************************************************
+* @brief    Snapshot reset causes and diagnostics of the previous run, to be
+*           called once early at boot
+* @note     RSTFR is read and cleared only here. Free RAM from the end of
+*           static data up to the stack is painted for the watermark, so it
+*           must run before any heap allocation (first in main() or a
+*           bootStageCritical item). Later calls do nothing, getters return
+*           drvHwError until it has run
 */
 eDrvError mcu_options_init(void){
     eDrvError exitStatus = drvUnknownError;
+    uint8_t *p;
+    
+    if(mcuIsInit){
+        return drvNoError;
+    }
+    //Reset causes, flags are cleared by writing them back
+    mcuDiag.rstFr = RSTCTRL.RSTFR;
+    RSTCTRL.RSTFR = mcuDiag.rstFr;
+    //Previous run record is lost on power-on
+    if((mcuDiag.rstFr & RSTCTRL_PORF_bm) || (mcuDiagRec.magic != MCU_DIAG_MAGIC) || (mcuDiagRec.chk != mcuDiagChk(&mcuDiagRec))){
+        mcuDiagRec.bootCnt = 0;
+        mcuDiagRec.lastPc = 0;
+        mcuDiagRec.stackMax = 0;
+        mcuDiagRec.uptimeMs = 0;
+    }
+    mcuDiag.magic = MCU_DIAG_MAGIC;
+    mcuDiag.bootCnt = mcuDiagRec.bootCnt + 1;
+    mcuDiag.lastPc = mcuDiagRec.lastPc;
+    mcuDiag.stackMax = mcuDiagRec.stackMax;
+    mcuDiag.uptimeMs = mcuDiagRec.uptimeMs;
+    mcuDiag.chk = mcuDiagChk(&mcuDiag);
+    //Start the record of this run
+    mcuDiagRec = mcuDiag;
+    mcuDiagRec.lastPc = 0;
+    mcuDiagRec.stackMax = 0;
+    mcuDiagRec.uptimeMs = 0;
+    mcuDiagRec.chk = mcuDiagChk(&mcuDiagRec);
+    //Paint free stack up to a guard below the current frame
+    mcuStackLow = (uint8_t *)SP - MCU_STACK_GUARD;
+    for(p = &__heap_start; p < mcuStackLow; p++){
+        *p = MCU_STACK_PAINT;
+    }
+    mcuIsInit = true;
+    
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Get diagnostics snapshot taken at boot
+* @param    *pDiag - pointer to store the snapshot to (previous run values)
+*/
+eDrvError mcu_options_getDiag(mcuDiag_type *pDiag){
+    eDrvError exitStatus = drvUnknownError;
+    
+    //Check input
+    if(pDiag == NULL){
+        return drvBadParameter;
+    }
+    if(!mcuIsInit){
+        return drvHwError;
+    }
+    *pDiag = mcuDiag;
+    
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Record caller address, stack watermark and uptime to .noinit RAM
+* @note     To be called periodically from the main loop, the last mark before
+*           a reset is reported on the next boot
+*/
+eDrvError mcu_options_diagMark(void){
+    eDrvError exitStatus = drvUnknownError;
+    uint64_t stamp;
+    
+    //Check state
+    if(!mcuIsInit){
+        return drvHwError;
+    }
+    //Stack grows down, look for used bytes below the known low
+    while((mcuStackLow > &__heap_start) && (*(mcuStackLow - 1) != MCU_STACK_PAINT)){
+        mcuStackLow--;
+    }
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        mcuDiagRec.lastPc = (uint16_t)__builtin_return_address(0);
+        mcuDiagRec.stackMax = RAMEND - (uint16_t)mcuStackLow;
+        if(swtimer_getStamp(&stamp) == drvNoError){
+            mcuDiagRec.uptimeMs = SWTIMER_STAMP_TO_US(stamp) / 1000;
+        }
+        mcuDiagRec.chk = mcuDiagChk(&mcuDiagRec);
+    }
     
     exitStatus = drvNoError;
     return exitStatus;
@@ -31,13 +135,11 @@ eDrvError mcu_options_isPorRstSet(bool *pPorRst){
     if(pPorRst == NULL){
         return drvBadParameter;
     }
-    //Return a POR reset state
-    if((RSTCTRL.RSTFR & RSTCTRL_PORF_bm) != 0){
-        *pPorRst = true;
-        RSTCTRL.RSTFR |= 1 << RSTCTRL_PORF_bp;
-    }else{
-        *pPorRst = false;
+    if(!mcuIsInit){
+        return drvHwError;
     }
+    //Return a POR reset state
+    *pPorRst = (mcuDiag.rstFr & RSTCTRL_PORF_bm) != 0;
     
     exitStatus = drvNoError;
     return exitStatus;
@@ -53,13 +155,11 @@ eDrvError mcu_options_isSwRstEngd(bool *pSwRst){
     if(pSwRst == NULL){
         return drvBadParameter;
     }
-    //Return a POR reset state
-    if((RSTCTRL.RSTFR & RSTCTRL_SWRF_bm) != 0){
-        *pSwRst = true;
-        RSTCTRL.RSTFR |= 1 << RSTCTRL_SWRF_bp;
-    }else{
-        *pSwRst = false;
+    if(!mcuIsInit){
+        return drvHwError;
     }
+    //Return a SW reset state
+    *pSwRst = (mcuDiag.rstFr & RSTCTRL_SWRF_bm) != 0;
     
     exitStatus = drvNoError;
     return exitStatus;
@@ -75,13 +175,11 @@ eDrvError mcu_options_isWdtRstEngd(bool *pWdtRst){
     if(pWdtRst == NULL){
         return drvBadParameter;
     }
-    //Return a POR reset state
-    if((RSTCTRL.RSTFR & RSTCTRL_WDRF_bm) != 0){
-        *pWdtRst = true;
-        RSTCTRL.RSTFR |= 1 << RSTCTRL_WDRF_bp;
-    }else{
-        *pWdtRst = false;
+    if(!mcuIsInit){
+        return drvHwError;
     }
+    //Return a WDT reset state
+    *pWdtRst = (mcuDiag.rstFr & RSTCTRL_WDRF_bm) != 0;
     
     exitStatus = drvNoError;
     return exitStatus;
@@ -97,13 +195,11 @@ eDrvError mcu_options_isExtRstEngd(bool *pExtRst){
     if(pExtRst == NULL){
         return drvBadParameter;
     }
-    //Return a POR reset state
-    if((RSTCTRL.RSTFR & (RSTCTRL_BORF_bm | RSTCTRL_EXTRF_bm | RSTCTRL_UPDIRF_bm)) != 0){
-        *pExtRst = true;
-        RSTCTRL.RSTFR |= (RSTCTRL_BORF_bm | RSTCTRL_EXTRF_bm | RSTCTRL_UPDIRF_bm);
-    }else{
-        *pExtRst = false;
+    if(!mcuIsInit){
+        return drvHwError;
     }
+    //Return an external reset state
+    *pExtRst = (mcuDiag.rstFr & (RSTCTRL_BORF_bm | RSTCTRL_EXTRF_bm | RSTCTRL_UPDIRF_bm)) != 0;
     
     exitStatus = drvNoError;
     return exitStatus;
@@ -121,4 +217,12 @@ eDrvError mcu_options_resetMcu(void){
     return exitStatus;
 }
 
+/*!****************************************************************************
+* @brief    Diagnostics record check value
+* @param    *pDiag - record
+*/
+uint16_t mcuDiagChk(mcuDiag_type *pDiag){
+    return ~(uint16_t)(pDiag->magic + pDiag->bootCnt + pDiag->rstFr + pDiag->lastPc + pDiag->stackMax + (uint16_t)pDiag->uptimeMs + (uint16_t)(pDiag->uptimeMs >> 16));
+}
+
 /***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
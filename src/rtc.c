@@ -10,6 +10,28 @@
  * Include
  */
 #include "rtc.h"
+#include "trace.h"
+#include <util/atomic.h>
+
+/*!****************************************************************************
+ * Local function prototypes
+ */
+eDrvError rtcWaitSync(uint8_t busyMask);
+uint32_t rtcCntToUs(uint32_t cnt, RTC_CLKSEL_t clkSel, RTC_PRESCALER_t pDiv);
+uint8_t rtcTakeEvent(uint8_t mask);
+uint8_t rtcTakeOvf(void);
+
+/*!****************************************************************************
+ * MEMORY
+ */
+uint32_t rtcPeriodUs;                                                           //Overflow period
+uint32_t rtcPeriodCnt;                                                          //Overflow period in counts
+volatile uint8_t rtcEvents;                                                     //Flags served by ISR, not yet taken
+volatile uint8_t rtcOvfCnt;                                                     //Overflows served by ISR, not yet taken
+rtcStat_type rtcStat;
+rtcCb_type rtcCb;
+SLPCTRL_SMODE_t rtcSleepMode;
+bool rtcIsSleepEn;                                                              //Waits sleep
 
 /*!****************************************************************************
  * @brief    Initialize basic settings for Real-Time Counter
@@ -26,31 +48,36 @@ eDrvError rtc_init(RTC_CLKSEL_t clkSel, uint16_t compare, uint16_t period, RTC_P
     RTC.CLKSEL &= ~RTC_CLKSEL_gm;
     RTC.CLKSEL |= clkSel;
     //Set compare value
-    while((RTC.STATUS & RTC_CMPBUSY_bm) != 0);
+    if(rtcWaitSync(RTC_CMPBUSY_bm) != drvNoError) return drvHwError;
     RTC.CMP = compare;
     //Set overflow value
-    while((RTC.STATUS & RTC_PERBUSY_bm) != 0);
+    if(rtcWaitSync(RTC_PERBUSY_bm) != drvNoError) return drvHwError;
     RTC.PER = period;
     //Select prescaler
-    while((RTC.STATUS & RTC_CTRLABUSY_bm) != 0);
+    if(rtcWaitSync(RTC_CTRLABUSY_bm) != drvNoError) return drvHwError;
     RTC.CTRLA &= ~RTC_PRESCALER_gm;
     RTC.CTRLA |= pDiv;
     //Set RUNSTDBY
-    while((RTC.STATUS & RTC_CTRLABUSY_bm) != 0);
+    if(rtcWaitSync(RTC_CTRLABUSY_bm) != drvNoError) return drvHwError;
     if(runStby){
         RTC.CTRLA |= 1 << RTC_RUNSTDBY_bp;
     }else{
         RTC.CTRLA &= ~RTC_RUNSTDBY_bm;
     }
     //Clear counter
-    while((RTC.STATUS & RTC_CNTBUSY_bm) != 0);
+    if(rtcWaitSync(RTC_CNTBUSY_bm) != drvNoError) return drvHwError;
     RTC.CNT = 0;
     //Kick it off!
-    while((RTC.STATUS & RTC_CTRLABUSY_bm) != 0);
+    if(rtcWaitSync(RTC_CTRLABUSY_bm) != drvNoError) return drvHwError;
     RTC.CTRLA |= 1 << RTC_RTCEN_bp;
     //And clear flags
-    if((RTC.INTFLAGS & RTC_OVF_bm) != 0) RTC.INTFLAGS |= 1 << RTC_OVF_bp;
-    if((RTC.INTFLAGS & RTC_CMP_bm) != 0) RTC.INTFLAGS |= 1 << RTC_CMP_bp;
+    RTC.INTFLAGS = RTC_OVF_bm | RTC_CMP_bm;
+    rtcEvents = 0;
+    rtcOvfCnt = 0;
+    //Period length bounds the overflow wait
+    rtcPeriodCnt = (uint32_t)period + 1;
+    rtcPeriodUs = rtcCntToUs(rtcPeriodCnt, clkSel, pDiv);
+    rtc_clearStat();
     
     exitStatus = drvNoError;
     return exitStatus;
@@ -58,27 +85,88 @@ eDrvError rtc_init(RTC_CLKSEL_t clkSel, uint16_t compare, uint16_t period, RTC_P
 
 /*!****************************************************************************
  * @brief    Wait until Real-Time Counter overflows
- * @param    pCntElapsed - pointer where time elapsed since last overflow will be stored
+ * @param    pCntElapsed - pointer where time elapsed since last overflow will be stored,
+ *                         lateness past the missed overflow if cycle is broken (saturates)
  * @param    pIsCycBroken - set if there was overflow event beyond this function
+ * @note     Several missed overflows are told apart only if RTC interrupt is on
+ *           (rtc_setSleep() or rtc_setCallback())
  */
 eDrvError rtc_waitOvf(uint16_t *pCntElapsed, bool *pIsCycBroken){
     eDrvError exitStatus = drvUnknownError;
+    timeout_type to;
+    uint32_t late;
+    uint16_t cnt;
+    uint8_t missed;
     
     //Check inputs
     if((pCntElapsed == NULL) || (pIsCycBroken == NULL)){
         return drvBadParameter;
     }
     //Check timer
-    if((RTC.INTFLAGS & RTC_OVF_bm) == 0){
-        while((RTC.STATUS & RTC_CNTBUSY_bm) != 0);
+    missed = rtcTakeOvf();
+    if(rtcWaitSync(RTC_CNTBUSY_bm) != drvNoError) return drvHwError;
+    cnt = RTC.CNT;
+    if(missed == 0){
+        *pCntElapsed = cnt;
+        *pIsCycBroken = false;
+        if(cnt > rtcStat.busyMax) rtcStat.busyMax = cnt;
+        if(timeout_start(&to, rtcPeriodUs + RTC_SYNC_TIMEOUT_US) != drvNoError) return drvHwError;
+        while(rtcTakeOvf() == 0){
+            //Overflow interrupt wakes the core, timeout isn't counted in standby
+            if(rtcIsSleepEn){
+                sleepctrl_sleepIf(rtcSleepMode, &rtcEvents, RTC_OVF_bm);
+            }
+            if(timeout_check(&to, timeoutSiteRtcOvf) != drvNoError) return drvHwError;
+        }
+    }else{
+        //Counts since the first overflow which was missed
+        late = (uint32_t)(missed - 1) * rtcPeriodCnt + cnt;
+        *pCntElapsed = (late > UINT16_MAX) ? UINT16_MAX : late;
+        *pIsCycBroken = true;
+        if(late > rtcStat.lateMax) rtcStat.lateMax = late;
+        if(rtcStat.overruns < UINT16_MAX) rtcStat.overruns++;
+        rtcStat.missed = ((uint32_t)rtcStat.missed + missed > UINT16_MAX) ? UINT16_MAX : rtcStat.missed + missed;
+    }
+    if(rtcStat.cycles < UINT16_MAX) rtcStat.cycles++;
+    
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+ * @brief    Wait until Real-Time Counter reaches compare value
+ * @param    pCntElapsed - pointer where time elapsed since last overflow will be stored,
+ *                         lateness past the compare match if cycle is broken
+ * @param    pIsCycBroken - set if compare match happened beyond this function
+ */
+eDrvError rtc_waitCmp(uint16_t *pCntElapsed, bool *pIsCycBroken){
+    eDrvError exitStatus = drvUnknownError;
+    timeout_type to;
+    uint16_t cnt, cmp;
+    
+    //Check inputs
+    if((pCntElapsed == NULL) || (pIsCycBroken == NULL)){
+        return drvBadParameter;
+    }
+    //Check timer
+    if(rtcTakeEvent(RTC_CMP_bm) == 0){
+        if(rtcWaitSync(RTC_CNTBUSY_bm) != drvNoError) return drvHwError;
         *pCntElapsed = RTC.CNT;
         *pIsCycBroken = false;
-        while((RTC.INTFLAGS & RTC_OVF_bm) == 0);
-        RTC.INTFLAGS |= 1 << RTC_OVF_bp;
+        if(timeout_start(&to, rtcPeriodUs + RTC_SYNC_TIMEOUT_US) != drvNoError) return drvHwError;
+        while(rtcTakeEvent(RTC_CMP_bm) == 0){
+            if(rtcIsSleepEn){
+                sleepctrl_sleepIf(rtcSleepMode, &rtcEvents, RTC_CMP_bm);
+            }
+            if(timeout_check(&to, timeoutSiteRtcCmp) != drvNoError) return drvHwError;
+        }
     }else{
-        *pCntElapsed = 0;
+        if(rtcWaitSync(RTC_CNTBUSY_bm | RTC_CMPBUSY_bm) != drvNoError) return drvHwError;
+        cnt = RTC.CNT;
+        cmp = RTC.CMP;
+        //Counter may have wrapped after the match
+        *pCntElapsed = (cnt >= cmp) ? cnt - cmp : (uint16_t)(cnt + rtcPeriodCnt - cmp);
         *pIsCycBroken = true;
-        RTC.INTFLAGS |= 1 << RTC_OVF_bp;
     }
     
     exitStatus = drvNoError;
@@ -86,12 +174,210 @@ eDrvError rtc_waitOvf(uint16_t *pCntElapsed, bool *pIsCycBroken){
 }
 
 /*!****************************************************************************
- * @brief    
- * @param    
+ * @brief    Get overrun statistics of rtc_waitOvf()
+ * @param    pStat - pointer to store statistics to
+ */
+eDrvError rtc_getStat(rtcStat_type *pStat){
+    eDrvError exitStatus = drvUnknownError;
+    
+    //Check inputs
+    if(pStat == NULL){
+        return drvBadParameter;
+    }
+    *pStat = rtcStat;
+    
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+ * @brief    Clear overrun statistics
+ */
+eDrvError rtc_clearStat(void){
+    eDrvError exitStatus = drvUnknownError;
+    
+    rtcStat.cycles = 0;
+    rtcStat.overruns = 0;
+    rtcStat.missed = 0;
+    rtcStat.busyMax = 0;
+    rtcStat.lateMax = 0;
+    
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+ * @brief    Set compare value
+ * @param    compare - value to generate CMP flag at
+ */
+eDrvError rtc_setCmp(uint16_t compare){
+    eDrvError exitStatus = drvUnknownError;
+    
+    if(rtcWaitSync(RTC_CMPBUSY_bm) != drvNoError) return drvHwError;
+    RTC.CMP = compare;
+    
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+ * @brief    Set counter value
+ * @param    cnt - value to write
+ */
+eDrvError rtc_setCnt(uint16_t cnt){
+    eDrvError exitStatus = drvUnknownError;
+    
+    if(rtcWaitSync(RTC_CNTBUSY_bm) != drvNoError) return drvHwError;
+    RTC.CNT = cnt;
+    
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+ * @brief    Enable RTC interrupts and set function to call from the ISR
+ * @param    cb - callback, NULL if not needed
+ * @param    intMask - interrupts to enable (RTC_OVF_bm, RTC_CMP_bm)
+ * @note     Both interrupts stay enabled while sleeping waits are on
+ */
+eDrvError rtc_setCallback(rtcCb_type cb, uint8_t intMask){
+    eDrvError exitStatus = drvUnknownError;
+    
+    //Check inputs
+    if((intMask & ~(RTC_OVF_bm | RTC_CMP_bm)) != 0){
+        return drvBadParameter;
+    }
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        rtcCb = cb;
+        if(rtcIsSleepEn){
+            intMask |= RTC_OVF_bm | RTC_CMP_bm;
+        }
+        RTC.INTCTRL = intMask;
+    }
+    
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+ * @brief    Let rtc_waitOvf() and rtc_waitCmp() sleep instead of spinning
+ * @param    mode - sleep mode, standby needs RUNSTDBY set at rtc_init()
+ * @param    isEnabled - sleep while waiting
+ * @note     Global interrupts must be enabled by application
  */
-eDrvError rtc_waitCmp(void){
+eDrvError rtc_setSleep(SLPCTRL_SMODE_t mode, bool isEnabled){
     eDrvError exitStatus = drvUnknownError;
+    
+    //Check inputs
+    if(mode == SLPCTRL_SMODE_PDOWN_gc){
+        return drvBadParameter;                                                 //RTC is stopped in power-down
+    }
+    if((mode == SLPCTRL_SMODE_STDBY_gc) && ((RTC.CTRLA & RTC_RUNSTDBY_bm) == 0)){
+        return drvBadParameter;
+    }
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        rtcSleepMode = mode;
+        rtcIsSleepEn = isEnabled;
+        if(isEnabled){
+            RTC.INTCTRL |= RTC_OVF_bm | RTC_CMP_bm;
+        }else if(rtcCb == NULL){
+            RTC.INTCTRL &= ~(RTC_OVF_bm | RTC_CMP_bm);
+        }
+    }
+    
+    exitStatus = drvNoError;
     return exitStatus;
 }
 
+/*!****************************************************************************
+ * @brief    Wait until RTC register synchronization is done
+ * @param    busyMask - STATUS busy flag(s) to wait for
+ */
+eDrvError rtcWaitSync(uint8_t busyMask){
+    timeout_type to;
+    
+    if(timeout_start(&to, RTC_SYNC_TIMEOUT_US) != drvNoError) return drvHwError;
+    while((RTC.STATUS & busyMask) != 0){
+        if(timeout_check(&to, timeoutSiteRtcSync) != drvNoError) return drvHwError;
+    }
+    
+    return drvNoError;
+}
+
+/*!****************************************************************************
+ * @brief    Convert RTC counts to microseconds (saturating)
+ * @param    cnt - counts at prescaler output
+ * @param    clkSel - clock source
+ * @param    pDiv - prescaler setting
+ */
+uint32_t rtcCntToUs(uint32_t cnt, RTC_CLKSEL_t clkSel, RTC_PRESCALER_t pDiv){
+    uint8_t shift;
+    
+    //Clock cycles, 2^15 at most per count
+    cnt <<= (pDiv & RTC_PRESCALER_gm) >> RTC_PRESCALER_gp;
+    //1e6 / 32768 = 15625 / 512, 1e6 / 1024 = 15625 / 16
+    shift = (clkSel == RTC_CLKSEL_INT1K_gc) ? 4 : 9;
+    if(cnt > (UINT32_MAX / RTC_US_MUL)){
+        cnt >>= shift;
+        return (cnt > (UINT32_MAX / RTC_US_MUL)) ? UINT32_MAX : cnt * RTC_US_MUL;
+    }
+    
+    return (cnt * RTC_US_MUL) >> shift;
+}
+
+/*!****************************************************************************
+ * @brief    Take and clear interrupt flags whether ISR has served them or not
+ * @param    mask - flags to take
+ * @return   Flags which were set
+ */
+uint8_t rtcTakeEvent(uint8_t mask){
+    uint8_t ev;
+    
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        ev = (rtcEvents | RTC.INTFLAGS) & mask;
+        rtcEvents &= ~ev;
+        RTC.INTFLAGS = ev;
+    }
+    
+    return ev;
+}
+
+/*!****************************************************************************
+ * @brief    Take overflows whether ISR has served them or not
+ * @return   Number of overflows (saturates)
+ */
+uint8_t rtcTakeOvf(void){
+    uint8_t cnt;
+    
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        cnt = rtcOvfCnt;
+        if((RTC.INTFLAGS & RTC_OVF_bm) && (cnt < UINT8_MAX)){
+            cnt++;
+        }
+        RTC.INTFLAGS = RTC_OVF_bm;
+        rtcOvfCnt = 0;
+        rtcEvents &= ~RTC_OVF_bm;
+    }
+    
+    return cnt;
+}
+
+/*!****************************************************************************
+ * @brief    RTC counter interrupt
+ */
+ISR(RTC_CNT_vect){
+    traceScope(traceIdIsrRtc);
+    uint8_t flags;
+    
+    flags = RTC.INTFLAGS & RTC.INTCTRL;
+    RTC.INTFLAGS = flags;
+    rtcEvents |= flags;
+    if((flags & RTC_OVF_bm) && (rtcOvfCnt < UINT8_MAX)){
+        rtcOvfCnt++;
+    }
+    if(rtcCb != NULL){
+        rtcCb(flags);
+    }
+}
+
 /***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
@@ -0,0 +1,235 @@
+/*!****************************************************************************
+* @file    sleepctrl.c
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Sleep controller (SLPCTRL)
+*/
+
+/*!****************************************************************************
+* Include
+*/
+#include "sleepctrl.h"
+#include "swtimer.h"
+#include <util/atomic.h>
+
+/*!****************************************************************************
+* Local function prototypes
+*/
+SLPCTRL_SMODE_t sleepctrlDeepest(void);
+eDrvError sleepctrlStampUs(uint32_t *pUs);
+
+/*!****************************************************************************
+* MEMORY
+*/
+uint8_t sleepLimit[sleepUserNum];                                               //Deepest mode index + 1 per user, 0 - none
+sleepStat_type sleepStat[SLEEPCTRL_MODE_NUM];                                   //Statistics per mode
+sleepTime_type sleepTimeSrc = sleepctrlStampUs;                                 //Time source for statistics
+
+/*!****************************************************************************
+* @brief    Sleep until an interrupt unless wake-up condition is already met
+* @param    mode - sleep mode (idle, standby or power-down)
+* @param    *pFlags - flags set by interrupts the caller waits for
+* @param    mask - flags which cancel going to sleep
+* @note     Flags are checked with interrupts disabled and SEI delays interrupts
+*           by one instruction, so a wake-up event can't slip in before SLEEP.
+*           Mode is limited to the deepest one allowed by active drivers
+*/
+eDrvError sleepctrl_sleepIf(SLPCTRL_SMODE_t mode, volatile uint8_t *pFlags, uint8_t mask){
+    eDrvError exitStatus = drvUnknownError;
+    SLPCTRL_SMODE_t deepest;
+    uint32_t start, end;
+    bool isTimed;
+    uint8_t idx;
+
+    //Check inputs
+    if(pFlags == NULL){
+        return drvBadParameter;
+    }
+    //Nothing could wake the core up
+    if((SREG & CPU_I_bm) == 0){
+        return drvHwError;
+    }
+    isTimed = (sleepTimeSrc(&start) == drvNoError);
+    cli();
+    deepest = sleepctrlDeepest();
+    if((mode & SLPCTRL_SMODE_gm) > deepest){
+        mode = deepest;
+    }
+    //Default time base TCB is stopped in standby and power-down
+    if((sleepTimeSrc == sleepctrlStampUs) && ((mode & SLPCTRL_SMODE_gm) != SLPCTRL_SMODE_IDLE_gc)){
+        isTimed = false;
+    }
+    if((*pFlags & mask) == 0){
+        SLPCTRL.CTRLA = (mode & SLPCTRL_SMODE_gm) | SLPCTRL_SEN_bm;
+        sei();
+        sleep_cpu();
+        SLPCTRL.CTRLA &= ~SLPCTRL_SEN_bm;
+        //Account the time once the wake-up interrupt has updated the time base
+        idx = SLEEPCTRL_MODE_IDX(mode);
+        if(isTimed && (sleepTimeSrc(&end) == drvNoError)){
+            sleepStat[idx].timeUs += end - start;
+        }
+        if(sleepStat[idx].count < UINT16_MAX){
+            sleepStat[idx].count++;
+        }
+    }
+    sei();
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Sleep in the deepest mode allowed by active drivers
+* @param    *pFlags - flags set by interrupts the caller waits for
+* @param    mask - flags which cancel going to sleep
+*/
+eDrvError sleepctrl_sleep(volatile uint8_t *pFlags, uint8_t mask){
+    return sleepctrl_sleepIf(SLPCTRL_SMODE_PDOWN_gc, pFlags, mask);
+}
+
+/*!****************************************************************************
+* @brief    Limit sleep to a mode the user still works in
+* @param    user - driver or application
+* @param    deepest - deepest mode allowed while the user is active
+*/
+eDrvError sleepctrl_setLimit(eSleepUser user, SLPCTRL_SMODE_t deepest){
+    eDrvError exitStatus = drvUnknownError;
+
+    //Check inputs
+    if((user >= sleepUserNum) || ((deepest & ~SLPCTRL_SMODE_gm) != 0) || (SLEEPCTRL_MODE_IDX(deepest) >= SLEEPCTRL_MODE_NUM)){
+        return drvBadParameter;
+    }
+    sleepLimit[user] = SLEEPCTRL_MODE_IDX(deepest) + 1;
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Remove limit of the user, e.g. when it becomes inactive
+* @param    user - driver or application
+*/
+eDrvError sleepctrl_clearLimit(eSleepUser user){
+    eDrvError exitStatus = drvUnknownError;
+
+    //Check inputs
+    if(user >= sleepUserNum){
+        return drvBadParameter;
+    }
+    sleepLimit[user] = SLEEPCTRL_LIMIT_NONE;
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Get the deepest sleep mode allowed by active users
+* @param    *pMode - pointer to store mode to
+*/
+eDrvError sleepctrl_getMode(SLPCTRL_SMODE_t *pMode){
+    eDrvError exitStatus = drvUnknownError;
+
+    //Check inputs
+    if(pMode == NULL){
+        return drvBadParameter;
+    }
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        *pMode = sleepctrlDeepest();
+    }
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Set time source for sleep statistics
+* @param    getUs - function returning time in microseconds (wrapping), NULL
+*                   for the software timer time base
+* @note     Time base TCB stops in standby and power-down, so the default
+*           source times idle only. A source running there (e.g. RTC based)
+*           is needed for time asleep in the deeper modes
+*/
+eDrvError sleepctrl_setTimeSource(sleepTime_type getUs){
+    eDrvError exitStatus = drvUnknownError;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        sleepTimeSrc = (getUs != NULL) ? getUs : sleepctrlStampUs;
+    }
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Get statistics of sleep mode
+* @param    mode - sleep mode
+* @param    *pStat - pointer to store statistics to
+*/
+eDrvError sleepctrl_getStat(SLPCTRL_SMODE_t mode, sleepStat_type *pStat){
+    eDrvError exitStatus = drvUnknownError;
+
+    //Check inputs
+    if((pStat == NULL) || (SLEEPCTRL_MODE_IDX(mode) >= SLEEPCTRL_MODE_NUM)){
+        return drvBadParameter;
+    }
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        *pStat = sleepStat[SLEEPCTRL_MODE_IDX(mode)];
+    }
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Clear statistics of all sleep modes
+*/
+eDrvError sleepctrl_clearStat(void){
+    eDrvError exitStatus = drvUnknownError;
+    uint8_t i;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        for(i = 0; i < SLEEPCTRL_MODE_NUM; i++){
+            sleepStat[i].timeUs = 0;
+            sleepStat[i].count = 0;
+        }
+    }
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Deepest mode allowed by all users
+*/
+SLPCTRL_SMODE_t sleepctrlDeepest(void){
+    uint8_t i, idx;
+
+    idx = SLEEPCTRL_MODE_NUM;
+    for(i = 0; i < sleepUserNum; i++){
+        if((sleepLimit[i] != SLEEPCTRL_LIMIT_NONE) && (sleepLimit[i] < idx)){
+            idx = sleepLimit[i];
+        }
+    }
+
+    return (SLPCTRL_SMODE_t)((idx - 1) << 1);
+}
+
+/*!****************************************************************************
+* @brief    Default time source, software timer time base
+* @param    *pUs - pointer to store time to
+* @note     Not used for standby and power-down, see sleepctrl_setTimeSource()
+*/
+eDrvError sleepctrlStampUs(uint32_t *pUs){
+    uint64_t stamp;
+
+    if(swtimer_getStamp(&stamp) != drvNoError){
+        return drvHwError;
+    }
+    *pUs = SWTIMER_STAMP_TO_US(stamp);
+
+    return drvNoError;
+}
+
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
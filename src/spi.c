@@ -10,19 +10,35 @@
 * Include
 */
 #include "spi.h"
+#include "clock.h"
+#include "trace.h"
+
+/*!****************************************************************************
+* Local function prototypes
+*/
+eDrvError spiApplySck(uint32_t hz);
+eDrvError spiRetime(eClockEv ev, uint32_t hzOld, uint32_t hzNew);
+
+/*!****************************************************************************
+* MEMORY
+*/
+uint32_t spiSckHz = SPI_SCK_HZ;                                                 //Highest SCK allowed by slave
+uint32_t spiByteUs;                                                             //Byte time at the applied prescaler
 
 /*!****************************************************************************
 * @brief    Initialize SPI peripheral at preset settings
+* @note     SCK prescaler follows system clock changes made by clock_set()
 */
 eDrvError spi_init(void){
     eDrvError exitStatus = drvUnknownError;
+    uint32_t hz;
     
     //Initialize routine
     SPI0.CTRLA &= ~(1 << SPI_DORD_bp);                                          //MSB first
     SPI0.CTRLA |= 1 << SPI_MASTER_bp;                                           //Master mode
-    SPI0.CTRLA &= ~(1 << SPI_CLK2X_bp);                                         //Normal CLK speed
-    SPI0.CTRLA &= ~SPI_PRESC_gm;
-    SPI0.CTRLA |= SPI_PRESC_DIV128_gc;                                          //CLK / 128
+    if(clock_getHz(&hz) != drvNoError) return drvHwError;
+    if(spiApplySck(hz) != drvNoError) return drvHwError;                        //Closest to SPI_SCK_HZ from below
+    if(clock_register(spiRetime) != drvNoError) return drvHwError;
     
     SPI0.CTRLB &= ~(1 << SPI_BUFEN_bp);                                         //Buffer mode off
     SPI0.CTRLB |= 1 << SPI_BUFWR_bp;                                            //First data write goes into the shift register
@@ -42,6 +58,26 @@ eDrvError spi_init(void){
     return exitStatus;
 }
 
+/*!****************************************************************************
+* @brief    Set highest SCK frequency
+* @param    sckHz - SCK frequency limit, the closest lower one is used
+* @return   drvHwError if even CLK / 128 is above the limit
+*/
+eDrvError spi_setSck(uint32_t sckHz){
+    uint32_t hz;
+    
+    //Check inputs
+    if(sckHz == 0){
+        return drvBadParameter;
+    }
+    if(clock_getHz(&hz) != drvNoError){
+        return drvHwError;
+    }
+    spiSckHz = sckHz;
+    
+    return spiApplySck(hz);
+}
+
 /*!****************************************************************************
 * @brief    Receive portion of data
 * @param    Pointer to destination array
@@ -49,7 +85,9 @@ eDrvError spi_init(void){
 */
 eDrvError spi_receive(uint8_t *pRxData, uint16_t size){
     eDrvError exitStatus = drvUnknownError;
+    timeout_type to;
     uint16_t i;
+    traceScope(traceIdSpiRx);
     
     //Perform checks
     if(!(SPI0.CTRLA & SPI_ENABLE_bm)){
@@ -59,9 +97,13 @@ eDrvError spi_receive(uint8_t *pRxData, uint16_t size){
         return drvBadParameter;
     }
     //Perform a transmission
+    //Twice the byte time per byte
+    if(timeout_start(&to, ((uint32_t)size + 1) * (2 * spiByteUs + 1)) != drvNoError) return drvHwError;
     for(i = 0; i < size; i++){
         SPI0.DATA = 0;
-        while(!(SPI0.INTFLAGS & SPI_IF_bm));                                    //Wait until transfer completes; TODO: add a timer
+        while(!(SPI0.INTFLAGS & SPI_IF_bm)){                                    //Wait until transfer completes
+            if(timeout_check(&to, timeoutSiteSpiRx) != drvNoError) return drvHwError;
+        }
         *pRxData = SPI0.DATA;
         pRxData++;
     }
@@ -78,7 +120,9 @@ eDrvError spi_receive(uint8_t *pRxData, uint16_t size){
 */
 eDrvError spi_transmitReceive(uint8_t *pTxData, uint8_t *pRxData, uint16_t size){
     eDrvError exitStatus = drvUnknownError;
+    timeout_type to;
     uint16_t i;
+    traceScope(traceIdSpiTxRx);
     
     //Perform checks
     if(!(SPI0.CTRLA & SPI_ENABLE_bm)){
@@ -88,10 +132,14 @@ eDrvError spi_transmitReceive(uint8_t *pTxData, uint8_t *pRxData, uint16_t size)
         return drvBadParameter;
     }
     //Perform a transmission
+    //Twice the byte time per byte
+    if(timeout_start(&to, ((uint32_t)size + 1) * (2 * spiByteUs + 1)) != drvNoError) return drvHwError;
     for(i = 0; i < size; i++){
         SPI0.DATA = *pTxData;
         pTxData++;
-        while(!(SPI0.INTFLAGS & SPI_IF_bm));                                    //Wait until transfer completes; TODO: add a timer
+        while(!(SPI0.INTFLAGS & SPI_IF_bm)){                                    //Wait until transfer completes
+            if(timeout_check(&to, timeoutSiteSpiTxRx) != drvNoError) return drvHwError;
+        }
         *pRxData = SPI0.DATA;
         pRxData++;
     }
@@ -100,4 +148,43 @@ eDrvError spi_transmitReceive(uint8_t *pTxData, uint8_t *pRxData, uint16_t size)
     return exitStatus;
 }
 
+/*!****************************************************************************
+* @brief    Set prescaler for the highest SCK not above the limit
+* @param    hz - system clock
+* @note     Divisors 2..64 are PRESC DIV4/16/64 with and without CLK2X, then 128
+*/
+eDrvError spiApplySck(uint32_t hz){
+    uint8_t shift, temp;
+    
+    for(shift = 1; (shift < 7) && ((hz >> shift) > spiSckHz); shift++);
+    temp = SPI0.CTRLA & ~(SPI_PRESC_gm | SPI_CLK2X_bm);
+    if(shift < 7){
+        temp |= ((shift - 1) >> 1) << SPI_PRESC_gp;
+        if(shift & 1){
+            temp |= 1 << SPI_CLK2X_bp;
+        }
+    }else{
+        temp |= SPI_PRESC_DIV128_gc;
+    }
+    SPI0.CTRLA = temp;
+    spiByteUs = (8UL << shift) * 1000000UL / hz;
+    
+    return ((hz >> shift) > spiSckHz) ? drvHwError : drvNoError;
+}
+
+/*!****************************************************************************
+* @brief    Re-time SCK to the new system clock
+* @param    ev - before or after the switch
+* @param    hzOld - clock before the switch
+* @param    hzNew - clock after the switch
+*/
+eDrvError spiRetime(eClockEv ev, uint32_t hzOld, uint32_t hzNew){
+    (void)hzOld;
+    if(ev != clockEvPost){
+        return drvNoError;
+    }
+    
+    return spiApplySck(hzNew);
+}
+
 /***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
@@ -0,0 +1,601 @@
+/*!****************************************************************************
+* @file    swtimer.c
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Software timer wheel multiplexed on a single TCB (tickless)
+*/
+
+/*!****************************************************************************
+* Include
+*/
+#include "swtimer.h"
+#include "capture.h"
+#include "clock.h"
+#include "sleepctrl.h"
+#include "trace.h"
+#include <util/atomic.h>
+
+/*!****************************************************************************
+* Local define
+*/
+#define SWTIMER_TICK_CNT                        ((SWTIMER_CLK_HZ / 1000UL) * SWTIMER_TICK_US / 1000UL)
+#define SWTIMER_CNT_SPAN                        65536UL
+#define SWTIMER_WHEEL_SPAN                      ((uint32_t)1 << (SWTIMER_LVL_BITS * SWTIMER_LVL_NUM))
+
+#if (SWTIMER_TICK_CNT < 2) || (SWTIMER_TICK_CNT > SWTIMER_CNT_SPAN)
+#error "SWTIMER_TICK_US does not fit TCB counter at SWTIMER_CLK_HZ"
+#endif
+#if ((SWTIMER_TCB_NUM == 0) && (CAPTURE_TCB0_EN != 0)) || ((SWTIMER_TCB_NUM == 1) && (CAPTURE_TCB1_EN != 0))
+#error "TCB used by swtimer is also used by capture"
+#endif
+
+/*!****************************************************************************
+* Local function prototypes
+*/
+void swtimerLink(swTimer_type *pTim);
+void swtimerUnlink(swTimer_type *pTim);
+swTimer_type *swtimerDetach(uint8_t slot);
+void swtimerCascade(void);
+void swtimerExpire(void);
+uint16_t swtimerNextEvent(void);
+void swtimerReprogram(void);
+void swtimerAdvance(uint16_t ticks);
+void swtimerProgram(void);
+void swtimerService(void);
+void swtimerSetTickCnt(uint32_t hz);
+void swtimerSleepLimit(void);
+eDrvError swtimerRetime(eClockEv ev, uint32_t hzOld, uint32_t hzNew);
+
+/*!****************************************************************************
+* MEMORY
+*/
+swTimer_type *swTimerSlot[SWTIMER_LVL_NUM * SWTIMER_SLOT_NUM];                  //Slot list heads
+uint16_t swTimerBusy[SWTIMER_LVL_NUM];                                          //Occupied slots per level
+uint32_t swTimerTick;                                                           //Wheel position, tick at period start
+volatile uint64_t swTimerCntBase;                                               //Timestamp at period start, SWTIMER_CLK_HZ units
+volatile uint8_t swTimerSeq;                                                    //Changed whenever base is advanced
+uint16_t swTimerTickCnt;                                                        //Counter units per tick at current clock
+uint16_t swTimerTicksMax;                                                       //Longest hardware period in ticks
+uint16_t swTimerPeriodTicks;                                                    //Current hardware period in ticks
+bool swTimerIsInit;
+bool swTimerInService;                                                          //Callbacks are running
+
+/*!****************************************************************************
+* @brief    Initialize timer wheel and start its hardware timer
+* @note     Safe to call from several drivers, initializes only once. Tick
+*           follows system clock changes made by clock_set()
+*/
+eDrvError swtimer_init(void){
+    eDrvError exitStatus = drvUnknownError;
+    uint32_t hz;
+    uint8_t i;
+
+    //Already running
+    if(swTimerIsInit){
+        return drvNoError;
+    }
+    //Empty wheel
+    for(i = 0; i < SWTIMER_LVL_NUM * SWTIMER_SLOT_NUM; i++){
+        swTimerSlot[i] = NULL;
+    }
+    for(i = 0; i < SWTIMER_LVL_NUM; i++){
+        swTimerBusy[i] = 0;
+    }
+    swTimerTick = 0;
+    swTimerCntBase = 0;
+    if(clock_getHz(&hz) != drvNoError) return drvHwError;
+    if(clock_register(swtimerRetime) != drvNoError) return drvHwError;
+    swtimerSetTickCnt(hz);
+    swTimerPeriodTicks = swTimerTicksMax;
+    //Periodic interrupt mode, nothing to wait for yet
+    SWTIMER_TCB.CTRLA &= ~TCB_ENABLE_bm;
+    SWTIMER_TCB.CTRLA &= ~TCB_CLKSEL_gm;
+    SWTIMER_TCB.CTRLA |= SWTIMER_CLKSEL;
+    SWTIMER_TCB.CTRLB &= ~TCB_CNTMODE_gm;
+    SWTIMER_TCB.CTRLB |= TCB_CNTMODE_INT_gc;
+    SWTIMER_TCB.CCMP = (uint32_t)swTimerTicksMax * swTimerTickCnt - 1;
+    SWTIMER_TCB.CNT = 0;
+    SWTIMER_TCB.INTFLAGS = TCB_CAPT_bm;
+    SWTIMER_TCB.INTCTRL |= 1 << TCB_CAPT_bp;
+    SWTIMER_TCB.CTRLA |= 1 << TCB_ENABLE_bp;
+    swTimerIsInit = true;
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Start (or restart) software timer
+* @param    *pTim - timer to start, owned by caller
+* @param    ticks - ticks until first expiry (expires at ticks-th tick boundary)
+* @param    period - reload period in ticks, 0 for one-shot
+* @param    cb - callback run from ISR on expiry, NULL to use flag only
+* @param    *pArg - callback argument
+*/
+eDrvError swtimer_start(swTimer_type *pTim, uint32_t ticks, uint32_t period, swTimerCb_type cb, void *pArg){
+    eDrvError exitStatus = drvUnknownError;
+    uint16_t elapsed;
+
+    //Check inputs
+    if(pTim == NULL){
+        return drvBadParameter;
+    }
+    if(!swTimerIsInit){
+        return drvHwError;
+    }
+    if(ticks == 0){
+        ticks = 1;
+    }
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        //Account for period which has already ended
+        if((SWTIMER_TCB.INTFLAGS & TCB_CAPT_bm) && !swTimerInService){
+            swtimerService();
+        }
+        if(pTim->slot != SWTIMER_SLOT_IDLE){
+            swtimerUnlink(pTim);
+        }
+        elapsed = SWTIMER_TCB.CNT / swTimerTickCnt;
+        pTim->expires = swTimerTick + elapsed + ticks;
+        pTim->period = period;
+        pTim->cb = cb;
+        pTim->pArg = pArg;
+        pTim->isExpired = 0;
+        swtimerLink(pTim);
+        swtimerReprogram();
+        swtimerSleepLimit();
+    }
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Cancel software timer
+* @param    *pTim - timer to cancel
+*/
+eDrvError swtimer_cancel(swTimer_type *pTim){
+    eDrvError exitStatus = drvUnknownError;
+
+    //Check inputs
+    if(pTim == NULL){
+        return drvBadParameter;
+    }
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        if(pTim->slot != SWTIMER_SLOT_IDLE){
+            swtimerUnlink(pTim);
+        }
+        swtimerSleepLimit();
+    }
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Check and clear expiry flag of software timer
+* @param    *pTim - timer to check
+* @param    *pIsExpired - true if timer expired since previous check
+*/
+eDrvError swtimer_isExpired(swTimer_type *pTim, bool *pIsExpired){
+    eDrvError exitStatus = drvUnknownError;
+
+    //Check inputs
+    if((pTim == NULL) || (pIsExpired == NULL)){
+        return drvBadParameter;
+    }
+    //Flag is only set by ISR, clear it only if it was seen
+    if(pTim->isExpired){
+        pTim->isExpired = 0;
+        *pIsExpired = true;
+    }else{
+        *pIsExpired = false;
+    }
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Service the wheel from polling context (global interrupts disabled)
+*/
+eDrvError swtimer_poll(void){
+    eDrvError exitStatus = drvUnknownError;
+
+    //Check state
+    if(!swTimerIsInit){
+        return drvHwError;
+    }
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        if(SWTIMER_TCB.INTFLAGS & TCB_CAPT_bm){
+            swtimerService();
+        }
+    }
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Read 64 bit monotonic timestamp chained from the wheel hardware periods
+* @param    *pStamp - pointer to store timestamp to (SWTIMER_CLK_HZ units)
+* @note     Lock-free: the read is retried if the wheel interrupt advanced the base
+*           meanwhile. A finished period is serviced in place, so time keeps
+*           running with interrupts off. Units stay the same at any system clock,
+*           the stamp advances by whole ticks and the counter is scaled within one
+*/
+eDrvError swtimer_getStamp(uint64_t *pStamp){
+    eDrvError exitStatus = drvUnknownError;
+    uint64_t base;
+    uint32_t cnt;
+    uint8_t seq, flag;
+
+    //Check inputs
+    if(pStamp == NULL){
+        return drvBadParameter;
+    }
+    if(!swTimerIsInit){
+        return drvHwError;
+    }
+    for(;;){
+        seq = swTimerSeq;
+        flag = SWTIMER_TCB.INTFLAGS & TCB_CAPT_bm;
+        if(flag && !swTimerInService){
+            //Period ended, do the interrupt work now if it can't run itself
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+                if(SWTIMER_TCB.INTFLAGS & TCB_CAPT_bm){
+                    swtimerService();
+                }
+            }
+            continue;
+        }
+        base = swTimerCntBase;
+        cnt = SWTIMER_TCB.CNT;
+        if(flag){
+            //Called from a callback which outlasted the period, counter restarted
+            base += (uint32_t)swTimerPeriodTicks * SWTIMER_TICK_CNT;
+        }else if(SWTIMER_TCB.INTFLAGS & TCB_CAPT_bm){
+            //Counter restarted while it was read
+            continue;
+        }
+        if(seq == swTimerSeq){
+            break;
+        }
+    }
+    if(swTimerTickCnt != SWTIMER_TICK_CNT){
+        cnt = cnt * SWTIMER_TICK_CNT / swTimerTickCnt;
+    }
+    *pStamp = base + cnt;
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Read low 32 bits of the timestamp
+* @param    *pCnt - pointer to store count to (SWTIMER_CLK_HZ units, wraps)
+*/
+eDrvError swtimer_getCnt(uint32_t *pCnt){
+    eDrvError exitStatus = drvUnknownError;
+    uint64_t stamp;
+
+    //Check inputs
+    if(pCnt == NULL){
+        return drvBadParameter;
+    }
+    exitStatus = swtimer_getStamp(&stamp);
+    *pCnt = (uint32_t)stamp;
+
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Put timer to the wheel slot matching its expiry
+* @param    *pTim - timer to link
+*/
+void swtimerLink(swTimer_type *pTim){
+    uint32_t delta;
+    uint8_t level, idx, slot;
+
+    //Timers already due go to the current slot
+    delta = pTim->expires - swTimerTick;
+    if((int32_t)delta < 0){
+        pTim->expires = swTimerTick;
+        delta = 0;
+    }
+    level = 0;
+    while((level < (SWTIMER_LVL_NUM - 1)) && ((delta >> (SWTIMER_LVL_BITS * (level + 1))) != 0)){
+        level++;
+    }
+    idx = (pTim->expires >> (SWTIMER_LVL_BITS * level)) & SWTIMER_SLOT_MASK;
+#if (SWTIMER_LVL_BITS * SWTIMER_LVL_NUM < 32)
+    //Beyond the wheel span: park at the farthest top slot, it is cascaded again
+    if((delta >> (SWTIMER_LVL_BITS * SWTIMER_LVL_NUM)) != 0){
+        idx = ((swTimerTick + SWTIMER_WHEEL_SPAN - 1) >> (SWTIMER_LVL_BITS * level)) & SWTIMER_SLOT_MASK;
+    }
+#endif
+    slot = (level << SWTIMER_LVL_BITS) | idx;
+    //Push to the head of slot list
+    pTim->slot = slot + 1;
+    pTim->pPrev = NULL;
+    pTim->pNext = swTimerSlot[slot];
+    if(pTim->pNext != NULL){
+        pTim->pNext->pPrev = pTim;
+    }
+    swTimerSlot[slot] = pTim;
+    swTimerBusy[level] |= 1U << idx;
+}
+
+/*!****************************************************************************
+* @brief    Remove timer from its wheel slot
+* @param    *pTim - timer to unlink
+*/
+void swtimerUnlink(swTimer_type *pTim){
+    uint8_t slot;
+
+    slot = pTim->slot - 1;
+    if(pTim->pPrev != NULL){
+        pTim->pPrev->pNext = pTim->pNext;
+    }else{
+        swTimerSlot[slot] = pTim->pNext;
+    }
+    if(pTim->pNext != NULL){
+        pTim->pNext->pPrev = pTim->pPrev;
+    }
+    if(swTimerSlot[slot] == NULL){
+        swTimerBusy[slot >> SWTIMER_LVL_BITS] &= ~(1U << (slot & SWTIMER_SLOT_MASK));
+    }
+    pTim->slot = SWTIMER_SLOT_IDLE;
+}
+
+/*!****************************************************************************
+* @brief    Take whole list out of the slot
+* @param    slot - slot number
+* @return   Head of the list
+*/
+swTimer_type *swtimerDetach(uint8_t slot){
+    swTimer_type *pHead;
+
+    pHead = swTimerSlot[slot];
+    swTimerSlot[slot] = NULL;
+    swTimerBusy[slot >> SWTIMER_LVL_BITS] &= ~(1U << (slot & SWTIMER_SLOT_MASK));
+
+    return pHead;
+}
+
+/*!****************************************************************************
+* @brief    Move timers of upper levels down when lower level wraps
+*/
+void swtimerCascade(void){
+    swTimer_type *pTim, *pNext;
+    uint8_t level, idx;
+
+    for(level = 1; level < SWTIMER_LVL_NUM; level++){
+        idx = (swTimerTick >> (SWTIMER_LVL_BITS * level)) & SWTIMER_SLOT_MASK;
+        pTim = swtimerDetach((level << SWTIMER_LVL_BITS) | idx);
+        while(pTim != NULL){
+            pNext = pTim->pNext;
+            swtimerLink(pTim);
+            pTim = pNext;
+        }
+        if(idx != 0){
+            break;
+        }
+    }
+}
+
+/*!****************************************************************************
+* @brief    Expire timers of the current level 0 slot
+*/
+void swtimerExpire(void){
+    swTimer_type *pTim, *pNext;
+
+    pTim = swtimerDetach(swTimerTick & SWTIMER_SLOT_MASK);
+    while(pTim != NULL){
+        pNext = pTim->pNext;
+        pTim->slot = SWTIMER_SLOT_IDLE;
+        if(pTim->expires != swTimerTick){
+            //Parked timer, not due yet
+            swtimerLink(pTim);
+        }else{
+            pTim->isExpired = 1;
+            if(pTim->period != 0){
+                pTim->expires += pTim->period;
+                swtimerLink(pTim);
+            }
+            if(pTim->cb != NULL){
+                pTim->cb(pTim->pArg);
+            }
+        }
+        pTim = pNext;
+    }
+}
+
+/*!****************************************************************************
+* @brief    Distance to the nearest tick which has work to do
+* @return   Number of ticks from wheel position
+*/
+uint16_t swtimerNextEvent(void){
+    uint16_t dist, busy;
+    uint8_t level, idx, i;
+
+    dist = swTimerTicksMax;
+    //Nearest occupied level 0 slot
+    busy = swTimerBusy[0];
+    idx = swTimerTick & SWTIMER_SLOT_MASK;
+    if(busy != 0){
+        for(i = 1; i < SWTIMER_SLOT_NUM; i++){
+            if(busy & (1U << ((idx + i) & SWTIMER_SLOT_MASK))){
+                break;
+            }
+        }
+        if(i < dist) dist = i;
+    }
+    //Level 0 wrap if there is something to cascade
+    for(level = 1; level < SWTIMER_LVL_NUM; level++){
+        if(swTimerBusy[level] != 0){
+            i = SWTIMER_SLOT_NUM - idx;
+            if(i < dist) dist = i;
+            break;
+        }
+    }
+
+    return dist;
+}
+
+/*!****************************************************************************
+* @brief    Shorten running hardware period if new timer is due earlier
+*/
+void swtimerReprogram(void){
+    uint16_t dist;
+    uint32_t top;
+
+    //Service programs the next period itself when callbacks are done
+    if(swTimerInService){
+        return;
+    }
+    dist = swtimerNextEvent();
+    if(dist >= swTimerPeriodTicks){
+        return;
+    }
+    //Keep top ahead of the counter, late by a tick is better than a wrap
+    top = (uint32_t)dist * swTimerTickCnt - 1;
+    while((top < (uint32_t)SWTIMER_TCB.CNT + SWTIMER_MARGIN_CNT) && (dist < swTimerPeriodTicks)){
+        dist++;
+        top += swTimerTickCnt;
+    }
+    if(dist < swTimerPeriodTicks){
+        SWTIMER_TCB.CCMP = top;
+        swTimerPeriodTicks = dist;
+    }
+}
+
+/*!****************************************************************************
+* @brief    Advance the wheel by the finished hardware period
+*/
+void swtimerService(void){
+    SWTIMER_TCB.INTFLAGS = TCB_CAPT_bm;
+    swTimerInService = true;
+    swtimerAdvance(swTimerPeriodTicks);
+    //Counter restarted on match, program the next period
+    swtimerProgram();
+    swTimerInService = false;
+    swtimerSleepLimit();
+}
+
+/*!****************************************************************************
+* @brief    Step the wheel position, expiring due timers
+* @param    ticks - ticks passed
+*/
+void swtimerAdvance(uint16_t ticks){
+    swTimerCntBase += (uint32_t)ticks * SWTIMER_TICK_CNT;
+    swTimerSeq++;
+    //Step tick by tick, only occupied slots cost time
+    for(; ticks > 0; ticks--){
+        swTimerTick++;
+        if((swTimerTick & SWTIMER_SLOT_MASK) == 0){
+            swtimerCascade();
+        }
+        if(swTimerBusy[0] & (1U << (swTimerTick & SWTIMER_SLOT_MASK))){
+            swtimerExpire();
+        }
+    }
+}
+
+/*!****************************************************************************
+* @brief    Program hardware period up to the nearest tick with work to do
+*/
+void swtimerProgram(void){
+    uint16_t dist;
+    uint32_t top;
+
+    dist = swtimerNextEvent();
+    top = (uint32_t)dist * swTimerTickCnt - 1;
+    while((top < (uint32_t)SWTIMER_TCB.CNT + SWTIMER_MARGIN_CNT) && (dist < swTimerTicksMax)){
+        dist++;
+        top += swTimerTickCnt;
+    }
+    SWTIMER_TCB.CCMP = top;
+    swTimerPeriodTicks = dist;
+}
+
+/*!****************************************************************************
+* @brief    Set tick length in counter units for system clock
+* @param    hz - CLK_PER frequency
+* @note     Tick is rounded to whole counts, at very low clocks it gets shorter
+*           or longer than SWTIMER_TICK_US, wheel and timestamps follow the tick
+*/
+void swtimerSetTickCnt(uint32_t hz){
+    uint32_t cnt;
+
+    cnt = ((hz / SWTIMER_CLK_DIV) * SWTIMER_TICK_US + 500000UL) / 1000000UL;
+    if(cnt == 0) cnt = 1;
+    if(cnt > UINT16_MAX) cnt = UINT16_MAX;
+    swTimerTickCnt = cnt;
+    cnt = SWTIMER_CNT_SPAN / cnt;
+    swTimerTicksMax = (cnt > UINT16_MAX) ? UINT16_MAX : cnt;
+}
+
+/*!****************************************************************************
+* @brief    Keep the core in idle while the wheel holds armed timers
+* @note     Wheel TCB doesn't run in standby and power-down, timers would
+*           never expire there
+*/
+void swtimerSleepLimit(void){
+    uint8_t i;
+
+    for(i = 0; i < SWTIMER_LVL_NUM; i++){
+        if(swTimerBusy[i] != 0){
+            sleepctrl_setLimit(sleepUserSwtimer, SLPCTRL_SMODE_IDLE_gc);
+            return;
+        }
+    }
+    sleepctrl_clearLimit(sleepUserSwtimer);
+}
+
+/*!****************************************************************************
+* @brief    Re-time the wheel to the new system clock
+* @param    ev - before or after the switch
+* @param    hzOld - clock before the switch
+* @param    hzNew - clock after the switch
+* @note     Counter is stopped over the switch. Whole ticks already counted are
+*           stepped, the part of the tick is scaled to the new tick length
+*/
+eDrvError swtimerRetime(eClockEv ev, uint32_t hzOld, uint32_t hzNew){
+    uint16_t ticks, tickCntOld;
+    uint32_t cnt;
+
+    (void)hzOld;
+    if(ev == clockEvPre){
+        if((SWTIMER_TCB.INTFLAGS & TCB_CAPT_bm) && !swTimerInService){
+            swtimerService();
+        }
+        SWTIMER_TCB.CTRLA &= ~TCB_ENABLE_bm;
+        return drvNoError;
+    }
+    tickCntOld = swTimerTickCnt;
+    cnt = SWTIMER_TCB.CNT;
+    ticks = cnt / tickCntOld;
+    cnt -= (uint32_t)ticks * tickCntOld;
+    swTimerInService = true;
+    swtimerAdvance(ticks);
+    swtimerSetTickCnt(hzNew);
+    SWTIMER_TCB.CNT = cnt * swTimerTickCnt / tickCntOld;
+    swtimerProgram();
+    swTimerInService = false;
+    swtimerSleepLimit();
+    SWTIMER_TCB.INTFLAGS = TCB_CAPT_bm;
+    SWTIMER_TCB.CTRLA |= 1 << TCB_ENABLE_bp;
+
+    return drvNoError;
+}
+
+/*!****************************************************************************
+* @brief    Timer wheel interrupt
+*/
+ISR(SWTIMER_TCB_vect){
+    traceScope(traceIdIsrSwtimer);
+    swtimerService();
+}
+
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
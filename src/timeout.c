@@ -0,0 +1,167 @@
+/*!****************************************************************************
+* @file    timeout.c
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Timeout-bounded waits on the shared free-running time base
+*/
+
+/*!****************************************************************************
+* Include
+*/
+#include "timeout.h"
+#include "clock.h"
+#include <util/atomic.h>
+
+#if (TIMEOUT_CNT_PER_US == 0)
+#error "Time base clock must be at least 1 MHz"
+#endif
+
+/*!****************************************************************************
+* Local function prototypes
+*/
+eDrvError timeoutStartCnt(timeout_type *pTo, uint32_t cnt);
+
+/*!****************************************************************************
+* MEMORY
+*/
+uint16_t timeoutCount[timeoutSiteNum];                                          //Expired waits per call site
+
+/*!****************************************************************************
+* @brief    Start timeout measured in microseconds
+* @param    *pTo - timeout instance
+* @param    us - time until expiry (saturates at the time base span)
+* @note     Time base is started on first use
+*/
+eDrvError timeout_start(timeout_type *pTo, uint32_t us){
+    uint32_t cnt;
+
+    //Saturate instead of wrapping
+    if(us > (UINT32_MAX / TIMEOUT_CNT_PER_US)){
+        cnt = UINT32_MAX;
+    }else{
+        cnt = us * TIMEOUT_CNT_PER_US;
+    }
+
+    return timeoutStartCnt(pTo, cnt);
+}
+
+/*!****************************************************************************
+* @brief    Start timeout measured in peripheral clock cycles
+* @param    *pTo - timeout instance
+* @param    cycles - CLK_PER cycles until expiry (at the current system clock)
+* @note     Rounded up to whole microseconds per cycle below 1 MHz
+*/
+eDrvError timeout_startCyc(timeout_type *pTo, uint32_t cycles){
+    uint32_t hz, us, usPerCyc;
+
+    if(clock_getHz(&hz) != drvNoError){
+        return drvHwError;
+    }
+    if(hz >= 1000000UL){
+        us = cycles / (hz / 1000000UL);
+    }else{
+        usPerCyc = (1000000UL + hz - 1) / hz;
+        us = (cycles > (UINT32_MAX / usPerCyc)) ? UINT32_MAX : cycles * usPerCyc;
+    }
+
+    return timeout_start(pTo, us);
+}
+
+/*!****************************************************************************
+* @brief    Check if timeout has expired, to be called in a wait loop
+* @param    *pTo - timeout instance
+* @param    site - call site to account expiry for
+* @return   drvNoError while time is left, drvHwError on expiry
+*/
+eDrvError timeout_check(timeout_type *pTo, eTimeoutSite site){
+    uint32_t now, elapsed;
+
+    //Time base is read only every few polls to keep the loop tight
+    if(++pTo->polls < TIMEOUT_POLL_DIV){
+        return drvNoError;
+    }
+    pTo->polls = 0;
+    if(swtimer_getCnt(&now) != drvNoError){
+        return drvHwError;
+    }
+    elapsed = now - pTo->last;
+    pTo->last = now;
+    if(elapsed < pTo->remain){
+        pTo->remain -= elapsed;
+        return drvNoError;
+    }
+    //Expired
+    if((site < timeoutSiteNum) && (timeoutCount[site] < TIMEOUT_COUNT_MAX)){
+        timeoutCount[site]++;
+    }
+
+    return drvHwError;
+}
+
+/*!****************************************************************************
+* @brief    Get number of expired waits for call site
+* @param    site - call site
+* @param    *pCount - pointer to store the counter to
+*/
+eDrvError timeout_getCount(eTimeoutSite site, uint16_t *pCount){
+    eDrvError exitStatus = drvUnknownError;
+
+    //Check inputs
+    if((site >= timeoutSiteNum) || (pCount == NULL)){
+        return drvBadParameter;
+    }
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        *pCount = timeoutCount[site];
+    }
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Clear expired waits counters of all call sites
+*/
+eDrvError timeout_clearCounts(void){
+    eDrvError exitStatus = drvUnknownError;
+    uint8_t i;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        for(i = 0; i < timeoutSiteNum; i++){
+            timeoutCount[i] = 0;
+        }
+    }
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Start timeout measured in time base counts
+* @param    *pTo - timeout instance
+* @param    cnt - time base counts until expiry
+*/
+eDrvError timeoutStartCnt(timeout_type *pTo, uint32_t cnt){
+    eDrvError exitStatus = drvUnknownError;
+
+    //Check inputs
+    if(pTo == NULL){
+        return drvBadParameter;
+    }
+    //Left expired if the time base fails
+    pTo->last = 0;
+    pTo->remain = 0;
+    pTo->polls = 0;
+    if(swtimer_init() != drvNoError){
+        return drvHwError;
+    }
+    if(swtimer_getCnt(&pTo->last) != drvNoError){
+        return drvHwError;
+    }
+    pTo->remain = cnt;
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
@@ -10,6 +10,53 @@
 * Include
 */
 #include "timer.h"
+#include "clock.h"
+#include "sleepctrl.h"
+#include "evsys.h"
+#include "trace.h"
+#include <util/atomic.h>
+
+/*!****************************************************************************
+* Local define
+*/
+#if (DEV_TCD0_EN == 0)
+#error "Timer driver needs TCD0"
+#endif
+
+/*!****************************************************************************
+* Local macro
+*/
+#if (DEV_TCB_NUM > 1)
+#define timerTcbCnt(p)                          (((p) == &TCB0) ? timCntB0 : timCntB1)
+#define timerTcbInst(timCnt)                    (((timCnt) == timCntB0) ? &TCB0 : &TCB1)
+#else
+#define timerTcbCnt(p)                          timCntB0
+#define timerTcbInst(timCnt)                    (&TCB0)
+#endif
+
+/*!****************************************************************************
+* Local function prototypes
+*/
+eDrvError timerTimDCompare(uint16_t duty, uint16_t deadTime);
+eDrvError timerTimDWaitStatus(uint8_t readyMask);
+uint32_t timerTimACycles(void);
+uint32_t timerTimBCycles(TCB_t *p);
+uint16_t timerTimADiv(void);
+uint16_t timerTimBDiv(TCB_t *p);
+uint16_t timerCycEnd(timerCycStat_type *pStat, bool isBroken, uint16_t div);
+eDrvError timerRetime(eClockEv ev, uint32_t hzOld, uint32_t hzNew);
+eDrvError timerRetimeTop(eTimNum timCnt, uint32_t hz, uint16_t *pTop);
+uint16_t timerRescale(uint16_t value, uint16_t topOld, uint16_t topNew);
+
+/*!****************************************************************************
+* MEMORY
+*/
+const uint16_t timATcaDiv[] = {1, 2, 4, 8, 16, 64, 256, 1024};                  //TCA prescaler by CLKSEL
+TCD_WGMODE_t timDWgMode;
+uint16_t timDTop;
+timerCycStat_type timCycStat[timCntNum];                                        //Cycle statistics by timer
+uint16_t timRefTop[timCntNum];                                                  //Top as set by caller
+uint32_t timRefHz[timCntNum];                                                   //System clock top was set at
 
 /*!****************************************************************************
 * @brief    Initialize timer counter A
@@ -24,6 +71,7 @@ eDrvError timer_initTimA(TCA_SINGLE_CLKSEL_t clk, TCA_SINGLE_WGMODE_t wgMode, ui
     
     //Perform initialization
     TCA0.SINGLE.CTRLA &= ~TCA_SINGLE_ENABLE_bm;
+    sleepctrl_clearLimit(sleepUserTimA);
     TCA0.SINGLE.CTRLA &= ~TCA_SINGLE_CLKSEL_gm;
     TCA0.SINGLE.CTRLA |= clk;
     TCA0.SINGLE.CTRLB &= ~TCA_SINGLE_WGMODE_gm;
@@ -51,6 +99,14 @@ eDrvError timer_initTimA(TCA_SINGLE_CLKSEL_t clk, TCA_SINGLE_WGMODE_t wgMode, ui
 eDrvError timer_startTimA(uint16_t top){
     eDrvError exitStatus = drvUnknownError;
     
+    //Cycles are timestamped
+    if(swtimer_init() != drvNoError) return drvHwError;
+    //Period is kept in time on system clock changes
+    if(clock_getHz(&timRefHz[timCntA0]) != drvNoError) return drvHwError;
+    if(clock_register(timerRetime) != drvNoError) return drvHwError;
+    timRefTop[timCntA0] = top;
+    //TCA stops in standby
+    if(sleepctrl_setLimit(sleepUserTimA, SLPCTRL_SMODE_IDLE_gc) != drvNoError) return drvHwError;
     //Set up top value
     TCA0.SINGLE.PER = top;
     //Reset timer
@@ -64,11 +120,14 @@ eDrvError timer_startTimA(uint16_t top){
 
 /*!****************************************************************************
 * @brief    Wait until timer counts to its set top
-* @param    *pSysCycLen - length of current cycle (in counter units)
+* @param    *pSysCycLen - time spent in current cycle (in counter units), length
+*                         of the whole overrun cycle if it is broken (saturates)
 * @param    *pIsCycBroken - boolean flag representing broken counting cycle
 */
 eDrvError timer_waitOvfTimA(uint16_t *pSysCycLen, bool *pIsCycBroken){
     eDrvError exitStatus = drvUnknownError;
+    timeout_type to;
+    traceScope(traceIdTimAWait);
     
     //Check operational mode
     if((TCA0.SINGLE.CTRLB & TCA_SINGLE_WGMODE_gm) != TCA_SINGLE_WGMODE_NORMAL_gc){
@@ -79,13 +138,17 @@ eDrvError timer_waitOvfTimA(uint16_t *pSysCycLen, bool *pIsCycBroken){
         *pSysCycLen = TCA0.SINGLE.CNT;
         *pIsCycBroken = false;
         if(TCA0.SINGLE.CTRLA & TCA_SINGLE_ENABLE_bm){
-            while(((TCA0.SINGLE.INTFLAGS & TCA_SINGLE_OVF_bm) >> TCA_SINGLE_OVF_bp) == 0);
+            if(timeout_startCyc(&to, 2 * timerTimACycles()) != drvNoError) return drvHwError;
+            while(((TCA0.SINGLE.INTFLAGS & TCA_SINGLE_OVF_bm) >> TCA_SINGLE_OVF_bp) == 0){
+                if(timeout_check(&to, timeoutSiteTimAOvf) != drvNoError) return drvHwError;
+            }
             TCA0.SINGLE.INTFLAGS |= 1 << TCA_SINGLE_OVF_bp;
+            timerCycEnd(&timCycStat[timCntA0], false, timerTimADiv());
         }
     }else{
-        *pSysCycLen = 0;
         *pIsCycBroken = true;
         TCA0.SINGLE.INTFLAGS |= 1 << TCA_SINGLE_OVF_bp;
+        *pSysCycLen = timerCycEnd(&timCycStat[timCntA0], true, timerTimADiv());
     }
     
     exitStatus = drvNoError;
@@ -124,11 +187,12 @@ eDrvError timer_initTimB(TCB_t *p, TCB_CNTMODE_t mode, TCB_CLKSEL_t clk){
     eDrvError exitStatus = drvUnknownError;
     
     //Check inputs
-    if(p == NULL){
+    if((p == NULL) || (p == &SWTIMER_TCB) || traceIsTcb(p)){
         return drvBadParameter;
     }
     //Perform initialization
     p->CTRLA &= ~TCB_ENABLE_bm;
+    sleepctrl_clearLimit((eSleepUser)(sleepUserTimB0 + timerTcbCnt(p) - timCntB0));
     p->CTRLA &= ~TCB_CLKSEL_gm;
     p->CTRLA |= clk;
     p->CTRLB &= ~TCB_CNTMODE_gm;
@@ -145,11 +209,22 @@ eDrvError timer_initTimB(TCB_t *p, TCB_CNTMODE_t mode, TCB_CLKSEL_t clk){
 */
 eDrvError timer_startTimB(TCB_t *p, uint16_t top){
     eDrvError exitStatus = drvUnknownError;
+    eTimNum timCnt;
     
     //Check inputs
-    if(p == NULL){
+    if((p == NULL) || (p == &SWTIMER_TCB) || traceIsTcb(p)){
         return drvBadParameter;
     }
+    //Cycles are timestamped
+    if(swtimer_init() != drvNoError) return drvHwError;
+    //Period is kept in time on system clock changes
+    timCnt = timerTcbCnt(p);
+    if(clock_getHz(&timRefHz[timCnt]) != drvNoError) return drvHwError;
+    if(clock_register(timerRetime) != drvNoError) return drvHwError;
+    timRefTop[timCnt] = top;
+    //Counter keeps running in standby only if asked to
+    if(sleepctrl_setLimit((eSleepUser)(sleepUserTimB0 + timCnt - timCntB0),
+                          (p->CTRLA & TCB_RUNSTDBY_bm) ? SLPCTRL_SMODE_STDBY_gc : SLPCTRL_SMODE_IDLE_gc) != drvNoError) return drvHwError;
     //Set up top value
     p->CCMP = top;
     //Reset timer
@@ -164,27 +239,36 @@ eDrvError timer_startTimB(TCB_t *p, uint16_t top){
 /*!****************************************************************************
 * @brief    Wait until timer counts to its set top
 * @param    *p - timer instance
-* @param    *pSysCycLen - length of current cycle (in counter units)
+* @param    *pSysCycLen - time spent in current cycle (in counter units), length
+*                         of the whole overrun cycle if it is broken (saturates)
 * @param    *pIsCycBroken - boolean flag representing broken counting cycle
 */
 eDrvError timer_waitOvfTimB(TCB_t *p, uint16_t *pSysCycLen, bool *pIsCycBroken){
     eDrvError exitStatus = drvUnknownError;
+    timeout_type to;
+    timerCycStat_type *pStat;
+    traceScope(traceIdTimBWait);
     
     //Check inputs
-    if(p == NULL){
+    if((p == NULL) || (p == &SWTIMER_TCB) || traceIsTcb(p)){
         return drvBadParameter;
     }
     if((p->CTRLB & TCB_CNTMODE_gm) != TCB_CNTMODE_SINGLE_gc){
         return drvHwError;
     }
+    pStat = &timCycStat[timerTcbCnt(p)];
     //Cycle isn't broken
     if(p->STATUS & TCB_RUN_bm){
         *pSysCycLen = p->CNT;
         *pIsCycBroken = false;
-        while(p->STATUS & TCB_RUN_bm);
+        if(timeout_startCyc(&to, 2 * timerTimBCycles(p)) != drvNoError) return drvHwError;
+        while(p->STATUS & TCB_RUN_bm){
+            if(timeout_check(&to, timeoutSiteTimBOvf) != drvNoError) return drvHwError;
+        }
+        timerCycEnd(pStat, false, timerTimBDiv(p));
     }else{
-        *pSysCycLen = 0;
         *pIsCycBroken = true;
+        *pSysCycLen = timerCycEnd(pStat, true, timerTimBDiv(p));
     }
     
     exitStatus = drvNoError;
@@ -193,36 +277,178 @@ eDrvError timer_waitOvfTimB(TCB_t *p, uint16_t *pSysCycLen, bool *pIsCycBroken){
 
 /*!****************************************************************************
 * @brief    Initialize timer counter D
+* @param    clk - clock source (OSC20M, EXTCLK or SYSCLK)
+* @param    cntPres - counter prescaler
+* @param    syncPres - synchronization prescaler
+* @param    wgMode - waveform: one-ramp, two-ramp or dual-slope
+* @param    pwmOutputs - outputs to enable (TCD_CMPAEN_bm, TCD_CMPBEN_bm)
+* @note     Outputs A and B are driven complementary with dead time inserted
 */
-eDrvError timer_initTimD(void){
+eDrvError timer_initTimD(TCD_CLKSEL_t clk, TCD_CNTPRES_t cntPres, TCD_SYNCPRES_t syncPres, TCD_WGMODE_t wgMode, uint8_t pwmOutputs){
     eDrvError exitStatus = drvUnknownError;
     
     //Check inputs
-    if(0){
+    if(wgMode == TCD_WGMODE_FOURRAMP_gc){
         return drvBadParameter;
     }
+    //Stop timer, configuration registers are enable-protected
+    if(TCD0.CTRLA & TCD_ENABLE_bm){
+        TCD0.CTRLA &= ~TCD_ENABLE_bm;
+        if(timerTimDWaitStatus(TCD_ENRDY_bm) != drvNoError) return drvHwError;
+    }
     //Perform initialization
+    TCD0.CTRLA = clk | cntPres | syncPres;
+    TCD0.CTRLB = wgMode;
+    TCD0.CTRLC = 0;
+    TCD0.CTRLD = 0;
+    _PROTECTED_WRITE(TCD0.FAULTCTRL, pwmOutputs & (TCD_CMPAEN_bm | TCD_CMPBEN_bm));
+    TCD0.INPUTCTRLA = TCD_INPUTMODE_NONE_gc;
+    TCD0.EVCTRLA = 0;
+    timDWgMode = wgMode;
+    
+    exitStatus = drvNoError;
+    return exitStatus;
+}
 
+/*!****************************************************************************
+* @brief    Set up fault input of timer counter D fed from EVSYS
+* @param    evCh - asynchronous event channel number (0..3) carrying the fault
+* @param    evGen - generator for the channel (e.g. EVSYS_ASYNCCH0_PORTA_PIN3_gc)
+* @param    faultHigh - fault is active on high level / rising edge
+* @param    inputMode - action on fault (e.g. TCD_INPUTMODE_WAITSW_gc)
+* @note     Must be called before timer_startTimD(). Outputs are forced low on fault
+*/
+eDrvError timer_setFaultTimD(uint8_t evCh, uint8_t evGen, bool faultHigh, TCD_INPUTMODE_t inputMode){
+    eDrvError exitStatus = drvUnknownError;
+    
+    //Check inputs
+    if(evCh >= TIMD_EV_CH_NUM){
+        return drvBadParameter;
+    }
+    if(TCD0.CTRLA & TCD_ENABLE_bm){
+        return drvHwError;
+    }
+    //Route the event channel to TCD0 input A
+    exitStatus = evsys_route((eEvsysCh)(evsysChAsync0 + evCh), evGen, evsysUserTcd0Ev0);
+    if(exitStatus != drvNoError) return exitStatus;
+    //Fault values of the enabled outputs are zero
+    _PROTECTED_WRITE(TCD0.FAULTCTRL, TCD0.FAULTCTRL & (TCD_CMPAEN_bm | TCD_CMPBEN_bm));
+    TCD0.EVCTRLA = TCD_CFG_FILTER_gc | ((faultHigh ? 1 : 0) << TCD_EDGE_bp) | TCD_ACTION_FAULT_gc | (1 << TCD_TRIGEI_bp);
+    TCD0.INPUTCTRLA = inputMode;
+    
     exitStatus = drvNoError;
     return exitStatus;
 }
 
 /*!****************************************************************************
 * @brief    Start counting
-* @param    top - top value timer will overflow on
+* @param    top - period in counter units (dual-slope counts up and down to it)
+* @note     Starts at zero duty: output A off, output B on except for dead time
 */
 eDrvError timer_startTimD(uint16_t top){
     eDrvError exitStatus = drvUnknownError;
+    
+    //Check inputs
+    if((top == 0) || (top > TIMD_CMP_MAX)){
+        return drvBadParameter;
+    }
+    //Set up top value and zero duty, copied directly while timer is disabled
+    timDTop = top;
+    if(timerTimDCompare(0, 0) != drvNoError){
+        return drvBadParameter;
+    }
+    //Cycles are timestamped
+    if(swtimer_init() != drvNoError) return drvHwError;
+    //Start timer
+    if(timerTimDWaitStatus(TCD_ENRDY_bm) != drvNoError) return drvHwError;
+    TCD0.CTRLA |= 1 << TCD_ENABLE_bp;
+    
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Set on-time of output A and dead time between complementary outputs
+* @param    duty - on-time of output A in counter units, in dual-slope mode
+*                  counts of the 2 * top period (resolution of 2)
+* @param    deadTime - dead time in counter units, inserted on both edges
+* @note     New values are double-buffered and applied at the end of cycle
+*/
+eDrvError timer_setPwmTimD(uint16_t duty, uint16_t deadTime){
+    eDrvError exitStatus = drvUnknownError;
+    
+    //Check timer state
+    if((TCD0.CTRLA & TCD_ENABLE_bm) == 0){
+        return drvHwError;
+    }
+    //Previous synchronization has to finish before buffers are touched
+    if(timerTimDWaitStatus(TCD_CMDRDY_bm) != drvNoError) return drvHwError;
+    if(timerTimDCompare(duty, deadTime) != drvNoError){
+        return drvBadParameter;
+    }
+    TCD0.CTRLE = 1 << TCD_SYNCEOC_bp;
+    
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Restart timer counter D after software-acknowledged fault
+*/
+eDrvError timer_restartTimD(void){
+    eDrvError exitStatus = drvUnknownError;
+    
+    //Check timer state
+    if((TCD0.CTRLA & TCD_ENABLE_bm) == 0){
+        return drvHwError;
+    }
+    if(timerTimDWaitStatus(TCD_CMDRDY_bm) != drvNoError) return drvHwError;
+    TCD0.CTRLE = 1 << TCD_RESTART_bp;
+    
+    exitStatus = drvNoError;
     return exitStatus;
 }
 
 /*!****************************************************************************
 * @brief    Wait until timer counts to its set top
-* @param    *pSysCycLen - length of current cycle (in counter units)
+* @param    *pSysCycLen - time spent in current cycle (in counter units),
+*                         UINT16_MAX if the cycle is broken
 * @param    *pIsCycBroken - boolean flag representing broken counting cycle
+* @note     TCD0 clock is asynchronous, overrun length is in timer_getCycStat()
 */
 eDrvError timer_waitOvfTimD(uint16_t *pSysCycLen, bool *pIsCycBroken){
     eDrvError exitStatus = drvUnknownError;
+    timeout_type to;
+    traceScope(traceIdTimDWait);
+    
+    //Check inputs
+    if((pSysCycLen == NULL) || (pIsCycBroken == NULL)){
+        return drvBadParameter;
+    }
+    if((TCD0.CTRLA & TCD_ENABLE_bm) == 0){
+        return drvHwError;
+    }
+    //Cycle isn't broken
+    if((TCD0.INTFLAGS & TCD_OVF_bm) == 0){
+        //Counter is readable through software capture only
+        if(timerTimDWaitStatus(TCD_CMDRDY_bm) != drvNoError) return drvHwError;
+        TCD0.CTRLE = 1 << TCD_SCAPTUREA_bp;
+        if(timerTimDWaitStatus(TCD_CMDRDY_bm) != drvNoError) return drvHwError;
+        *pSysCycLen = TCD0.CAPTUREA;
+        *pIsCycBroken = false;
+        if(timeout_start(&to, TIMD_OVF_TIMEOUT_US) != drvNoError) return drvHwError;
+        while((TCD0.INTFLAGS & TCD_OVF_bm) == 0){
+            if(timeout_check(&to, timeoutSiteTimDOvf) != drvNoError) return drvHwError;
+        }
+        TCD0.INTFLAGS = TCD_OVF_bm;
+        timerCycEnd(&timCycStat[timCntD0], false, 0);
+    }else{
+        *pIsCycBroken = true;
+        TCD0.INTFLAGS = TCD_OVF_bm;
+        *pSysCycLen = timerCycEnd(&timCycStat[timCntD0], true, 0);
+    }
+    
+    exitStatus = drvNoError;
     return exitStatus;
 }
 
@@ -248,10 +474,12 @@ eDrvError timer_isTimEnabled(eTimNum timCnt, bool *pIsEnable){
             *pIsEnable = ((TCB0.CTRLA & TCB_ENABLE_bm) > 0) ? true : false;
             exitStatus = drvNoError;
             break;
+#if (DEV_TCB_NUM > 1)
         case timCntB1:
             *pIsEnable = ((TCB1.CTRLA & TCB_ENABLE_bm) > 0) ? true : false;
             exitStatus = drvNoError;
             break;
+#endif
         case timCntD0:
             *pIsEnable = ((TCD0.CTRLA & TCD_ENABLE_bm) > 0) ? true : false;
             exitStatus = drvNoError;
@@ -264,4 +492,290 @@ eDrvError timer_isTimEnabled(eTimNum timCnt, bool *pIsEnable){
     return exitStatus;
 }
 
+/*!****************************************************************************
+* @brief    Get cycle statistics collected by waitOvf functions
+* @param    timCnt - timer-counter to ask
+* @param    *pStat - pointer to store statistics to (timestamp units, see swtimer)
+* @note     lenMax - lenMin is the cycle jitter seen by the control loop
+*/
+eDrvError timer_getCycStat(eTimNum timCnt, timerCycStat_type *pStat){
+    eDrvError exitStatus = drvUnknownError;
+    
+    //Check inputs
+    if((timCnt >= timCntNum) || (pStat == NULL)){
+        return drvBadParameter;
+    }
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        *pStat = timCycStat[timCnt];
+    }
+    
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Clear cycle statistics, next cycle is measured from the next overflow
+* @param    timCnt - timer-counter to clear
+*/
+eDrvError timer_clearCycStat(eTimNum timCnt){
+    eDrvError exitStatus = drvUnknownError;
+    
+    //Check inputs
+    if(timCnt >= timCntNum){
+        return drvBadParameter;
+    }
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        timCycStat[timCnt].lenMin = UINT32_MAX;
+        timCycStat[timCnt].lenMax = 0;
+        timCycStat[timCnt].overruns = 0;
+        timCycStat[timCnt].cycles = 0;
+        timCycStat[timCnt].isStarted = false;
+    }
+    
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Compute and write timer counter D compare values for half-bridge
+* @param    duty - on-time of output A in counter units, of the 2 * top period in dual-slope mode
+* @param    deadTime - dead time in counter units
+*/
+eDrvError timerTimDCompare(uint16_t duty, uint16_t deadTime){
+    uint16_t aSet, aClr, bSet, bClr;
+    
+    //Check that both dead times fit into the period, dual-slope passes each compare twice
+    if(timDWgMode == TCD_WGMODE_DS_gc){
+        if(((uint32_t)(duty >> 1) + deadTime) > timDTop){
+            return drvBadParameter;
+        }
+    }else if(((uint32_t)duty + 2 * (uint32_t)deadTime) > timDTop){
+        return drvBadParameter;
+    }
+    switch(timDWgMode){
+        case TCD_WGMODE_ONERAMP_gc:
+            //Single ramp to CMPBCLR: A on [aSet, aClr), B on [bSet, bClr)
+            aSet = deadTime;
+            aClr = deadTime + duty;
+            bSet = aClr + deadTime;
+            bClr = timDTop;
+            break;
+        case TCD_WGMODE_TWORAMP_gc:
+            //Ramp A ends at CMPACLR, ramp B at CMPBCLR, both lead by dead time
+            aSet = deadTime;
+            aClr = deadTime + duty;
+            bSet = deadTime;
+            bClr = timDTop - aClr;
+            break;
+        case TCD_WGMODE_DS_gc:
+            //Up-down to CMPBCLR: A on below CMPASET, B on above CMPBSET
+            aSet = duty >> 1;
+            aClr = 0;
+            bSet = aSet + deadTime;
+            bClr = timDTop;
+            break;
+        default:
+            return drvBadParameter;
+    }
+    TCD0.CMPASET = aSet;
+    TCD0.CMPACLR = aClr;
+    TCD0.CMPBSET = bSet;
+    TCD0.CMPBCLR = bClr;
+    
+    return drvNoError;
+}
+
+/*!****************************************************************************
+* @brief    Wait for timer counter D synchronization
+* @param    readyMask - STATUS flag to wait for (TCD_ENRDY_bm or TCD_CMDRDY_bm)
+*/
+eDrvError timerTimDWaitStatus(uint8_t readyMask){
+    timeout_type to;
+    
+    if(timeout_start(&to, TIMD_SYNC_TIMEOUT_US) != drvNoError) return drvHwError;
+    while((TCD0.STATUS & readyMask) == 0){
+        if(timeout_check(&to, timeoutSiteTimDSync) != drvNoError) return drvHwError;
+    }
+    
+    return drvNoError;
+}
+
+/*!****************************************************************************
+* @brief    Length of timer counter A period
+* @return   Period in CLK_PER cycles
+*/
+uint32_t timerTimACycles(void){
+    return ((uint32_t)TCA0.SINGLE.PER + 1) * timerTimADiv();
+}
+
+/*!****************************************************************************
+* @brief    Length of timer counter B single-shot
+* @param    *p - timer instance
+* @return   Period in CLK_PER cycles
+*/
+uint32_t timerTimBCycles(TCB_t *p){
+    return ((uint32_t)p->CCMP + 1) * timerTimBDiv(p);
+}
+
+/*!****************************************************************************
+* @brief    Timer counter A prescaler
+* @return   CLK_PER cycles per count
+*/
+uint16_t timerTimADiv(void){
+    return timATcaDiv[(TCA0.SINGLE.CTRLA & TCA_SINGLE_CLKSEL_gm) >> TCA_SINGLE_CLKSEL_gp];
+}
+
+/*!****************************************************************************
+* @brief    Timer counter B prescaler
+* @param    *p - timer instance
+* @return   CLK_PER cycles per count
+*/
+uint16_t timerTimBDiv(TCB_t *p){
+    switch(p->CTRLA & TCB_CLKSEL_gm){
+        case TCB_CLKSEL_CLKDIV1_gc:
+            return 1;
+        case TCB_CLKSEL_CLKDIV2_gc:
+            return 2;
+        default:
+            return timerTimADiv();
+    }
+}
+
+/*!****************************************************************************
+* @brief    Timestamp end of cycle, which is the start of the next one
+* @param    *pStat - statistics of the timer
+* @param    isBroken - cycle has overrun
+* @param    div - CLK_PER cycles per timer count, 0 if not synchronous to CLK_PER
+* @return   Cycle length in timer counts (saturates), 0 if it wasn't started
+*/
+uint16_t timerCycEnd(timerCycStat_type *pStat, bool isBroken, uint16_t div){
+    uint32_t now, len, cnt, hz;
+    
+    if((swtimer_getCnt(&now) != drvNoError) || (clock_getHz(&hz) != drvNoError)){
+        return 0;
+    }
+    cnt = 0;
+    if(pStat->isStarted){
+        len = now - pStat->start;
+        if(len < pStat->lenMin) pStat->lenMin = len;
+        if(len > pStat->lenMax) pStat->lenMax = len;
+        if(pStat->cycles < UINT16_MAX) pStat->cycles++;
+        if(isBroken){
+            if(pStat->overruns < UINT16_MAX) pStat->overruns++;
+            //Timestamp units don't follow system clock changes, timer counts do
+            cnt = UINT16_MAX;
+            if((div != 0) && (len < (UINT32_MAX / SWTIMER_CLK_DIV))){
+                if(hz == SWTIMER_CLK_HZ * SWTIMER_CLK_DIV){
+                    cnt = (len * SWTIMER_CLK_DIV) / div;
+                }else{
+                    cnt = ((uint64_t)len * hz) / ((uint64_t)SWTIMER_CLK_HZ * div);
+                }
+                if(cnt > UINT16_MAX) cnt = UINT16_MAX;
+            }
+        }
+    }else{
+        pStat->lenMin = UINT32_MAX;
+        pStat->lenMax = 0;
+        pStat->isStarted = true;
+    }
+    pStat->start = now;
+    
+    return cnt;
+}
+
+/*!****************************************************************************
+* @brief    Keep running TCA and TCB periods in time on system clock change
+* @param    ev - before or after the switch
+* @param    hzOld - clock before the switch
+* @param    hzNew - clock after the switch
+* @return   drvHwError if a period doesn't fit the counter at the new clock
+* @note     Top is scaled from the value set by caller, PWM compares and counter
+*           keep their share of the period, pending TCA0 buffers are scaled the
+*           same. TCD0 runs from its own clock source
+*/
+eDrvError timerRetime(eClockEv ev, uint32_t hzOld, uint32_t hzNew){
+    eDrvError exitStatus = drvNoError;
+    TCB_t *p;
+    eTimNum timCnt;
+    uint16_t top, topOld;
+    uint8_t mode, bv;
+    
+    (void)hzOld;
+    if(ev != clockEvPost){
+        return drvNoError;
+    }
+    //Timers not started by this driver are left alone
+    if((TCA0.SINGLE.CTRLA & TCA_SINGLE_ENABLE_bm) && (timRefHz[timCntA0] != 0)){
+        if(timerRetimeTop(timCntA0, hzNew, &top) != drvNoError) exitStatus = drvHwError;
+        topOld = TCA0.SINGLE.PER;
+        //Buffers not applied yet would restore values of the old clock on UPDATE
+        bv = TCA0.SINGLE.CTRLFSET;
+        if(bv & TCA_SINGLE_PERBV_bm){
+            TCA0.SINGLE.PERBUF = timerRescale(TCA0.SINGLE.PERBUF, topOld, top);
+        }
+        if(bv & TCA_SINGLE_CMP0BV_bm){
+            TCA0.SINGLE.CMP0BUF = timerRescale(TCA0.SINGLE.CMP0BUF, topOld, top);
+        }
+        if(bv & TCA_SINGLE_CMP1BV_bm){
+            TCA0.SINGLE.CMP1BUF = timerRescale(TCA0.SINGLE.CMP1BUF, topOld, top);
+        }
+        if(bv & TCA_SINGLE_CMP2BV_bm){
+            TCA0.SINGLE.CMP2BUF = timerRescale(TCA0.SINGLE.CMP2BUF, topOld, top);
+        }
+        TCA0.SINGLE.CMP0 = timerRescale(TCA0.SINGLE.CMP0, topOld, top);
+        TCA0.SINGLE.CMP1 = timerRescale(TCA0.SINGLE.CMP1, topOld, top);
+        TCA0.SINGLE.CMP2 = timerRescale(TCA0.SINGLE.CMP2, topOld, top);
+        TCA0.SINGLE.CNT = timerRescale(TCA0.SINGLE.CNT, topOld, top);
+        TCA0.SINGLE.PER = top;
+    }
+    for(timCnt = timCntB0; timCnt < timCntB0 + DEV_TCB_NUM; timCnt++){
+        p = timerTcbInst(timCnt);
+        mode = p->CTRLB & TCB_CNTMODE_gm;
+        if((p == &SWTIMER_TCB) || traceIsTcb(p) || !(p->CTRLA & TCB_ENABLE_bm) || (timRefHz[timCnt] == 0)){
+            continue;
+        }
+        if((mode != TCB_CNTMODE_INT_gc) && (mode != TCB_CNTMODE_SINGLE_gc)){
+            continue;
+        }
+        if(timerRetimeTop(timCnt, hzNew, &top) != drvNoError) exitStatus = drvHwError;
+        p->CNT = timerRescale(p->CNT, p->CCMP, top);
+        p->CCMP = top;
+    }
+    
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Top value keeping the period set by caller
+* @param    timCnt - timer
+* @param    hz - system clock
+* @param    *pTop - pointer to store top to (saturates)
+* @return   drvHwError if the period doesn't fit the counter
+*/
+eDrvError timerRetimeTop(eTimNum timCnt, uint32_t hz, uint16_t *pTop){
+    uint64_t cnt;
+    
+    cnt = (((uint64_t)timRefTop[timCnt] + 1) * hz + timRefHz[timCnt] / 2) / timRefHz[timCnt];
+    if(cnt == 0){
+        cnt = 1;
+    }
+    if(cnt > ((uint32_t)UINT16_MAX + 1)){
+        *pTop = UINT16_MAX;
+        return drvHwError;
+    }
+    *pTop = cnt - 1;
+    
+    return drvNoError;
+}
+
+/*!****************************************************************************
+* @brief    Keep value at the same share of the period
+* @param    value - compare or counter value
+* @param    topOld - top before the change
+* @param    topNew - top after the change
+*/
+uint16_t timerRescale(uint16_t value, uint16_t topOld, uint16_t topNew){
+    return ((uint32_t)value * ((uint32_t)topNew + 1)) / ((uint32_t)topOld + 1);
+}
+
 /***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
@@ -0,0 +1,234 @@
+/*!****************************************************************************
+* @file    trace.c
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Event trace into RAM ring buffer, time stamped by a free-running TCB
+* @note     Dump: TRACE_HDR_SIZE byte header ('T', 'R', version, event
+*           count, stamp clock in Hz LE), events oldest first as ID and
+*           stamp LE, CRC-16/CCITT-FALSE of all preceding bytes MSB first
+*/
+
+/*!****************************************************************************
+* Include
+*/
+#include <string.h>
+#include "trace.h"
+#include "clock.h"
+#include "crc.h"
+
+#if (TRACE_EN != 0)
+/*!****************************************************************************
+* Local function prototypes
+*/
+eDrvError traceOut(traceOut_type out, uint8_t *pData, uint16_t size, uint16_t *pCrc);
+
+/*!****************************************************************************
+* MEMORY
+*/
+traceEntry_type traceBuf[TRACE_BUF_SIZE];
+uint8_t traceHead;                                                              //Next slot written, oldest event
+volatile bool traceIsPaused;                                                    //Dump in progress
+PORT_t *tracePort;                                                              //Bit-banged dump pin
+uint8_t tracePinBm;
+uint16_t traceBitCnt;                                                           //Stamp counts per bit
+
+/*!****************************************************************************
+* @brief    Start free-running time stamp counter
+* @note     Stamp clock follows CLK_PER, a dump reports the clock at its time
+*/
+eDrvError trace_init(void){
+    TRACE_TCB.CTRLA = 0;
+    TRACE_TCB.CTRLB = TCB_CNTMODE_INT_gc;
+    TRACE_TCB.CCMP = UINT16_MAX;
+    TRACE_TCB.CNT = 0;
+    TRACE_TCB.INTFLAGS = TCB_CAPT_bm;
+    TRACE_TCB.INTCTRL = (TRACE_WRAP_EN != 0) ? TCB_CAPT_bm : 0;
+    TRACE_TCB.CTRLA = TRACE_CLKSEL | TCB_RUNSTDBY_bm | TCB_ENABLE_bm;
+
+    return drvNoError;
+}
+
+/*!****************************************************************************
+* @brief    Drop recorded events
+*/
+eDrvError trace_clear(void){
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        memset(traceBuf, 0, sizeof(traceBuf));
+        traceHead = 0;
+    }
+
+    return drvNoError;
+}
+
+/*!****************************************************************************
+* @brief    Send recorded events, oldest first
+* @param    out - byte sink, e.g. usart_transmit or trace_pinTransmit
+* @return   drvHwError if sink failed
+* @note     Recording is paused while the dump runs, buffer is kept
+*/
+eDrvError trace_dump(traceOut_type out){
+    eDrvError exitStatus = drvUnknownError;
+    traceEntry_type *pEntry;
+    uint8_t buf[TRACE_HDR_SIZE];
+    uint32_t hz;
+    uint16_t crc;
+    uint8_t i, idx, num;
+
+    //Check inputs
+    if(out == NULL){
+        return drvBadParameter;
+    }
+    if(clock_getHz(&hz) != drvNoError) return drvHwError;
+    hz /= TRACE_CLK_DIV;
+    traceIsPaused = true;
+    num = 0;
+    for(i = 0; i < TRACE_BUF_SIZE; i++){
+        if(traceBuf[i].id != traceIdNone) num++;
+    }
+    buf[0] = TRACE_MAGIC0;
+    buf[1] = TRACE_MAGIC1;
+    buf[2] = TRACE_FMT_VER;
+    buf[3] = num;
+    for(i = 0; i < 4; i++){
+        buf[4 + i] = (uint8_t)(hz >> (8 * i));
+    }
+    crc = CRC16_INIT;
+    exitStatus = traceOut(out, buf, TRACE_HDR_SIZE, &crc);
+    //Head is the oldest slot once buffer wrapped, unwritten slots are skipped
+    idx = traceHead;
+    for(i = 0; (i < TRACE_BUF_SIZE) && (exitStatus == drvNoError); i++){
+        pEntry = &traceBuf[idx];
+        idx = (idx + 1) & TRACE_BUF_MASK;
+        if(pEntry->id == traceIdNone){
+            continue;
+        }
+        buf[0] = pEntry->id;
+        buf[1] = (uint8_t)pEntry->stamp;
+        buf[2] = (uint8_t)(pEntry->stamp >> 8);
+        exitStatus = traceOut(out, buf, 3, &crc);
+    }
+    if(exitStatus == drvNoError){
+        buf[0] = (uint8_t)(crc >> 8);
+        buf[1] = (uint8_t)crc;
+        exitStatus = out(buf, 2);
+    }
+    traceIsPaused = false;
+
+    return (exitStatus == drvNoError) ? drvNoError : drvHwError;
+}
+
+/*!****************************************************************************
+* @brief    Set pin for bit-banged dump, 8N1 UART frames
+* @param    port - port of the pin
+* @param    npin - pin number
+* @param    baud - bit rate at current clock
+* @return   drvBadParameter if bit is too short for the stamp clock
+*/
+eDrvError trace_setPin(PORT_t *port, uint8_t npin, uint32_t baud){
+    uint32_t cnt, hz;
+
+    //Check inputs
+    if((port == NULL) || (npin >= DEV_PORT_PIN_NUM) || (baud == 0)){
+        return drvBadParameter;
+    }
+    if(clock_getHz(&hz) != drvNoError) return drvHwError;
+    cnt = hz / TRACE_CLK_DIV / baud;
+    if((cnt < TRACE_PIN_BIT_CNT_MIN) || (cnt > UINT16_MAX)){
+        return drvBadParameter;
+    }
+    traceBitCnt = cnt;
+    tracePort = port;
+    tracePinBm = 1 << npin;
+    //Line idles high
+    port->OUTSET = tracePinBm;
+    port->DIRSET = tracePinBm;
+
+    return drvNoError;
+}
+
+/*!****************************************************************************
+* @brief    Bit-bang bytes on the pin set by trace_setPin()
+* @note     Bits are timed on the stamp counter, interrupts are disabled for
+*           each frame
+*/
+eDrvError trace_pinTransmit(uint8_t *pData, uint16_t size){
+    uint16_t frame, t;
+    uint8_t bit;
+
+    //Check inputs
+    if((pData == NULL) || (tracePort == NULL)){
+        return drvBadParameter;
+    }
+    while(size-- > 0){
+        //Start bit, 8 data bits LSB first, stop bit
+        frame = ((uint16_t)*pData++ << 1) | (1 << 9);
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+            t = TRACE_TCB.CNT;
+            for(bit = 0; bit < 10; bit++){
+                if(frame & 1){
+                    tracePort->OUTSET = tracePinBm;
+                }else{
+                    tracePort->OUTCLR = tracePinBm;
+                }
+                frame >>= 1;
+                t += traceBitCnt;
+                //Counter wraps at UINT16_MAX, difference stays valid
+                while((int16_t)(TRACE_TCB.CNT - t) < 0);
+            }
+        }
+    }
+
+    return drvNoError;
+}
+
+/*!****************************************************************************
+* @brief    Send bytes and add them to CRC
+*/
+eDrvError traceOut(traceOut_type out, uint8_t *pData, uint16_t size, uint16_t *pCrc){
+    crc_calc16(pData, size, pCrc);
+    return out(pData, size);
+}
+
+#if (TRACE_WRAP_EN != 0)
+/*!****************************************************************************
+* @brief    Stamp counter wrapped
+*/
+ISR(TRACE_TCB_vect){
+    TRACE_TCB.INTFLAGS = TCB_CAPT_bm;
+    trace_event(traceIdWrap);
+}
+#endif
+
+#else
+/*!****************************************************************************
+* @brief    Tracing is not built, calls do nothing
+*/
+eDrvError trace_init(void){
+    return drvNoError;
+}
+
+eDrvError trace_clear(void){
+    return drvNoError;
+}
+
+eDrvError trace_dump(traceOut_type out){
+    (void)out;
+    return drvNoError;
+}
+
+eDrvError trace_setPin(PORT_t *port, uint8_t npin, uint32_t baud){
+    (void)port;
+    (void)npin;
+    (void)baud;
+    return drvNoError;
+}
+
+eDrvError trace_pinTransmit(uint8_t *pData, uint16_t size){
+    (void)pData;
+    (void)size;
+    return drvNoError;
+}
+#endif
+
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
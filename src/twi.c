@@ -0,0 +1,437 @@
+/*!****************************************************************************
+* @file    twi.c
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   TWI (I2C) master driver with queued interrupt-driven transactions
+*/
+
+/*!****************************************************************************
+* Include
+*/
+#include "twi.h"
+#include "clock.h"
+#include "gpio.h"
+#include "sleepctrl.h"
+#include "trace.h"
+#include <util/atomic.h>
+
+/*!****************************************************************************
+* Local define
+*/
+#define TWI_DIR_READ                            0x01                            //R/W bit of address byte
+
+/*!****************************************************************************
+* Local function prototypes
+*/
+eDrvError twiApplyScl(uint32_t hz);
+eDrvError twiRetime(eClockEv ev, uint32_t hzOld, uint32_t hzNew);
+void twiStart(void);
+void twiFinish(eDrvError status);
+void twiTimeout(void *pArg);
+void twiAbort(twiXfer_type *pXfer);
+eDrvError twiHalfBit(void);
+
+/*!****************************************************************************
+* MEMORY
+*/
+uint32_t twiSclHz = TWI_SCL_HZ;                                                 //Highest SCL allowed by slaves
+twiXfer_type *twiHead;                                                          //Transaction in progress
+twiXfer_type *twiTail;                                                          //Last queued transaction
+uint8_t twiIdx;                                                                 //Byte index in current phase
+bool twiIsRxPhase;                                                              //Reading after (repeated) start
+swTimer_type twiTim;                                                            //Transaction timeout
+
+/*!****************************************************************************
+* @brief    Initialize TWI0 as bus master
+* @param    sclHz - SCL frequency limit, up to 1 MHz (Fm+)
+* @note     Pull-ups are external. Stuck bus is recovered before enabling. SCL
+*           follows system clock changes made by clock_set()
+*/
+eDrvError twi_init(uint32_t sclHz){
+    eDrvError exitStatus = drvUnknownError;
+    
+    //Check inputs
+    if(sclHz == 0){
+        return drvBadParameter;
+    }
+    //Transaction timeouts run on the software timer
+    if(swtimer_init() != drvNoError) return drvHwError;
+    TWI0.MCTRLA = 0;
+    exitStatus = twi_recover();
+    if(exitStatus != drvNoError) return exitStatus;
+    exitStatus = twi_setScl(sclHz);
+    if(exitStatus != drvNoError) return exitStatus;
+    if(clock_register(twiRetime) != drvNoError) return drvHwError;
+    TWI0.MCTRLA = (1 << TWI_RIEN_bp) | (1 << TWI_WIEN_bp) | TWI_TIMEOUT_200US_gc | (1 << TWI_ENABLE_bp);
+    TWI0.MSTATUS = TWI_BUSSTATE_IDLE_gc;                                        //Unknown after enable
+    
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Set highest SCL frequency
+* @param    sclHz - SCL frequency limit, the closest lower one is used
+* @return   drvHwError if SCL can't be reached at current clock
+*/
+eDrvError twi_setScl(uint32_t sclHz){
+    uint32_t hz;
+    
+    //Check inputs
+    if(sclHz == 0){
+        return drvBadParameter;
+    }
+    if(clock_getHz(&hz) != drvNoError){
+        return drvHwError;
+    }
+    twiSclHz = sclHz;
+    
+    return twiApplyScl(hz);
+}
+
+/*!****************************************************************************
+* @brief    Queue write-then-read transaction
+* @param    *pXfer - transaction, owned by caller until done
+* @note     Write only, read only and write with repeated start read are
+*           supported. Returns at once, see twi_isDone() / twi_wait()
+*/
+eDrvError twi_submit(twiXfer_type *pXfer){
+    eDrvError exitStatus = drvUnknownError;
+    
+    //Check inputs
+    if((pXfer == NULL) || (pXfer->addr > TWI_ADDR_MAX) || ((pXfer->txLen == 0) && (pXfer->rxLen == 0))){
+        return drvBadParameter;
+    }
+    if(((pXfer->txLen != 0) && (pXfer->pTx == NULL)) || ((pXfer->rxLen != 0) && (pXfer->pRx == NULL))){
+        return drvBadParameter;
+    }
+    if((TWI0.MCTRLA & TWI_ENABLE_bm) == 0){
+        return drvHwError;
+    }
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        if(!pXfer->isDone){
+            //Already queued
+            exitStatus = drvBadParameter;
+        }else{
+            pXfer->pNext = NULL;
+            pXfer->status = drvNoError;
+            pXfer->isDone = false;
+            if(twiHead == NULL){
+                twiHead = pXfer;
+                twiTail = pXfer;
+                twiStart();
+            }else{
+                twiTail->pNext = pXfer;
+                twiTail = pXfer;
+            }
+            exitStatus = drvNoError;
+        }
+    }
+    
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Check if transaction is finished
+* @param    *pXfer - transaction
+* @param    *pIsDone - pointer to store the result to, status is in pXfer
+*/
+eDrvError twi_isDone(twiXfer_type *pXfer, bool *pIsDone){
+    eDrvError exitStatus = drvUnknownError;
+    
+    //Check inputs
+    if((pXfer == NULL) || (pIsDone == NULL)){
+        return drvBadParameter;
+    }
+    *pIsDone = pXfer->isDone;
+    
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Wait until transaction is finished
+* @param    *pXfer - transaction
+* @return   Transaction status, drvHwError on timeout
+* @note     Needs global interrupts enabled. Budget is a transaction timeout
+*           for each descriptor up to this one, on expiry the descriptor is
+*           taken out of the queue so it may leave the caller's scope
+*/
+eDrvError twi_wait(twiXfer_type *pXfer){
+    twiXfer_type *p;
+    timeout_type to;
+    uint32_t num = 1;
+    bool isTimed;
+    
+    //Check inputs
+    if(pXfer == NULL){
+        return drvBadParameter;
+    }
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        for(p = twiHead; (p != NULL) && (p != pXfer); p = p->pNext){
+            num++;
+        }
+    }
+    //Descriptor stays linked until done, abort it if the wait can't be timed
+    isTimed = timeout_start(&to, num * TWI_XFER_TIMEOUT_US) == drvNoError;
+    while(!pXfer->isDone){
+        if(!isTimed || (timeout_check(&to, timeoutSiteTwiXfer) != drvNoError)){
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+                twiAbort(pXfer);
+            }
+            return pXfer->isDone ? pXfer->status : drvHwError;
+        }
+    }
+    
+    return pXfer->status;
+}
+
+/*!****************************************************************************
+* @brief    Release bus held by a slave and reset bus state
+* @note     Slave stuck in the middle of a byte keeps SDA low, SCL pulses let it
+*           finish and a STOP condition resets it. Pins are driven open-drain
+*           while the master is disabled, transactions must not be in progress
+*/
+eDrvError twi_recover(void){
+    eDrvError exitStatus = drvUnknownError;
+    PORT_t *port = &TWI_PORT;
+    timeout_type to;
+    uint8_t mctrla, i;
+    
+    if(twiHead != NULL){
+        return drvHwError;
+    }
+    mctrla = TWI0.MCTRLA;
+    TWI0.MCTRLA = 0;
+    _gppin_dirIn(port, TWI_SCL_PIN);
+    _gppin_dirIn(port, TWI_SDA_PIN);
+    _gppin_reset(port, TWI_SCL_PIN);
+    _gppin_reset(port, TWI_SDA_PIN);
+    for(i = 0; (i < TWI_RECOVER_PULSES) && (_gppin_get(port, TWI_SDA_PIN) == 0); i++){
+        _gppin_dirOut(port, TWI_SCL_PIN);
+        if(twiHalfBit() != drvNoError) return drvHwError;
+        _gppin_dirIn(port, TWI_SCL_PIN);
+        //Slave may stretch the clock
+        if(timeout_start(&to, TWI_XFER_TIMEOUT_US) != drvNoError) return drvHwError;
+        while(_gppin_get(port, TWI_SCL_PIN) == 0){
+            if(timeout_check(&to, timeoutSiteTwiRecover) != drvNoError) return drvHwError;
+        }
+        if(twiHalfBit() != drvNoError) return drvHwError;
+    }
+    //STOP condition: SDA rises while SCL is high
+    _gppin_dirOut(port, TWI_SCL_PIN);
+    if(twiHalfBit() != drvNoError) return drvHwError;
+    _gppin_dirOut(port, TWI_SDA_PIN);
+    if(twiHalfBit() != drvNoError) return drvHwError;
+    _gppin_dirIn(port, TWI_SCL_PIN);
+    if(twiHalfBit() != drvNoError) return drvHwError;
+    _gppin_dirIn(port, TWI_SDA_PIN);
+    if(twiHalfBit() != drvNoError) return drvHwError;
+    if((_gppin_get(port, TWI_SDA_PIN) == 0) || (_gppin_get(port, TWI_SCL_PIN) == 0)){
+        return drvHwError;
+    }
+    TWI0.MCTRLA = mctrla;
+    if(mctrla & TWI_ENABLE_bm){
+        TWI0.MSTATUS = TWI_BUSSTATE_IDLE_gc;
+    }
+    
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Set baud rate for the highest SCL not above the limit
+* @param    hz - system clock
+* @note     SCL = CLK / (10 + 2 * BAUD + CLK * Trise)
+*/
+eDrvError twiApplyScl(uint32_t hz){
+    uint32_t div, rise;
+    uint8_t ctrla;
+    
+    rise = (hz / 1000UL) * TWI_RISE_NS / 1000000UL;
+    div = (hz + twiSclHz - 1) / twiSclHz;
+    if(div < TWI_BAUD_OFFSET + rise){
+        div = TWI_BAUD_OFFSET + rise;
+    }
+    div = (div - TWI_BAUD_OFFSET - rise + 1) >> 1;
+    if(div > UINT8_MAX){
+        return drvHwError;
+    }
+    ctrla = TWI0.CTRLA & ~TWI_FMPEN_bm;
+    if(twiSclHz > TWI_FM_HZ){
+        ctrla |= 1 << TWI_FMPEN_bp;
+    }
+    TWI0.CTRLA = ctrla;
+    TWI0.MBAUD = (uint8_t)div;
+    
+    return drvNoError;
+}
+
+/*!****************************************************************************
+* @brief    Re-time SCL to the new system clock
+* @param    ev - before or after the switch
+* @param    hzOld - clock before the switch
+* @param    hzNew - clock after the switch
+*/
+eDrvError twiRetime(eClockEv ev, uint32_t hzOld, uint32_t hzNew){
+    (void)hzOld;
+    if(ev != clockEvPost){
+        return drvNoError;
+    }
+    
+    return twiApplyScl(hzNew);
+}
+
+/*!****************************************************************************
+* @brief    Start transaction at queue head, called with interrupts disabled
+*/
+void twiStart(void){
+    twiXfer_type *pXfer = twiHead;
+    
+    //Master runs on CLK_PER
+    sleepctrl_setLimit(sleepUserTwi, SLPCTRL_SMODE_IDLE_gc);
+    swtimer_start(&twiTim, SWTIMER_US_TO_TICKS(TWI_XFER_TIMEOUT_US) + 1, 0, twiTimeout, NULL);
+    twiIdx = 0;
+    if(pXfer->txLen != 0){
+        twiIsRxPhase = false;
+        TWI0.MADDR = pXfer->addr << 1;
+    }else{
+        twiIsRxPhase = true;
+        TWI0.MADDR = (pXfer->addr << 1) | TWI_DIR_READ;
+    }
+}
+
+/*!****************************************************************************
+* @brief    Complete transaction at queue head and start the next one
+* @param    status - transaction result
+*/
+void twiFinish(eDrvError status){
+    twiXfer_type *pXfer = twiHead;
+    
+    swtimer_cancel(&twiTim);
+    twiHead = pXfer->pNext;
+    if(twiHead == NULL){
+        twiTail = NULL;
+    }
+    pXfer->status = status;
+    pXfer->isDone = true;
+    if(pXfer->cb != NULL){
+        pXfer->cb(pXfer);
+    }
+    if(twiHead != NULL){
+        twiStart();
+    }else{
+        sleepctrl_clearLimit(sleepUserTwi);
+    }
+}
+
+/*!****************************************************************************
+* @brief    Transaction took too long (clock held by slave or lost interrupt)
+* @param    *pArg - not used
+* @note     Called from software timer ISR. Bus may need twi_recover()
+*/
+void twiTimeout(void *pArg){
+    (void)pArg;
+    if(twiHead == NULL){
+        return;
+    }
+    twiAbort(twiHead);
+}
+
+/*!****************************************************************************
+* @brief    Finish transaction with drvHwError wherever it is in the queue
+* @param    *pXfer - transaction
+* @note     Called with interrupts disabled. Master is flushed if the
+*           transaction is in progress, a finished one is left as it is
+*/
+void twiAbort(twiXfer_type *pXfer){
+    twiXfer_type *p;
+    
+    if(pXfer->isDone){
+        return;
+    }
+    if(pXfer == twiHead){
+        TWI0.MCTRLB = TWI_FLUSH_bm;
+        TWI0.MSTATUS = TWI_BUSSTATE_IDLE_gc;
+        twiFinish(drvHwError);
+        return;
+    }
+    for(p = twiHead; (p != NULL) && (p->pNext != pXfer); p = p->pNext);
+    if(p == NULL){
+        return;
+    }
+    p->pNext = pXfer->pNext;
+    if(twiTail == pXfer){
+        twiTail = p;
+    }
+    pXfer->pNext = NULL;
+    pXfer->status = drvHwError;
+    pXfer->isDone = true;
+    if(pXfer->cb != NULL){
+        pXfer->cb(pXfer);
+    }
+}
+
+/*!****************************************************************************
+* @brief    Half of SCL period for bus recovery
+*/
+eDrvError twiHalfBit(void){
+    timeout_type to;
+    
+    if(timeout_start(&to, TWI_RECOVER_HALF_US) != drvNoError) return drvHwError;
+    while(timeout_check(&to, timeoutSiteNum) == drvNoError);
+    
+    return drvNoError;
+}
+
+/*!****************************************************************************
+* @brief    TWI0 master interrupt, one step of the transaction
+*/
+ISR(TWI0_TWIM_vect){
+    traceScope(traceIdIsrTwim);
+    twiXfer_type *pXfer = twiHead;
+    uint8_t status;
+    
+    status = TWI0.MSTATUS;
+    if(pXfer == NULL){
+        TWI0.MSTATUS = TWI_RIF_bm | TWI_WIF_bm;
+        return;
+    }
+    //Arbitration lost or misplaced START/STOP, bus is released by hardware
+    if(status & (TWI_ARBLOST_bm | TWI_BUSERR_bm)){
+        TWI0.MSTATUS = TWI_RIF_bm | TWI_WIF_bm | TWI_ARBLOST_bm | TWI_BUSERR_bm;
+        twiFinish(drvHwError);
+        return;
+    }
+    if(status & TWI_RIF_bm){
+        //Byte received, ACK for more, NACK and STOP after the last one
+        pXfer->pRx[twiIdx++] = TWI0.MDATA;
+        if(twiIdx < pXfer->rxLen){
+            TWI0.MCTRLB = TWI_MCMD_RECVTRANS_gc;
+        }else{
+            TWI0.MCTRLB = TWI_ACKACT_bm | TWI_MCMD_STOP_gc;
+            twiFinish(drvNoError);
+        }
+        return;
+    }
+    //Address or data byte sent
+    if(status & TWI_RXACK_bm){
+        TWI0.MCTRLB = TWI_MCMD_STOP_gc;
+        twiFinish(drvHwError);
+    }else if(twiIsRxPhase){
+        //Write flag in read phase is an address NACK handled above
+        TWI0.MSTATUS = TWI_WIF_bm;
+    }else if(twiIdx < pXfer->txLen){
+        TWI0.MDATA = pXfer->pTx[twiIdx++];
+    }else if(pXfer->rxLen != 0){
+        twiIdx = 0;
+        twiIsRxPhase = true;
+        TWI0.MADDR = (pXfer->addr << 1) | TWI_DIR_READ;
+    }else{
+        TWI0.MCTRLB = TWI_MCMD_STOP_gc;
+        twiFinish(drvNoError);
+    }
+}
+
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
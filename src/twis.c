@@ -0,0 +1,193 @@
+/*!****************************************************************************
+* @file    twis.c
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   TWI (I2C) slave driver with register map emulation
+*/
+
+/*!****************************************************************************
+* Include
+*/
+#include "twis.h"
+#include "sleepctrl.h"
+#include "trace.h"
+
+/*!****************************************************************************
+* Local function prototypes
+*/
+bool twisIsWritable(uint8_t reg);
+void twisFlush(void);
+void twisEnd(void);
+
+/*!****************************************************************************
+* MEMORY
+*/
+uint8_t *twisMap;                                                               //Register map, application owned
+const uint8_t *twisWrMask;                                                      //Writable registers bitmap, NULL - all
+uint8_t twisSize;                                                               //Registers in map
+twisCb_type twisCb;                                                             //Write completion callback
+uint8_t twisPtr;                                                                //Register pointer, auto-incremented
+uint8_t twisWrFirst;                                                            //First register written in transaction
+uint8_t twisWrLen;                                                              //Registers written in transaction
+bool twisIsPtrByte;                                                             //Next byte written is register pointer
+bool twisIsFirstRead;                                                           //No byte sent yet in read
+
+/*!****************************************************************************
+* @brief    Initialize TWI0 as slave exposing register map
+* @param    addr - 7-bit slave address
+* @param    *pMap - registers, read and written by ISR in place
+* @param    size - registers in map
+* @param    *pWrMask - bit per register (LSB first) set for writable ones,
+*                      NULL if all are writable
+* @param    fmPlus - Fm+ drive for 1 MHz hosts
+* @param    cb - write completion callback (optional)
+* @note     Master writes register pointer first, then data. Reads start at the
+*           pointer. Both auto-increment. Multi-byte values updated by
+*           application while host may read them need an atomic section
+*/
+eDrvError twis_init(uint8_t addr, uint8_t *pMap, uint8_t size, const uint8_t *pWrMask, bool fmPlus, twisCb_type cb){
+    eDrvError exitStatus = drvUnknownError;
+    
+    //Check inputs
+    if((addr > TWIS_ADDR_MAX) || (pMap == NULL) || (size == 0)){
+        return drvBadParameter;
+    }
+    TWI0.SCTRLA = 0;
+    twisMap = pMap;
+    twisSize = size;
+    twisWrMask = pWrMask;
+    twisCb = cb;
+    twisPtr = 0;
+    twisEnd();
+    if(fmPlus){
+        TWI0.CTRLA |= TWI_FMPEN_bm;
+    }else{
+        TWI0.CTRLA &= ~TWI_FMPEN_bm;
+    }
+    TWI0.SADDR = addr << 1;
+    TWI0.SADDRMASK = 0;
+    TWI0.SSTATUS = TWI_DIF_bm | TWI_APIF_bm | TWI_COLL_bm | TWI_BUSERR_bm;
+    TWI0.SCTRLA = (1 << TWI_DIEN_bp) | (1 << TWI_APIEN_bp) | (1 << TWI_PIEN_bp) | (1 << TWI_ENABLE_bp);
+    
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Disable TWI0 slave
+*/
+eDrvError twis_stop(void){
+    eDrvError exitStatus = drvUnknownError;
+    
+    TWI0.SCTRLA = 0;
+    twisEnd();
+    
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Check write permission of register
+* @param    reg - register number within map
+*/
+bool twisIsWritable(uint8_t reg){
+    if(reg >= twisSize){
+        return false;
+    }
+    if(twisWrMask == NULL){
+        return true;
+    }
+    
+    return (twisWrMask[reg >> 3] & (1 << (reg & 0x07))) ? true : false;
+}
+
+/*!****************************************************************************
+* @brief    Report registers written so far
+*/
+void twisFlush(void){
+    if((twisWrLen != 0) && (twisCb != NULL)){
+        twisCb(twisWrFirst, twisWrLen);
+    }
+    twisWrLen = 0;
+}
+
+/*!****************************************************************************
+* @brief    Reset transaction state, core may sleep deeper again
+*/
+void twisEnd(void){
+    twisIsPtrByte = true;
+    twisIsFirstRead = true;
+    twisWrLen = 0;
+    sleepctrl_clearLimit(sleepUserTwis);
+}
+
+/*!****************************************************************************
+* @brief    TWI0 slave interrupt, data goes to and from the map directly
+* @note     Address match wakes the core from any sleep mode, the transaction
+*           itself needs CLK_PER
+*/
+ISR(TWI0_TWIS_vect){
+    traceScope(traceIdIsrTwis);
+    uint8_t status, data;
+    
+    status = TWI0.SSTATUS;
+    if(status & (TWI_COLL_bm | TWI_BUSERR_bm)){
+        TWI0.SSTATUS = TWI_COLL_bm | TWI_BUSERR_bm;
+        TWI0.SCTRLB = TWI_SCMD_COMPTRANS_gc;
+        twisEnd();
+        return;
+    }
+    if(status & TWI_APIF_bm){
+        if(status & TWI_AP_bm){
+            //Address match, read after repeated start keeps the pointer written before
+            sleepctrl_setLimit(sleepUserTwis, SLPCTRL_SMODE_IDLE_gc);
+            if((status & TWI_DIR_bm) == 0){
+                twisFlush();
+                twisIsPtrByte = true;
+            }
+            twisIsFirstRead = true;
+            TWI0.SCTRLB = TWI_SCMD_RESPONSE_gc;
+        }else{
+            //STOP
+            twisFlush();
+            TWI0.SCTRLB = TWI_SCMD_COMPTRANS_gc;
+            twisEnd();
+        }
+        return;
+    }
+    if((status & TWI_DIF_bm) == 0){
+        return;
+    }
+    if(status & TWI_DIR_bm){
+        //Master read, NACK on previous byte ends it
+        if(!twisIsFirstRead && (status & TWI_RXACK_bm)){
+            TWI0.SCTRLB = TWI_SCMD_COMPTRANS_gc;
+            return;
+        }
+        twisIsFirstRead = false;
+        if(twisPtr < twisSize){
+            TWI0.SDATA = twisMap[twisPtr++];
+        }else{
+            TWI0.SDATA = TWIS_READ_PAD;
+        }
+        TWI0.SCTRLB = TWI_SCMD_RESPONSE_gc;
+    }else{
+        //Master write, NACK on pointer or register out of map or read-only
+        data = TWI0.SDATA;
+        if(twisIsPtrByte){
+            twisIsPtrByte = false;
+            twisPtr = data;
+            twisWrFirst = data;
+            TWI0.SCTRLB = (data < twisSize) ? TWI_SCMD_RESPONSE_gc : (TWI_ACKACT_bm | TWI_SCMD_RESPONSE_gc);
+        }else if(twisIsWritable(twisPtr)){
+            twisMap[twisPtr++] = data;
+            twisWrLen++;
+            TWI0.SCTRLB = TWI_SCMD_RESPONSE_gc;
+        }else{
+            TWI0.SCTRLB = TWI_ACKACT_bm | TWI_SCMD_COMPTRANS_gc;
+        }
+    }
+}
+
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
@@ -3,25 +3,184 @@
  * @author  4eef
  * @version V1.0
  * @date    November 5, 2023
- * @brief   
+ * @brief   Asynchronous USART0 driver, 8N1
  */
 
 /*!****************************************************************************
  * Include
  */
 #include "usart.h"
+#include "clock.h"
+#include "sleepctrl.h"
 
 /*!****************************************************************************
  * Local function prototypes
  */
+eDrvError usartApplyBaud(uint32_t hz);
+eDrvError usartRetime(eClockEv ev, uint32_t hzOld, uint32_t hzNew);
 
 /*!****************************************************************************
  * MEMORY
  */
+uint32_t usartBaud;                                                             //Baud rate set by caller
 
 /*!****************************************************************************
- * @brief    
- * @param    
+ * @brief    Initialize USART0 in asynchronous mode, 8 data bits, no parity, 1 stop
+ * @param    baud - baud rate
+ * @note     Pins are set up by caller. BAUD follows system clock changes made
+ *           by clock_set()
  */
+eDrvError usart_init(uint32_t baud){
+    eDrvError exitStatus = drvUnknownError;
+    
+    //Check inputs
+    if(baud == 0){
+        return drvBadParameter;
+    }
+    USART0.CTRLB &= ~(USART_RXEN_bm | USART_TXEN_bm);
+    USART0.CTRLA = 0;                                                           //Interrupts off
+    USART0.CTRLC = USART_CMODE_ASYNCHRONOUS_gc | USART_PMODE_DISABLED_gc | USART_SBMODE_1BIT_gc | USART_CHSIZE_8BIT_gc;
+    exitStatus = usart_setBaud(baud);
+    if(exitStatus != drvNoError) return exitStatus;
+    if(clock_register(usartRetime) != drvNoError) return drvHwError;
+    //Receiver needs CLK_PER running for start bit detection
+    if(sleepctrl_setLimit(sleepUserUsart, SLPCTRL_SMODE_IDLE_gc) != drvNoError) return drvHwError;
+    USART0.CTRLB |= USART_RXEN_bm | USART_TXEN_bm;
+    
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+ * @brief    Change baud rate
+ * @param    baud - baud rate
+ * @return   drvBadParameter if the rate can't be reached at current clock
+ */
+eDrvError usart_setBaud(uint32_t baud){
+    eDrvError exitStatus = drvUnknownError;
+    uint32_t hz, baudOld;
+    
+    //Check inputs
+    if(baud == 0){
+        return drvBadParameter;
+    }
+    if(clock_getHz(&hz) != drvNoError){
+        return drvHwError;
+    }
+    baudOld = usartBaud;
+    usartBaud = baud;
+    if(usartApplyBaud(hz) != drvNoError){
+        usartBaud = baudOld;
+        return drvBadParameter;
+    }
+    
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+ * @brief    Transmit portion of data, blocking until the last frame is sent
+ * @param    *pTxData - source array
+ * @param    size - number of bytes
+ */
+eDrvError usart_transmit(uint8_t *pTxData, uint16_t size){
+    eDrvError exitStatus = drvUnknownError;
+    timeout_type to;
+    uint16_t i;
+    
+    //Perform checks
+    if(!(USART0.CTRLB & USART_TXEN_bm)){
+        return drvHwError;
+    }
+    if((pTxData == NULL) || (size == 0)){
+        return drvBadParameter;
+    }
+    //Twice the frame time per byte
+    if(timeout_start(&to, ((uint32_t)size + 1) * (2 * USART_FRAME_BITS * 1000000UL / usartBaud + 1)) != drvNoError) return drvHwError;
+    USART0.STATUS = USART_TXCIF_bm;
+    for(i = 0; i < size; i++){
+        while(!(USART0.STATUS & USART_DREIF_bm)){
+            if(timeout_check(&to, timeoutSiteUsartTx) != drvNoError) return drvHwError;
+        }
+        USART0.TXDATAL = *pTxData;
+        pTxData++;
+    }
+    while(!(USART0.STATUS & USART_TXCIF_bm)){
+        if(timeout_check(&to, timeoutSiteUsartTx) != drvNoError) return drvHwError;
+    }
+    
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+ * @brief    Receive portion of data
+ * @param    *pRxData - destination array
+ * @param    size - number of bytes
+ */
+eDrvError usart_receive(uint8_t *pRxData, uint16_t size){
+    eDrvError exitStatus = drvUnknownError;
+    timeout_type to;
+    uint16_t i;
+    
+    //Perform checks
+    if(!(USART0.CTRLB & USART_RXEN_bm)){
+        return drvHwError;
+    }
+    if((pRxData == NULL) || (size == 0)){
+        return drvBadParameter;
+    }
+    if(timeout_start(&to, (uint32_t)size * USART_RX_TIMEOUT_US) != drvNoError) return drvHwError;
+    for(i = 0; i < size; i++){
+        while(!(USART0.STATUS & USART_RXCIF_bm)){
+            if(timeout_check(&to, timeoutSiteUsartRx) != drvNoError) return drvHwError;
+        }
+        *pRxData = USART0.RXDATAL;
+        pRxData++;
+    }
+    
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+ * @brief    Set BAUD register for the baud rate at system clock
+ * @param    hz - system clock
+ * @note     Double speed mode is used only if normal mode can't reach the rate
+ */
+eDrvError usartApplyBaud(uint32_t hz){
+    uint32_t baudReg;
+    uint8_t rxMode;
+    
+    //BAUD = 64 x f / (S x baud), S = 16 in normal mode
+    rxMode = USART_RXMODE_NORMAL_gc;
+    baudReg = (4 * hz + usartBaud / 2) / usartBaud;
+    if(baudReg < USART_BAUD_MIN){
+        rxMode = USART_RXMODE_CLK2X_gc;
+        baudReg = (8 * hz + usartBaud / 2) / usartBaud;
+    }
+    if((baudReg < USART_BAUD_MIN) || (baudReg > UINT16_MAX)){
+        return drvHwError;
+    }
+    USART0.BAUD = baudReg;
+    USART0.CTRLB = (USART0.CTRLB & ~USART_RXMODE_gm) | rxMode;
+    
+    return drvNoError;
+}
+
+/*!****************************************************************************
+ * @brief    Re-time baud rate to the new system clock
+ * @param    ev - before or after the switch
+ * @param    hzOld - clock before the switch
+ * @param    hzNew - clock after the switch
+ */
+eDrvError usartRetime(eClockEv ev, uint32_t hzOld, uint32_t hzNew){
+    (void)hzOld;
+    if(ev != clockEvPost){
+        return drvNoError;
+    }
+    
+    return usartApplyBaud(hzNew);
+}
 
 /***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
@@ -0,0 +1,201 @@
+/*!****************************************************************************
+* @file    vref.c
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Voltage reference (VREF) arbitration for ADC, DAC and AC
+*/
+
+/*!****************************************************************************
+* Include
+*/
+#include "vref.h"
+#include "swtimer.h"
+#include <util/atomic.h>
+
+/*!****************************************************************************
+* Local define
+*/
+#define VREF_SEL_MASK                           0x07
+
+/*!****************************************************************************
+* Local function prototypes
+*/
+eDrvError vrefNowUs(uint32_t *pUs);
+
+/*!****************************************************************************
+* MEMORY
+*/
+vrefUser_type vrefUser[vrefUserNum];
+//Selection register, field position and enable bit of every user
+volatile uint8_t * const vrefSelReg[vrefUserNum] = {
+    [vrefUserAdc0] = &VREF.CTRLA,
+#if (DEV_ADC_NUM > 1)
+    [vrefUserAdc1] = &VREF.CTRLC,
+#endif
+    [vrefUserDac0] = &VREF.CTRLA,
+#if (DEV_DAC_NUM > 1)
+    [vrefUserDac1] = &VREF.CTRLC,
+#endif
+#if (DEV_DAC_NUM > 2)
+    [vrefUserDac2] = &VREF.CTRLD,
+#endif
+};
+const uint8_t vrefSelPos[vrefUserNum] = {
+    [vrefUserAdc0] = 4,
+#if (DEV_ADC_NUM > 1)
+    [vrefUserAdc1] = 4,
+#endif
+    [vrefUserDac0] = 0,
+#if (DEV_DAC_NUM > 1)
+    [vrefUserDac1] = 0,
+#endif
+#if (DEV_DAC_NUM > 2)
+    [vrefUserDac2] = 0,
+#endif
+};
+const uint8_t vrefEnBm[vrefUserNum] = {
+    [vrefUserAdc0] = VREF_ADC0REFEN_bm,
+#if (DEV_ADC_NUM > 1)
+    [vrefUserAdc1] = VREF_ADC1REFEN_bm,
+#endif
+    [vrefUserDac0] = VREF_DAC0REFEN_bm,
+#if (DEV_DAC_NUM > 1)
+    [vrefUserDac1] = VREF_DAC1REFEN_bm,
+#endif
+#if (DEV_DAC_NUM > 2)
+    [vrefUserDac2] = VREF_DAC2REFEN_bm,
+#endif
+};
+const uint16_t vrefMv[vrefSelNum] = {550, 1100, 2500, 4340, 1500};
+
+/*!****************************************************************************
+* @brief    Select reference and keep it enabled until released
+* @param    user - reference selection field
+* @param    sel - reference voltage
+* @return   drvHwError if other driver holds a different selection of the field
+* @note     Each call must be paired with vref_release(). Fields are updated
+*           with read-modify-write under interrupt lock, so changes of one
+*           field don't disturb the others sharing the register
+*/
+eDrvError vref_request(eVrefUser user, eVrefSel sel){
+    eDrvError exitStatus = drvUnknownError;
+    vrefUser_type *pUser;
+    volatile uint8_t *pReg;
+    uint32_t now;
+
+    //Check inputs
+    if((user >= vrefUserNum) || (sel >= vrefSelNum)){
+        return drvBadParameter;
+    }
+    //Settling is timed by the software timer
+    if(swtimer_init() != drvNoError) return drvHwError;
+    if(vrefNowUs(&now) != drvNoError) return drvHwError;
+    pUser = &vrefUser[user];
+    pReg = vrefSelReg[user];
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        if(pUser->sel == sel + 1){
+            pUser->holders++;
+            exitStatus = drvNoError;
+        }else if(pUser->holders != 0){
+            exitStatus = drvHwError;
+        }else{
+            *pReg = (*pReg & ~(VREF_SEL_MASK << vrefSelPos[user])) | (sel << vrefSelPos[user]);
+            VREF.CTRLB |= vrefEnBm[user];
+            pUser->sel = sel + 1;
+            pUser->holders = 1;
+            pUser->readyUs = now + VREF_SETTLE_US;
+            exitStatus = drvNoError;
+        }
+    }
+
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Release reference, it is powered down after the last holder
+* @param    user - reference selection field
+*/
+eDrvError vref_release(eVrefUser user){
+    eDrvError exitStatus = drvUnknownError;
+    vrefUser_type *pUser;
+
+    //Check inputs
+    if(user >= vrefUserNum){
+        return drvBadParameter;
+    }
+    pUser = &vrefUser[user];
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        if(pUser->holders == 0){
+            exitStatus = drvBadParameter;
+        }else{
+            pUser->holders--;
+            if(pUser->holders == 0){
+                VREF.CTRLB &= ~vrefEnBm[user];
+                pUser->sel = VREF_SEL_NONE;
+            }
+            exitStatus = drvNoError;
+        }
+    }
+
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Wait until requested reference has settled
+* @param    user - reference selection field
+* @note     Returns at once for a reference settled before
+*/
+eDrvError vref_waitReady(eVrefUser user){
+    eDrvError exitStatus = drvUnknownError;
+    uint32_t now, readyUs;
+
+    //Check inputs
+    if((user >= vrefUserNum) || (vrefUser[user].holders == 0)){
+        return drvBadParameter;
+    }
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        readyUs = vrefUser[user].readyUs;
+    }
+    do{
+        if(vrefNowUs(&now) != drvNoError) return drvHwError;
+    }while((int32_t)(readyUs - now) > 0);
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Get reference voltage
+* @param    sel - reference selection
+* @param    *pMv - pointer to store voltage in millivolts to
+*/
+eDrvError vref_getMv(eVrefSel sel, uint16_t *pMv){
+    eDrvError exitStatus = drvUnknownError;
+
+    //Check inputs
+    if((sel >= vrefSelNum) || (pMv == NULL)){
+        return drvBadParameter;
+    }
+    *pMv = vrefMv[sel];
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Current time in microseconds from the software timer
+* @param    *pUs - pointer to store time to
+*/
+eDrvError vrefNowUs(uint32_t *pUs){
+    uint64_t stamp;
+
+    if(swtimer_getStamp(&stamp) != drvNoError){
+        return drvHwError;
+    }
+    *pUs = SWTIMER_STAMP_TO_US(stamp);
+
+    return drvNoError;
+}
+
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
@@ -10,16 +10,55 @@
 * Include
 */
 #include "watchdog.h"
+#include <util/atomic.h>
+
+/*!****************************************************************************
+* Local function prototypes
+*/
+void watchdogRecord(uint16_t pending);
+
+/*!****************************************************************************
+* MEMORY
+*/
+watchdogRec_type watchdogRec __attribute__((section(".noinit")));               //Survives the watchdog reset
+uint8_t watchdogCulprit = WATCHDOG_CULPRIT_NONE;                                //Culprit of previous reset
+bool watchdogIsCulpritValid;
+uint16_t watchdogTasks;                                                         //Registered tasks
+volatile uint16_t watchdogChecked;                                              //Tasks checked in this window
+uint32_t watchdogWindowCnt;                                                     //Closed window, time base counts
+uint32_t watchdogRefreshCnt;                                                    //Time base at last refresh
 
 /*!****************************************************************************
 * @brief    Initialize watchdog and start counting
 * @param    period - period to reset the watchdog, or it will issue system reset
 * @param    window - (optionally) window period to reset watchdog
+* @note     Culprit recorded before the previous reset is taken over first
 */
 eDrvError watchdog_init(WDT_PERIOD_t period, WDT_WINDOW_t window){
     eDrvError exitStatus = drvUnknownError;
     uint8_t reg;
     
+    //Record of previous run
+    if((watchdogRec.magic == WATCHDOG_NOINIT_MAGIC) && ((uint16_t)(watchdogRec.pending ^ watchdogRec.pendingInv) == UINT16_MAX)){
+        watchdogIsCulpritValid = true;
+        watchdogCulprit = WATCHDOG_CULPRIT_NONE;
+        for(reg = 0; reg < WATCHDOG_TASK_NUM; reg++){
+            if(watchdogRec.pending & (1U << reg)){
+                watchdogCulprit = reg;
+                break;
+            }
+        }
+    }
+    watchdogTasks = 0;
+    watchdogChecked = 0;
+    watchdogRecord(0);
+    //Closed window is timed on the shared time base
+    if(swtimer_init() != drvNoError) return drvHwError;
+    watchdogWindowCnt = 0;
+    if(window != WDT_WINDOW_OFF_gc){
+        watchdogWindowCnt = (WATCHDOG_CLK_US << ((window >> WDT_WINDOW_gp) - 1)) * (100 + WATCHDOG_WINDOW_MARGIN_PCT) / 100 * (SWTIMER_CLK_HZ / 1000000UL);
+    }
+    if(swtimer_getCnt(&watchdogRefreshCnt) != drvNoError) return drvHwError;
     //Perform initialization
     reg = window | period;
     _PROTECTED_WRITE(WDT.CTRLA, reg);
@@ -34,10 +73,15 @@ eDrvError watchdog_init(WDT_PERIOD_t period, WDT_WINDOW_t window){
 
 /*!****************************************************************************
 * @brief    Refresh watchdog timer to prevent SW reset
+* @note     Once tasks are registered the refresh goes through the supervisor,
+*           so a single live code path can't keep the unit alive
 */
 eDrvError watchdog_refresh(void){
     eDrvError exitStatus = drvUnknownError;
     
+    if(watchdogTasks != 0){
+        return watchdog_supervise();
+    }
     //Perform reset
     wdt_reset();
 
@@ -45,4 +89,123 @@ eDrvError watchdog_refresh(void){
     return exitStatus;
 }
 
+/*!****************************************************************************
+* @brief    Add task to the supervised ones
+* @param    taskId - task number (0..WATCHDOG_TASK_NUM - 1)
+* @note     Task counts as checked in for the current window
+*/
+eDrvError watchdog_taskRegister(uint8_t taskId){
+    eDrvError exitStatus = drvUnknownError;
+    
+    //Check inputs
+    if(taskId >= WATCHDOG_TASK_NUM){
+        return drvBadParameter;
+    }
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        watchdogTasks |= 1U << taskId;
+        watchdogChecked |= 1U << taskId;
+    }
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Remove task from the supervised ones
+* @param    taskId - task number
+*/
+eDrvError watchdog_taskUnregister(uint8_t taskId){
+    eDrvError exitStatus = drvUnknownError;
+    
+    //Check inputs
+    if(taskId >= WATCHDOG_TASK_NUM){
+        return drvBadParameter;
+    }
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        watchdogTasks &= ~(1U << taskId);
+        watchdogChecked &= ~(1U << taskId);
+    }
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Report task is alive, safe from interrupts
+* @param    taskId - task number
+*/
+eDrvError watchdog_checkIn(uint8_t taskId){
+    eDrvError exitStatus = drvUnknownError;
+    
+    //Check inputs
+    if(taskId >= WATCHDOG_TASK_NUM){
+        return drvBadParameter;
+    }
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        watchdogChecked |= 1U << taskId;
+    }
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Refresh hardware watchdog if all tasks have checked in and the
+*           window is open, to be called often (main loop or timer)
+* @note     Tasks still missing are kept in .noinit RAM, so if the watchdog
+*           resets the unit, the culprit is known on next boot
+*/
+eDrvError watchdog_supervise(void){
+    eDrvError exitStatus = drvUnknownError;
+    uint32_t now;
+    uint16_t pending;
+    
+    if(swtimer_getCnt(&now) != drvNoError){
+        return drvHwError;
+    }
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+        pending = watchdogTasks & ~watchdogChecked;
+        if((pending == 0) && ((now - watchdogRefreshCnt) >= watchdogWindowCnt)){
+            wdt_reset();
+            watchdogRefreshCnt = now;
+            watchdogChecked = 0;
+            pending = watchdogTasks;
+        }
+        watchdogRecord(pending);
+    }
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Get task which missed its check-in before the previous reset
+* @param    *pTaskId - task number, WATCHDOG_CULPRIT_NONE if all had checked in
+* @param    *pIsValid - false if there is no record (e.g. power-on)
+* @note     Meaningful after a watchdog reset, see RSTCTRL.RSTFR
+*/
+eDrvError watchdog_getCulprit(uint8_t *pTaskId, bool *pIsValid){
+    eDrvError exitStatus = drvUnknownError;
+    
+    //Check inputs
+    if((pTaskId == NULL) || (pIsValid == NULL)){
+        return drvBadParameter;
+    }
+    *pTaskId = watchdogCulprit;
+    *pIsValid = watchdogIsCulpritValid;
+
+    exitStatus = drvNoError;
+    return exitStatus;
+}
+
+/*!****************************************************************************
+* @brief    Keep tasks not checked in yet in .noinit RAM
+* @param    pending - tasks mask
+*/
+void watchdogRecord(uint16_t pending){
+    watchdogRec.pending = pending;
+    watchdogRec.pendingInv = ~pending;
+    watchdogRec.magic = WATCHDOG_NOINIT_MAGIC;
+}
+
 /***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
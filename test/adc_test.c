@@ -0,0 +1,107 @@
+/*!****************************************************************************
+* @file    adc_test.c
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   ADC sampling against the register-level model
+*/
+
+/*!****************************************************************************
+* Include
+*/
+#include "adc.h"
+#include "sleepctrl.h"
+#include "vref.h"
+#include "sim.h"
+#include "test_check.h"
+
+/*!****************************************************************************
+* Local define
+*/
+#define TEST_AIN                                3
+#define TEST_VALUE                              613
+#define TEST_OVERHEAD_CYC                       200                             //Polling overhead allowed per conversion
+
+/*!****************************************************************************
+* @brief    Result, accumulation and conversion time follow channel settings
+*/
+static void testSample(void){
+    adcChannel_type ch = adcChInit(ADC0, ADC_INITDLY_DLY0_gc, ADC_MUXPOS_AIN3_gc, 0, 0, 0, ADC_PRESC_DIV16_gc,
+                                   ADC_REFSEL_VDDREF_gc, VREF_ADC_REFSEL_1V1_gc, ADC_SAMPNUM_ACC4_gc, ADC_WINCM_NONE_gc);
+    uint32_t convCyc;
+    uint16_t data, refMv;
+    uint8_t overSampled;
+
+    sim_setAdcInput(0, TEST_AIN, TEST_VALUE);
+    sim_clearStat();
+    CHECK(adc_getSample(ch, &data, &overSampled, &refMv) == drvNoError);
+    CHECK(data == TEST_VALUE * 4);
+    CHECK(overSampled == ADC_OVERSAMPLING_2);
+    CHECK(refMv == ADC_VREF_VDD);
+    //(SAMPLEN + 2 + 10) ADC clocks of 16 cycles, 4 samples per conversion
+    convCyc = (0 + 2 + 10) * 16 * 4;
+    CHECK(simStat.cycles >= ADC_MEASUREMENTS_NUM * convCyc);
+    CHECK(simStat.cycles <= ADC_MEASUREMENTS_NUM * (convCyc + TEST_OVERHEAD_CYC));
+    //Single sample
+    ch.smpAccNum = ADC_SAMPNUM_ACC1_gc;
+    CHECK(adc_getSample(ch, &data, &overSampled, &refMv) == drvNoError);
+    CHECK(data == TEST_VALUE);
+}
+
+/*!****************************************************************************
+* @brief    Internal reference is held while in use and waited for once
+*/
+static void testIntRef(void){
+    adcChannel_type ch = adcChInit(ADC0, ADC_INITDLY_DLY0_gc, ADC_MUXPOS_AIN3_gc, 0, 0, 0, ADC_PRESC_DIV2_gc,
+                                   ADC_REFSEL_INTREF_gc, VREF_ADC_REFSEL_2V5_gc, ADC_SAMPNUM_ACC1_gc, ADC_WINCM_NONE_gc);
+    uint64_t first;
+    uint16_t data, refMv;
+    uint8_t overSampled;
+
+    sim_clearStat();
+    CHECK(adc_getSample(ch, &data, &overSampled, &refMv) == drvNoError);
+    CHECK(refMv == ADC_VREF_2V5);
+    CHECK(VREF.CTRLB & VREF_ADC0REFEN_bm);
+    CHECK((VREF.CTRLA & VREF_ADC0REFSEL_gm) == VREF_ADC_REFSEL_2V5_gc);
+    first = simStat.cycles;
+    CHECK(first >= sim_usToCyc(VREF_SETTLE_US));
+    //Settled reference is not waited for again
+    sim_clearStat();
+    CHECK(adc_getSample(ch, &data, &overSampled, &refMv) == drvNoError);
+    CHECK(simStat.cycles < first / 2);
+}
+
+/*!****************************************************************************
+* @brief    Free running window compare limits sleep depth, single shot not
+*/
+static void testSleepLimit(void){
+    adcChannel_type ch = adcChInit(ADC0, ADC_INITDLY_DLY0_gc, ADC_MUXPOS_AIN3_gc, 0, 0, 0, ADC_PRESC_DIV2_gc,
+                                   ADC_REFSEL_VDDREF_gc, VREF_ADC_REFSEL_1V1_gc, ADC_SAMPNUM_ACC1_gc, ADC_WINCM_NONE_gc);
+    SLPCTRL_SMODE_t mode;
+    uint16_t data, refMv;
+    uint8_t overSampled;
+
+    ch.freerun = 1;
+    ch.wndCmp = ADC_WINCM_ABOVE_gc;
+    CHECK(adc_getSample(ch, &data, &overSampled, &refMv) == drvNoError);
+    CHECK(sleepctrl_getMode(&mode) == drvNoError);
+    CHECK(mode == SLPCTRL_SMODE_IDLE_gc);
+    ch.freerun = 0;
+    ch.wndCmp = ADC_WINCM_NONE_gc;
+    CHECK(adc_getSample(ch, &data, &overSampled, &refMv) == drvNoError);
+    CHECK(sleepctrl_getMode(&mode) == drvNoError);
+    CHECK(mode == SLPCTRL_SMODE_PDOWN_gc);
+}
+
+int main(void){
+    sim_reset();
+    sei();
+    CHECK(adc_init(&ADC0, ADC_RESSEL_10BIT_gc, ADC_DUTYCYC_DUTY50_gc, ADC_ASDV_ASVOFF_gc, 0) == drvNoError);
+    testSample();
+    testIntRef();
+    testSleepLimit();
+
+    return TEST_RESULT("adc_test");
+}
+
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
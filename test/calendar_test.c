@@ -0,0 +1,70 @@
+/*!****************************************************************************
+* @file    calendar_test.c
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Calendar seconds and drift trim on the modelled RTC
+*/
+
+/*!****************************************************************************
+* Include
+*/
+#include "calendar.h"
+#include "sim.h"
+#include "test_check.h"
+
+/*!****************************************************************************
+* Local define
+*/
+#define TEST_SECONDS                            4
+#define TEST_PPM_DIV                            1000000L
+
+/*!****************************************************************************
+* @brief    RTC counts for a time span
+*/
+static uint32_t testCntToCyc(uint32_t cnt){
+    return (uint32_t)((uint64_t)cnt * sim_getClkPerHz() / CALENDAR_CNT_PER_SEC);
+}
+
+/*!****************************************************************************
+* @brief    Trim at the range limit gives seconds of the trimmed length
+* @param    ppm - trim
+*/
+static void testTrim(int16_t ppm){
+    int32_t whole = (int32_t)ppm * (int32_t)CALENDAR_CNT_PER_SEC / TEST_PPM_DIV;
+    int32_t lo = (ppm > 0) ? whole : whole - 1;                                 //Shorter of the two second lengths
+    uint32_t epoch, len;
+    uint16_t per;
+    uint8_t i;
+
+    CHECK(calendar_setTrim(ppm) == drvNoError);
+    CHECK(calendar_set(0) == drvNoError);
+    //Second in progress keeps its length
+    sim_run(testCntToCyc(RTC.PER + 1UL) + 64);
+    len = 0;
+    for(i = 0; i < TEST_SECONDS; i++){
+        //Whole counts every second, fraction carried as one more
+        per = RTC.PER;
+        CHECK((per >= CALENDAR_CNT_PER_SEC - 1 + lo) && (per <= CALENDAR_CNT_PER_SEC + lo));
+        len += per + 1UL;
+        sim_run(testCntToCyc(per + 1UL));
+    }
+    CHECK(calendar_getEpoch(&epoch, NULL) == drvNoError);
+    CHECK(epoch == 1 + TEST_SECONDS);
+    CHECK(len >= TEST_SECONDS * (CALENDAR_CNT_PER_SEC + lo));
+    CHECK(len <= TEST_SECONDS * (CALENDAR_CNT_PER_SEC + lo + 1));
+}
+
+int main(void){
+    sim_reset();
+    sei();
+    CHECK(calendar_init(RTC_CLKSEL_INT32K_gc) == drvNoError);
+    CHECK(calendar_setTrim(CALENDAR_TRIM_MAX_PPM + 1) == drvBadParameter);
+    CHECK(calendar_setTrim(-CALENDAR_TRIM_MAX_PPM - 1) == drvBadParameter);
+    testTrim(CALENDAR_TRIM_MAX_PPM);
+    testTrim(-CALENDAR_TRIM_MAX_PPM);
+
+    return TEST_RESULT("calendar_test");
+}
+
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
@@ -0,0 +1,144 @@
+/*!****************************************************************************
+* @file    crc_test.c
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   CRC library against reference vectors and bitwise implementations
+*/
+
+/*!****************************************************************************
+* Include
+*/
+#include <string.h>
+#include "crc.h"
+#include "test_check.h"
+
+/*!****************************************************************************
+* Local define
+*/
+#define TEST_BUF_SIZE                           1024
+
+/*!****************************************************************************
+* MEMORY
+*/
+static const uint8_t testCheckStr[] = "123456789";
+static uint8_t testBuf[TEST_BUF_SIZE];
+
+/*!****************************************************************************
+* @brief    Bitwise references
+*/
+static uint8_t refCrc8(const uint8_t *p, size_t n){
+    uint8_t crc = CRC8_INIT;
+    while(n--){
+        crc ^= *p++;
+        for(int i = 0; i < 8; i++) crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+    }
+    return crc;
+}
+
+static uint16_t refCrc16(const uint8_t *p, size_t n){
+    uint16_t crc = CRC16_INIT;
+    while(n--){
+        crc ^= (uint16_t)*p++ << 8;
+        for(int i = 0; i < 8; i++) crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+    return crc;
+}
+
+static uint32_t refCrc32(const uint8_t *p, size_t n){
+    uint32_t crc = CRC32_INIT;
+    while(n--){
+        crc ^= *p++;
+        for(int i = 0; i < 8; i++) crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320UL : crc >> 1;
+    }
+    return CRC32_FINAL(crc);
+}
+
+/*!****************************************************************************
+* @brief    Check values of the catalogue ("123456789")
+*/
+static void testCheckValues(void){
+    uint8_t crc8;
+    uint16_t crc16;
+    uint32_t crc32;
+
+    crc8 = CRC8_INIT;
+    CHECK(crc_calc8(testCheckStr, 9, &crc8) == drvNoError);
+    CHECK(crc8 == 0xF4);
+    crc8 = CRC8_INIT;
+    CHECK(crc_calc8Nib(testCheckStr, 9, &crc8) == drvNoError);
+    CHECK(crc8 == 0xF4);
+    crc16 = CRC16_INIT;
+    CHECK(crc_calc16(testCheckStr, 9, &crc16) == drvNoError);
+    CHECK(crc16 == 0x29B1);
+    crc16 = CRC16_INIT;
+    CHECK(crc_calc16Nib(testCheckStr, 9, &crc16) == drvNoError);
+    CHECK(crc16 == 0x29B1);
+    crc32 = CRC32_INIT;
+    CHECK(crc_calc32(testCheckStr, 9, &crc32) == drvNoError);
+    crc32 = CRC32_FINAL(crc32);
+    CHECK(crc32 == 0xCBF43926UL);
+    crc32 = CRC32_INIT;
+    CHECK(crc_calc32Nib(testCheckStr, 9, &crc32) == drvNoError);
+    crc32 = CRC32_FINAL(crc32);
+    CHECK(crc32 == 0xCBF43926UL);
+}
+
+/*!****************************************************************************
+* @brief    Table routines match bitwise ones for every length, also when fed
+*           in two parts
+*/
+static void testAgainstReference(void){
+    uint32_t seed = 1, crc32, crc32Nib;
+    uint16_t crc16, crc16Nib;
+    uint8_t crc8, crc8Nib;
+    size_t n, half;
+
+    for(n = 0; n < TEST_BUF_SIZE; n++){
+        seed = seed * 1103515245UL + 12345UL;
+        testBuf[n] = (uint8_t)(seed >> 16);
+    }
+    for(n = 0; n <= TEST_BUF_SIZE; n += 37){
+        half = n / 3;
+        crc8 = crc8Nib = CRC8_INIT;
+        crc_calc8(testBuf, half, &crc8);
+        crc_calc8(testBuf + half, n - half, &crc8);
+        crc_calc8Nib(testBuf, n, &crc8Nib);
+        CHECK(crc8 == refCrc8(testBuf, n));
+        CHECK(crc8Nib == crc8);
+        crc16 = crc16Nib = CRC16_INIT;
+        crc_calc16(testBuf, half, &crc16);
+        crc_calc16(testBuf + half, n - half, &crc16);
+        crc_calc16Nib(testBuf, n, &crc16Nib);
+        CHECK(crc16 == refCrc16(testBuf, n));
+        CHECK(crc16Nib == crc16);
+        crc32 = crc32Nib = CRC32_INIT;
+        crc_calc32(testBuf, half, &crc32);
+        crc_calc32(testBuf + half, n - half, &crc32);
+        crc_calc32Nib(testBuf, n, &crc32Nib);
+        CHECK(CRC32_FINAL(crc32) == refCrc32(testBuf, n));
+        CHECK(crc32Nib == crc32);
+    }
+}
+
+/*!****************************************************************************
+* @brief    Bad parameters are rejected, empty input keeps the value
+*/
+static void testParameters(void){
+    uint16_t crc16 = CRC16_INIT;
+
+    CHECK(crc_calc16(NULL, 1, &crc16) == drvBadParameter);
+    CHECK(crc_calc16(testCheckStr, 1, NULL) == drvBadParameter);
+    CHECK(crc_calc16(NULL, 0, &crc16) == drvNoError);
+    CHECK(crc16 == CRC16_INIT);
+}
+
+int main(void){
+    testCheckValues();
+    testAgainstReference();
+    testParameters();
+
+    return TEST_RESULT("crc_test");
+}
+
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
@@ -0,0 +1,83 @@
+/*!****************************************************************************
+* @file    eeprom_test.c
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   EEPROM write and erase against the register-level model
+*/
+
+/*!****************************************************************************
+* Include
+*/
+#include <string.h>
+#include "eeprom.h"
+#include "sim.h"
+#include "test_check.h"
+
+/*!****************************************************************************
+* Local define
+*/
+#define TEST_CELL                               (EEPROM_PAGE_SIZE - 20)         //Start near the end of the first page
+#define TEST_SIZE                               40                              //Ends in the second page
+
+/*!****************************************************************************
+* MEMORY
+*/
+static uint8_t testData[TEST_SIZE];
+static uint8_t testRead[TEST_SIZE];
+
+/*!****************************************************************************
+* @brief    One erase-write command per page touched, each waited for
+*/
+static void testWrite(void){
+    uint8_t i;
+
+    for(i = 0; i < TEST_SIZE; i++){
+        testData[i] = i ^ 0x5A;
+    }
+    sim_clearStat();
+    CHECK(eeprom_write(SIM_EEPROM(TEST_CELL), testData, TEST_SIZE) == drvNoError);
+    CHECK(simStat.nvmCmd[NVMCTRL_CMD_PAGEERASEWRITE_gc] == 2);
+    CHECK(simStat.cycles >= 2ULL * sim_usToCyc(SIM_EE_PAGE_US));
+    CHECK(!(NVMCTRL.STATUS & NVMCTRL_EEBUSY_bm));
+    CHECK(eeprom_read(SIM_EEPROM(TEST_CELL), testRead, TEST_SIZE) == drvNoError);
+    CHECK(memcmp(testRead, testData, TEST_SIZE) == 0);
+    //Page-aligned single page write
+    sim_clearStat();
+    CHECK(eeprom_write(SIM_EEPROM(EEPROM_PAGE_SIZE * 2), testData, EEPROM_PAGE_SIZE) == drvNoError);
+    CHECK(simStat.nvmCmd[NVMCTRL_CMD_PAGEERASEWRITE_gc] == 1);
+}
+
+/*!****************************************************************************
+* @brief    Busy controller rejects access, erase clears data
+*/
+static void testBusyAndErase(void){
+    uint16_t count;
+
+    _PROTECTED_WRITE_SPM(NVMCTRL.CTRLA, NVMCTRL_CMD_PAGEERASE_gc);
+    CHECK(NVMCTRL.STATUS & NVMCTRL_EEBUSY_bm);
+    CHECK(eeprom_write(SIM_EEPROM(0), testData, 1) == drvHwError);
+    CHECK(eeprom_read(SIM_EEPROM(0), testRead, 1) == drvHwError);
+    sim_run(sim_usToCyc(SIM_EE_PAGE_US));
+    CHECK(!(NVMCTRL.STATUS & NVMCTRL_EEBUSY_bm));
+    timeout_clearCounts();
+    sim_clearStat();
+    CHECK(eeprom_erase() == drvNoError);
+    CHECK(simStat.nvmCmd[NVMCTRL_CMD_EEERASE_gc] == 1);
+    CHECK(eeprom_read(SIM_EEPROM(TEST_CELL), testRead, TEST_SIZE) == drvNoError);
+    CHECK(testRead[0] == 0xFF);
+    CHECK(testRead[TEST_SIZE - 1] == 0xFF);
+    CHECK(timeout_getCount(timeoutSiteEepromErase, &count) == drvNoError);
+    CHECK(count == 0);
+}
+
+int main(void){
+    sim_reset();
+    sei();
+    testWrite();
+    testBusyAndErase();
+
+    return TEST_RESULT("eeprom_test");
+}
+
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
@@ -0,0 +1,27 @@
+/*!****************************************************************************
+* @file    interrupt.h
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Host stand-in for <avr/interrupt.h>
+* @note     Handlers are plain functions, sim.c calls the ones it models when
+*           their flag and enable are set and SREG I bit is set
+*/
+
+#ifndef mock_interrupt_H
+#define mock_interrupt_H
+
+/*!****************************************************************************
+* Include
+*/
+#include <avr/io.h>
+
+/*!****************************************************************************
+* User macro
+*/
+#define ISR(vector)                             void vector(void); void vector(void)
+#define sei()                                   (SREG |= CPU_I_bm)
+#define cli()                                   (SREG &= (uint8_t)~CPU_I_bm)
+
+#endif //mock_interrupt_H
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
@@ -0,0 +1,505 @@
+/*!****************************************************************************
+* @file    io.h
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Host stand-in for <avr/io.h>, ATtiny3217 register map backed by the
+*           peripheral models of sim.c
+* @note     Only registers and bit names used by the drivers are declared.
+*           Struct layout follows field names, not data sheet offsets.
+*           Instances of modelled peripherals expand to sim_access(), which
+*           counts the access and advances the models. Strobe and write-one-
+*           to-clear registers are simReg8_t: the models keep SIM_WR_MARK set
+*           in them, any store by a driver clears it, so a write of the value
+*           already there is still seen
+*/
+
+#ifndef mock_io_H
+#define mock_io_H
+
+/*!****************************************************************************
+* Include
+*/
+#include <stdint.h>
+
+/*!****************************************************************************
+* User define
+*/
+#define SIM_WR_MARK                             0x100                           //Set by model in simReg8_t, cleared by a store
+#define EEPROM_START                            0x1400
+#if defined(__AVR_ATtiny1614__) || defined(__AVR_ATtiny816__) || defined(__AVR_ATtiny417__)
+#define EEPROM_PAGE_SIZE                        32                              //Other parts for build checks only
+#else
+#ifndef __AVR_ATtiny3217__
+#define __AVR_ATtiny3217__                                                      //Modelled part
+#endif
+#define EEPROM_PAGE_SIZE                        64
+#endif
+#define USER_SIGNATURES_START                   0x1300
+#define RAMEND                                  0x3FFF
+
+/*!****************************************************************************
+* User enum
+*/
+typedef enum{
+    simPerClkctrl = 0,
+    simPerTca0,
+    simPerTcb0,
+    simPerTcb1,
+    simPerAdc0,
+    simPerAdc1,
+    simPerSpi0,
+    simPerUsart0,
+    simPerNvmctrl,
+    simPerRtc,
+    simPerNum
+}eSimPer;
+
+/*!****************************************************************************
+* User typedef
+*/
+typedef volatile uint8_t register8_t;
+typedef volatile uint16_t register16_t;
+typedef volatile uint32_t register32_t;
+typedef volatile uint16_t simReg8_t;                                            //8 bit register with write detection
+
+/*!****************************************************************************
+* Prototypes for the functions
+*/
+void *sim_access(eSimPer per);
+
+/*!****************************************************************************
+* User macro
+*/
+#define _PROTECTED_WRITE(reg, val)              ((reg) = (val))
+#define _PROTECTED_WRITE_SPM(reg, val)          ((reg) = (val))
+#define SIM_PER(type, per)                      (*(type *)sim_access(per))
+
+/* PORT */
+typedef struct{ register8_t DIR,DIRSET,DIRCLR,DIRTGL,OUT,OUTSET,OUTCLR,OUTTGL,IN,INTFLAGS,PORTCTRL,r[5],PIN0CTRL,PIN1CTRL,PIN2CTRL,PIN3CTRL,PIN4CTRL,PIN5CTRL,PIN6CTRL,PIN7CTRL; }PORT_t;
+typedef enum{PORT_ISC_INTDISABLE_gc=0,PORT_ISC_BOTHEDGES_gc,PORT_ISC_RISING_gc,PORT_ISC_FALLING_gc,PORT_ISC_INPUT_DISABLE_gc,PORT_ISC_LEVEL_gc}PORT_ISC_t;
+#define PORT_INVEN_bp 7
+#define PORT_PULLUPEN_bp 3
+extern PORT_t simPortA, simPortB, simPortC;
+//Expression macros as in the device headers, token pasting must not see them expanded
+#define PORTA (*(PORT_t *)&simPortA)
+#define PORTB (*(PORT_t *)&simPortB)
+#define PORTC (*(PORT_t *)&simPortC)
+/* TCB */
+typedef struct{ register8_t CTRLA,CTRLB,r0[2],EVCTRL,INTCTRL; simReg8_t INTFLAGS; register8_t STATUS,DBGCTRL,TEMP; register16_t CNT, CCMP; }TCB_t;
+typedef enum{TCB_CLKSEL_CLKDIV1_gc=0,TCB_CLKSEL_CLKDIV2_gc=2,TCB_CLKSEL_CLKTCA_gc=4}TCB_CLKSEL_t;
+typedef enum{TCB_CNTMODE_INT_gc=0,TCB_CNTMODE_TIMEOUT_gc,TCB_CNTMODE_CAPT_gc,TCB_CNTMODE_FRQ_gc,TCB_CNTMODE_PW_gc,TCB_CNTMODE_FRQPW_gc,TCB_CNTMODE_SINGLE_gc,TCB_CNTMODE_PWM8_gc}TCB_CNTMODE_t;
+#define TCB_ENABLE_bm 0x01
+#define TCB_ENABLE_bp 0
+#define TCB_CLKSEL_gm 0x06
+#define TCB_SYNCUPD_bm 0x10
+#define TCB_RUNSTDBY_bm 0x40
+#define TCB_CNTMODE_gm 0x07
+#define TCB_CCMPEN_bm 0x10
+#define TCB_CAPTEI_bm 0x01
+#define TCB_CAPTEI_bp 0
+#define TCB_EDGE_bm 0x10
+#define TCB_EDGE_bp 4
+#define TCB_FILTER_bm 0x40
+#define TCB_FILTER_bp 6
+#define TCB_CAPT_bm 0x01
+#define TCB_CAPT_bp 0
+#define TCB_RUN_bm 0x01
+#define TCB0 SIM_PER(TCB_t, simPerTcb0)
+#define TCB1 SIM_PER(TCB_t, simPerTcb1)
+/* EVSYS */
+typedef struct{ register8_t ASYNCSTROBE,SYNCSTROBE,ASYNCCH0,ASYNCCH1,ASYNCCH2,ASYNCCH3,r0[6],SYNCCH0,SYNCCH1,r1[4],
+ ASYNCUSER0,ASYNCUSER1,ASYNCUSER2,ASYNCUSER3,ASYNCUSER4,ASYNCUSER5,ASYNCUSER6,ASYNCUSER7,ASYNCUSER8,ASYNCUSER9,ASYNCUSER10,ASYNCUSER11,ASYNCUSER12,r2[3],SYNCUSER0,SYNCUSER1; }EVSYS_t;
+extern EVSYS_t EVSYS;
+
+/* TCA */
+typedef struct{ register8_t CTRLA,CTRLB,CTRLC,CTRLD,CTRLECLR,CTRLESET,CTRLFCLR,CTRLFSET,EVCTRL,INTCTRL; simReg8_t INTFLAGS; register8_t DBGCTRL,TEMP; register16_t CNT; register8_t r2[4]; register16_t PER,CMP0,CMP1,CMP2; register8_t r3[8]; register16_t PERBUF,CMP0BUF,CMP1BUF,CMP2BUF; }TCA_SINGLE_t;
+typedef union{ TCA_SINGLE_t SINGLE; }TCA_t;
+typedef enum{TCA_SINGLE_CLKSEL_DIV1_gc=0,TCA_SINGLE_CLKSEL_DIV2_gc=2,TCA_SINGLE_CLKSEL_DIV4_gc=4,TCA_SINGLE_CLKSEL_DIV8_gc=6,TCA_SINGLE_CLKSEL_DIV16_gc=8,TCA_SINGLE_CLKSEL_DIV64_gc=10,TCA_SINGLE_CLKSEL_DIV256_gc=12,TCA_SINGLE_CLKSEL_DIV1024_gc=14}TCA_SINGLE_CLKSEL_t;
+typedef enum{TCA_SINGLE_WGMODE_NORMAL_gc=0,TCA_SINGLE_WGMODE_FRQ_gc,TCA_SINGLE_WGMODE_SINGLESLOPE_gc=3,TCA_SINGLE_WGMODE_DSTOP_gc=5,TCA_SINGLE_WGMODE_DSBOTH_gc,TCA_SINGLE_WGMODE_DSBOTTOM_gc}TCA_SINGLE_WGMODE_t;
+typedef enum{TCA_SINGLE_DIR_UP_gc=0,TCA_SINGLE_DIR_DOWN_gc=1}TCA_SINGLE_DIR_t;
+#define TCA_SINGLE_ENABLE_bm 0x01
+#define TCA_SINGLE_ENABLE_bp 0
+#define TCA_SINGLE_CLKSEL_gm 0x0E
+#define TCA_SINGLE_CLKSEL_gp 1
+#define TCA_SINGLE_WGMODE_gm 0x07
+#define TCA_SINGLE_ALUPD_bm 0x08
+#define TCA_SINGLE_CMP0EN_bm 0x10
+#define TCA_SINGLE_CMP1EN_bm 0x20
+#define TCA_SINGLE_CMP2EN_bm 0x40
+#define TCA_SINGLE_CMP0OV_bm 0x01
+#define TCA_SINGLE_CMP1OV_bm 0x02
+#define TCA_SINGLE_CMP2OV_bm 0x04
+#define TCA_SINGLE_SPLITM_bm 0x01
+#define TCA_SINGLE_DIR_bm 0x01
+#define TCA_SINGLE_OVF_bm 0x01
+#define TCA_SINGLE_PERBV_bm 0x01
+#define TCA_SINGLE_CMP0BV_bm 0x02
+#define TCA_SINGLE_CMP1BV_bm 0x04
+#define TCA_SINGLE_CMP2BV_bm 0x08
+#define TCA_SINGLE_OVF_bp 0
+#define TCA_SINGLE_CMP0_bm 0x10
+#define TCA_SINGLE_CMP1_bm 0x20
+#define TCA_SINGLE_CMP2_bm 0x40
+#define TCA0 SIM_PER(TCA_t, simPerTca0)
+/* TCD */
+typedef struct{ register8_t CTRLA,CTRLB,CTRLC,CTRLD,CTRLE,r0[3],EVCTRLA,EVCTRLB,r1[2],INTCTRL,INTFLAGS,STATUS,r2,INPUTCTRLA,INPUTCTRLB,FAULTCTRL,r3,DLYCTRL,DLYVAL,r4[2],DITCTRL,DITVAL,r5[4],DBGCTRL,r6[3]; register16_t CAPTUREA,CAPTUREB; register8_t r7[2]; register16_t CMPASET,CMPACLR,CMPBSET,CMPBCLR; }TCD_t;
+typedef enum{TCD_CLKSEL_20MHZ_gc=0x00,TCD_CLKSEL_EXTCLK_gc=0x40,TCD_CLKSEL_SYSCLK_gc=0x60}TCD_CLKSEL_t;
+typedef enum{TCD_CNTPRES_DIV1_gc=0x00,TCD_CNTPRES_DIV4_gc=0x08,TCD_CNTPRES_DIV32_gc=0x10}TCD_CNTPRES_t;
+typedef enum{TCD_SYNCPRES_DIV1_gc=0x00,TCD_SYNCPRES_DIV2_gc=0x02,TCD_SYNCPRES_DIV4_gc=0x04,TCD_SYNCPRES_DIV8_gc=0x06}TCD_SYNCPRES_t;
+typedef enum{TCD_WGMODE_ONERAMP_gc=0,TCD_WGMODE_TWORAMP_gc,TCD_WGMODE_FOURRAMP_gc,TCD_WGMODE_DS_gc}TCD_WGMODE_t;
+typedef enum{TCD_INPUTMODE_NONE_gc=0,TCD_INPUTMODE_JMPWAIT_gc,TCD_INPUTMODE_EXECWAIT_gc,TCD_INPUTMODE_EXECFAULT_gc,TCD_INPUTMODE_FREQ_gc,TCD_INPUTMODE_EXECDT_gc,TCD_INPUTMODE_WAIT_gc,TCD_INPUTMODE_WAITSW_gc,TCD_INPUTMODE_EDGETRIG_gc,TCD_INPUTMODE_EDGETRIGFREQ_gc,TCD_INPUTMODE_LVLTRIGFREQ_gc}TCD_INPUTMODE_t;
+typedef enum{TCD_CFG_NEITHER_gc=0x00,TCD_CFG_FILTER_gc=0x40,TCD_CFG_ASYNC_gc=0x80}TCD_CFG_t;
+typedef enum{TCD_ACTION_FAULT_gc=0x00,TCD_ACTION_CAPTURE_gc=0x04}TCD_ACTION_t;
+#define TCD_ENABLE_bm 0x01
+#define TCD_ENABLE_bp 0
+#define TCD_CLKSEL_gm 0x60
+#define TCD_CNTPRES_gm 0x18
+#define TCD_SYNCPRES_gm 0x06
+#define TCD_WGMODE_gm 0x03
+#define TCD_SYNCEOC_bm 0x01
+#define TCD_SYNCEOC_bp 0
+#define TCD_SYNC_bm 0x02
+#define TCD_SYNC_bp 1
+#define TCD_RESTART_bm 0x04
+#define TCD_RESTART_bp 2
+#define TCD_SCAPTUREA_bm 0x08
+#define TCD_SCAPTUREA_bp 3
+#define TCD_SCAPTUREB_bm 0x10
+#define TCD_SCAPTUREB_bp 4
+#define TCD_ENRDY_bm 0x01
+#define TCD_CMDRDY_bm 0x02
+#define TCD_OVF_bm 0x01
+#define TCD_OVF_bp 0
+#define TCD_TRIGA_bm 0x04
+#define TCD_TRIGB_bm 0x08
+#define TCD_TRIGEI_bm 0x01
+#define TCD_TRIGEI_bp 0
+#define TCD_EDGE_bm 0x10
+#define TCD_EDGE_bp 4
+#define TCD_CMPA_bm 0x01
+#define TCD_CMPB_bm 0x02
+#define TCD_CMPAEN_bm 0x10
+#define TCD_CMPBEN_bm 0x20
+extern TCD_t TCD0;
+
+/* CPU */
+typedef struct{ register8_t r0[4],CCP,r1[8],SPL,SPH,SREG; }CPU_t;
+extern CPU_t CPU;
+#define SREG CPU.SREG
+#define SP (*(volatile uint16_t *)&CPU.SPL)
+#define CPU_I_bm 0x80
+#define CPU_I_bp 7
+/* ADC */
+typedef struct{ register8_t CTRLA,CTRLB,CTRLC,CTRLD,CTRLE,SAMPCTRL,MUXPOS,COMMAND,EVCTRL,INTCTRL; simReg8_t INTFLAGS; register8_t DBGCTRL,TEMP; register16_t RES,WINLT,WINHT; register8_t CALIB; }ADC_t;
+typedef enum{ADC_RESSEL_10BIT_gc=0x00,ADC_RESSEL_8BIT_gc=0x04}ADC_RESSEL_t;
+typedef enum{ADC_DUTYCYC_DUTY50_gc=0,ADC_DUTYCYC_DUTY25_gc=1}ADC_DUTYCYC_t;
+typedef enum{ADC_ASDV_ASVOFF_gc=0x00,ADC_ASDV_ASVON_gc=0x10}ADC_ASDV_t;
+typedef enum{ADC_INITDLY_DLY0_gc=0x00,ADC_INITDLY_DLY16_gc=0x20,ADC_INITDLY_DLY32_gc=0x40,ADC_INITDLY_DLY64_gc=0x60,ADC_INITDLY_DLY128_gc=0x80,ADC_INITDLY_DLY256_gc=0xA0}ADC_INITDLY_t;
+typedef enum{ADC_MUXPOS_AIN0_gc=0,ADC_MUXPOS_AIN1_gc,ADC_MUXPOS_AIN2_gc,ADC_MUXPOS_AIN3_gc,ADC_MUXPOS_DAC0_gc=0x1C,ADC_MUXPOS_INTREF_gc=0x1D,ADC_MUXPOS_TEMPSENSE_gc=0x1E,ADC_MUXPOS_GND_gc=0x1F}ADC_MUXPOS_t;
+typedef enum{ADC_PRESC_DIV2_gc=0,ADC_PRESC_DIV4_gc,ADC_PRESC_DIV8_gc,ADC_PRESC_DIV16_gc,ADC_PRESC_DIV32_gc,ADC_PRESC_DIV64_gc,ADC_PRESC_DIV128_gc,ADC_PRESC_DIV256_gc}ADC_PRESC_t;
+typedef enum{ADC_REFSEL_INTREF_gc=0x00,ADC_REFSEL_VDDREF_gc=0x10,ADC_REFSEL_VREFA_gc=0x20}ADC_REFSEL_t;
+typedef enum{ADC_SAMPNUM_ACC1_gc=0,ADC_SAMPNUM_ACC2_gc,ADC_SAMPNUM_ACC4_gc,ADC_SAMPNUM_ACC8_gc,ADC_SAMPNUM_ACC16_gc,ADC_SAMPNUM_ACC32_gc,ADC_SAMPNUM_ACC64_gc}ADC_SAMPNUM_t;
+typedef enum{ADC_WINCM_NONE_gc=0,ADC_WINCM_BELOW_gc,ADC_WINCM_ABOVE_gc,ADC_WINCM_INSIDE_gc,ADC_WINCM_OUTSIDE_gc}ADC_WINCM_t;
+#define ADC_ENABLE_bm 0x01
+#define ADC_ENABLE_bp 0
+#define ADC_FREERUN_bm 0x02
+#define ADC_FREERUN_bp 1
+#define ADC_RESSEL_bm 0x04
+#define ADC_RUNSTBY_bm 0x80
+#define ADC_SAMPNUM_gm 0x07
+#define ADC_PRESC_gm 0x07
+#define ADC_REFSEL_gm 0x30
+#define ADC_SAMPCAP_bm 0x40
+#define ADC_SAMPCAP_bp 6
+#define ADC_ASDV_bm 0x10
+#define ADC_INITDLY_gm 0xE0
+#define ADC_WINCM_gm 0x07
+#define ADC_SAMPLEN_gm 0x1F
+#define ADC_SAMPLEN_gp 0
+#define ADC_MUXPOS_gm 0x1F
+#define ADC_STCONV_bm 0x01
+#define ADC_STCONV_bp 0
+#define ADC_STARTEI_bm 0x01
+#define ADC_RESRDY_bm 0x01
+#define ADC_RESRDY_bp 0
+#define ADC_WCMP_bm 0x02
+#define ADC_DBGRUN_bm 0x01
+#define ADC_DBGRUN_bp 0
+#define ADC_DUTYCYC_bm 0x01
+#define ADC0 SIM_PER(ADC_t, simPerAdc0)
+#define ADC1 SIM_PER(ADC_t, simPerAdc1)
+/* VREF */
+typedef struct{ register8_t CTRLA,CTRLB,CTRLC,CTRLD; }VREF_t;
+#define VREF_DAC0REFSEL_gm 0x07
+#define VREF_ADC0REFSEL_gm 0x70
+#define VREF_ADC0REFSEL_gp 4
+#define VREF_DAC0REFEN_bm 0x01
+#define VREF_DAC0REFEN_bp 0
+#define VREF_ADC0REFEN_bm 0x02
+#define VREF_ADC0REFEN_bp 1
+#define VREF_DAC1REFEN_bm 0x08
+#define VREF_DAC1REFEN_bp 3
+#define VREF_ADC1REFEN_bm 0x10
+#define VREF_ADC1REFEN_bp 4
+#define VREF_DAC2REFEN_bm 0x20
+#define VREF_DAC2REFEN_bp 5
+#define VREF_DAC1REFSEL_gm 0x07
+#define VREF_ADC1REFSEL_gm 0x70
+#define VREF_DAC2REFSEL_gm 0x07
+extern VREF_t VREF;
+/* RTC */
+typedef struct{ register8_t CTRLA,STATUS,INTCTRL; simReg8_t INTFLAGS; register8_t TEMP,DBGCTRL,CLKSEL; register16_t CNT,PER,CMP; register8_t PITCTRLA,PITSTATUS,PITINTCTRL; simReg8_t PITINTFLAGS; register8_t PITDBGCTRL; }RTC_t;
+typedef enum{RTC_CLKSEL_INT32K_gc=0,RTC_CLKSEL_INT1K_gc,RTC_CLKSEL_TOSC32K_gc,RTC_CLKSEL_EXTCLK_gc}RTC_CLKSEL_t;
+typedef enum{RTC_PRESCALER_DIV1_gc=0x00,RTC_PRESCALER_DIV2_gc=0x08,RTC_PRESCALER_DIV4_gc=0x10,RTC_PRESCALER_DIV8_gc=0x18,RTC_PRESCALER_DIV16_gc=0x20,RTC_PRESCALER_DIV32_gc=0x28,RTC_PRESCALER_DIV64_gc=0x30,RTC_PRESCALER_DIV128_gc=0x38,RTC_PRESCALER_DIV256_gc=0x40,RTC_PRESCALER_DIV512_gc=0x48,RTC_PRESCALER_DIV1024_gc=0x50,RTC_PRESCALER_DIV2048_gc=0x58,RTC_PRESCALER_DIV4096_gc=0x60,RTC_PRESCALER_DIV8192_gc=0x68,RTC_PRESCALER_DIV16384_gc=0x70,RTC_PRESCALER_DIV32768_gc=0x78}RTC_PRESCALER_t;
+typedef enum{RTC_PERIOD_OFF_gc=0x00,RTC_PERIOD_CYC4_gc=0x08,RTC_PERIOD_CYC8_gc=0x10,RTC_PERIOD_CYC16_gc=0x18,RTC_PERIOD_CYC32_gc=0x20,RTC_PERIOD_CYC64_gc=0x28,RTC_PERIOD_CYC128_gc=0x30,RTC_PERIOD_CYC256_gc=0x38,RTC_PERIOD_CYC512_gc=0x40,RTC_PERIOD_CYC1024_gc=0x48,RTC_PERIOD_CYC2048_gc=0x50,RTC_PERIOD_CYC4096_gc=0x58,RTC_PERIOD_CYC8192_gc=0x60,RTC_PERIOD_CYC16384_gc=0x68,RTC_PERIOD_CYC32768_gc=0x70}RTC_PERIOD_t;
+#define RTC_RTCEN_bm 0x01
+#define RTC_RTCEN_bp 0
+#define RTC_PRESCALER_gm 0x78
+#define RTC_PRESCALER_gp 3
+#define RTC_RUNSTDBY_bm 0x80
+#define RTC_RUNSTDBY_bp 7
+#define RTC_CTRLABUSY_bm 0x01
+#define RTC_CNTBUSY_bm 0x02
+#define RTC_PERBUSY_bm 0x04
+#define RTC_CMPBUSY_bm 0x08
+#define RTC_OVF_bm 0x01
+#define RTC_OVF_bp 0
+#define RTC_CMP_bm 0x02
+#define RTC_CMP_bp 1
+#define RTC_CLKSEL_gm 0x03
+#define RTC_PITEN_bm 0x01
+#define RTC_PITEN_bp 0
+#define RTC_PERIOD_gm 0x78
+#define RTC_CTRLBUSY_bm 0x01
+#define RTC_PI_bm 0x01
+#define RTC_PI_bp 0
+#define RTC SIM_PER(RTC_t, simPerRtc)
+/* CLKCTRL */
+typedef struct{ register8_t MCLKCTRLA,MCLKCTRLB,MCLKLOCK,MCLKSTATUS,r0[12],OSC20MCTRLA,OSC20MCALIBA,OSC20MCALIBB,r1[5],OSC32KCTRLA,r2[3],XOSC32KCTRLA; }CLKCTRL_t;
+typedef enum{CLKCTRL_CLKSEL_OSC20M_gc=0,CLKCTRL_CLKSEL_OSCULP32K_gc,CLKCTRL_CLKSEL_XOSC32K_gc,CLKCTRL_CLKSEL_EXTCLK_gc}CLKCTRL_CLKSEL_t;
+typedef enum{CLKCTRL_PDIV_2X_gc=0x00,CLKCTRL_PDIV_4X_gc=0x02,CLKCTRL_PDIV_8X_gc=0x04,CLKCTRL_PDIV_16X_gc=0x06,CLKCTRL_PDIV_32X_gc=0x08,CLKCTRL_PDIV_64X_gc=0x0A,CLKCTRL_PDIV_6X_gc=0x10,CLKCTRL_PDIV_10X_gc=0x12,CLKCTRL_PDIV_12X_gc=0x14,CLKCTRL_PDIV_24X_gc=0x16,CLKCTRL_PDIV_48X_gc=0x18}CLKCTRL_PDIV_t;
+typedef enum{CLKCTRL_CSUT_1K_gc=0x00,CLKCTRL_CSUT_16K_gc=0x10,CLKCTRL_CSUT_32K_gc=0x20,CLKCTRL_CSUT_64K_gc=0x30}CLKCTRL_CSUT_t;
+#define CLKCTRL_CLKSEL_gm 0x03
+#define CLKCTRL_CLKOUT_bm 0x80
+#define CLKCTRL_PEN_bm 0x01
+#define CLKCTRL_PEN_bp 0
+#define CLKCTRL_PDIV_gm 0x1E
+#define CLKCTRL_SOSC_bm 0x01
+#define CLKCTRL_OSC20MS_bm 0x10
+#define CLKCTRL_OSC32KS_bm 0x20
+#define CLKCTRL_XOSC32KS_bm 0x40
+#define CLKCTRL_EXTS_bm 0x80
+#define CLKCTRL_RUNSTDBY_bm 0x02
+#define CLKCTRL_RUNSTDBY_bp 1
+#define CLKCTRL_CAL20M_gm 0x3F
+#define CLKCTRL_LOCK_bm 0x80
+#define CLKCTRL_ENABLE_bm 0x01
+#define CLKCTRL_ENABLE_bp 0
+#define CLKCTRL_SEL_bm 0x04
+#define CLKCTRL_CSUT_gm 0x30
+#define CLKCTRL SIM_PER(CLKCTRL_t, simPerClkctrl)
+/* WDT */
+typedef struct{ register8_t CTRLA,STATUS; }WDT_t;
+typedef enum{WDT_PERIOD_OFF_gc=0,WDT_PERIOD_8CLK_gc,WDT_PERIOD_16CLK_gc,WDT_PERIOD_32CLK_gc,WDT_PERIOD_64CLK_gc,WDT_PERIOD_128CLK_gc,WDT_PERIOD_256CLK_gc,WDT_PERIOD_512CLK_gc,WDT_PERIOD_1KCLK_gc,WDT_PERIOD_2KCLK_gc,WDT_PERIOD_4KCLK_gc,WDT_PERIOD_8KCLK_gc}WDT_PERIOD_t;
+typedef enum{WDT_WINDOW_OFF_gc=0x00,WDT_WINDOW_8CLK_gc=0x10,WDT_WINDOW_16CLK_gc=0x20,WDT_WINDOW_32CLK_gc=0x30,WDT_WINDOW_64CLK_gc=0x40,WDT_WINDOW_128CLK_gc=0x50,WDT_WINDOW_256CLK_gc=0x60,WDT_WINDOW_512CLK_gc=0x70,WDT_WINDOW_1KCLK_gc=0x80,WDT_WINDOW_2KCLK_gc=0x90,WDT_WINDOW_4KCLK_gc=0xA0,WDT_WINDOW_8KCLK_gc=0xB0}WDT_WINDOW_t;
+#define WDT_PERIOD_gm 0x0F
+#define WDT_WINDOW_gm 0xF0
+#define WDT_WINDOW_gp 4
+#define WDT_SYNCBUSY_bm 0x01
+#define WDT_LOCK_bm 0x80
+#define WDT_LOCK_bp 7
+extern WDT_t WDT;
+/* RSTCTRL */
+typedef struct{ register8_t RSTFR,SWRR; }RSTCTRL_t;
+#define RSTCTRL_PORF_bm 0x01
+#define RSTCTRL_PORF_bp 0
+#define RSTCTRL_BORF_bm 0x02
+#define RSTCTRL_EXTRF_bm 0x04
+#define RSTCTRL_WDRF_bm 0x08
+#define RSTCTRL_WDRF_bp 3
+#define RSTCTRL_SWRF_bm 0x10
+#define RSTCTRL_SWRF_bp 4
+#define RSTCTRL_UPDIRF_bm 0x20
+#define RSTCTRL_SWRE_bp 0
+extern RSTCTRL_t RSTCTRL;
+/* NVMCTRL */
+typedef struct{ simReg8_t CTRLA; register8_t CTRLB,STATUS,INTCTRL,INTFLAGS; register16_t DATA,ADDR; }NVMCTRL_t;
+typedef enum{NVMCTRL_CMD_NONE_gc=0,NVMCTRL_CMD_PAGEWRITE_gc,NVMCTRL_CMD_PAGEERASE_gc,NVMCTRL_CMD_PAGEERASEWRITE_gc,NVMCTRL_CMD_PAGEBUFCLR_gc,NVMCTRL_CMD_CHIPERASE_gc,NVMCTRL_CMD_EEERASE_gc,NVMCTRL_CMD_FUSEWRITE_gc}NVMCTRL_CMD_t;
+#define NVMCTRL_FBUSY_bm 0x01
+#define NVMCTRL_EEBUSY_bm 0x02
+#define NVMCTRL_WRERROR_bm 0x04
+#define NVMCTRL_EEREADY_bm 0x01
+#define NVMCTRL SIM_PER(NVMCTRL_t, simPerNvmctrl)
+/* SPI */
+typedef struct{ register8_t CTRLA,CTRLB,INTCTRL; simReg8_t INTFLAGS,DATA; }SPI_t;
+typedef enum{SPI_PRESC_DIV4_gc=0x00,SPI_PRESC_DIV16_gc=0x02,SPI_PRESC_DIV64_gc=0x04,SPI_PRESC_DIV128_gc=0x06}SPI_PRESC_t;
+typedef enum{SPI_MODE_0_gc=0,SPI_MODE_1_gc,SPI_MODE_2_gc,SPI_MODE_3_gc}SPI_MODE_t;
+#define SPI_ENABLE_bm 0x01
+#define SPI_ENABLE_bp 0
+#define SPI_PRESC_gm 0x06
+#define SPI_CLK2X_bm 0x10
+#define SPI_CLK2X_bp 4
+#define SPI_MASTER_bm 0x20
+#define SPI_MASTER_bp 5
+#define SPI_DORD_bp 6
+#define SPI_MODE_gm 0x03
+#define SPI_SSD_bp 2
+#define SPI_BUFWR_bp 6
+#define SPI_BUFEN_bp 7
+#define SPI_IE_bp 0
+#define SPI_SSIE_bp 4
+#define SPI_DREIE_bp 5
+#define SPI_TXCIE_bp 6
+#define SPI_RXCIE_bp 7
+#define SPI_IE_bm 0x01
+#define SPI_IF_bm 0x80
+#define SPI0 SIM_PER(SPI_t, simPerSpi0)
+/* SLPCTRL */
+typedef struct{ register8_t CTRLA; }SLPCTRL_t;
+typedef enum{SLPCTRL_SMODE_IDLE_gc=0x00,SLPCTRL_SMODE_STDBY_gc=0x02,SLPCTRL_SMODE_PDOWN_gc=0x04}SLPCTRL_SMODE_t;
+#define SLPCTRL_SEN_bm 0x01
+#define SLPCTRL_SMODE_gm 0x06
+extern SLPCTRL_t SLPCTRL;
+#define RTC_PERIOD_gp 3
+#define RTC_CNT_vect_num 3
+#define RTC_PIT_vect_num 4
+/* FUSE */
+typedef struct{ register8_t WDTCFG, BODCFG, OSCCFG; }FUSE_t;
+#define FUSE_FREQSEL_gm 0x03
+typedef enum{FREQSEL_16MHZ_gc=0x01,FREQSEL_20MHZ_gc=0x02}FREQSEL_t;
+extern FUSE_t FUSE;
+#define SPI_PRESC_gp 1
+/* USART */
+typedef struct{ register8_t RXDATAL, RXDATAH; simReg8_t TXDATAL; register8_t TXDATAH; simReg8_t STATUS; register8_t CTRLA, CTRLB, CTRLC; register16_t BAUD; register8_t CTRLD, DBGCTRL, EVCTRL, TXPLCTRL, RXPLCTRL; }USART_t;
+#define USART_RXCIF_bm 0x80
+#define USART_TXCIF_bm 0x40
+#define USART_DREIF_bm 0x20
+#define USART_RXCIE_bm 0x80
+#define USART_TXCIE_bm 0x40
+#define USART_DREIE_bm 0x20
+#define USART_RXEN_bm 0x80
+#define USART_TXEN_bm 0x40
+#define USART_RXMODE_gm 0x06
+typedef enum{USART_RXMODE_NORMAL_gc=0x00,USART_RXMODE_CLK2X_gc=0x02}USART_RXMODE_t;
+#define USART_CMODE_ASYNCHRONOUS_gc 0x00
+#define USART_PMODE_DISABLED_gc 0x00
+#define USART_SBMODE_1BIT_gc 0x00
+#define USART_CHSIZE_8BIT_gc 0x03
+#define USART0 SIM_PER(USART_t, simPerUsart0)
+#define CLKCTRL_PDIV_gp 1
+/* CCL */
+typedef struct{ register8_t CTRLA,SEQCTRL0,r0[3],LUT0CTRLA,LUT0CTRLB,LUT0CTRLC,TRUTH0,LUT1CTRLA,LUT1CTRLB,LUT1CTRLC,TRUTH1; }CCL_t;
+extern CCL_t CCL;
+#define CCL_ENABLE_bm 0x01
+#define CCL_ENABLE_bp 0
+#define CCL_RUNSTDBY_bm 0x40
+#define CCL_RUNSTDBY_bp 6
+#define CCL_SEQSEL_gm 0x07
+typedef enum{CCL_SEQSEL_DISABLE_gc=0,CCL_SEQSEL_DFF_gc,CCL_SEQSEL_JK_gc,CCL_SEQSEL_LATCH_gc,CCL_SEQSEL_RS_gc}CCL_SEQSEL_t;
+#define CCL_EDGEDET_bm 0x80
+#define CCL_EDGEDET_bp 7
+#define CCL_CLKSRC_bm 0x40
+#define CCL_CLKSRC_bp 6
+#define CCL_FILTSEL_gm 0x30
+typedef enum{CCL_FILTSEL_DISABLE_gc=0,CCL_FILTSEL_SYNCH_gc=0x10,CCL_FILTSEL_FILTER_gc=0x20}CCL_FILTSEL_t;
+#define CCL_OUTEN_bm 0x08
+#define CCL_OUTEN_bp 3
+#define CCL_INSEL0_gp 0
+#define CCL_INSEL1_gp 4
+#define CCL_INSEL2_gp 0
+
+/* AC */
+typedef struct{ register8_t CTRLA,r0,MUXCTRLA,r1[3],INTCTRL,STATUS; }AC_t;
+extern AC_t AC0, AC1, AC2;
+#define AC_ENABLE_bm 0x01
+#define AC_ENABLE_bp 0
+#define AC_HYSMODE_gm 0x06
+typedef enum{AC_HYSMODE_OFF_gc=0,AC_HYSMODE_10mV_gc=2,AC_HYSMODE_25mV_gc=4,AC_HYSMODE_50mV_gc=6}AC_HYSMODE_t;
+#define AC_LPMODE_bm 0x08
+#define AC_LPMODE_bp 3
+#define AC_INTMODE_gm 0x30
+typedef enum{AC_INTMODE_BOTHEDGE_gc=0,AC_INTMODE_NEGEDGE_gc=0x20,AC_INTMODE_POSEDGE_gc=0x30}AC_INTMODE_t;
+#define AC_OUTEN_bm 0x40
+#define AC_OUTEN_bp 6
+#define AC_RUNSTDBY_bm 0x80
+#define AC_RUNSTDBY_bp 7
+#define AC_MUXNEG_gm 0x03
+typedef enum{AC_MUXNEG_PIN0_gc=0,AC_MUXNEG_PIN1_gc,AC_MUXNEG_VREF_gc,AC_MUXNEG_DAC_gc}AC_MUXNEG_t;
+#define AC_MUXPOS_gm 0x18
+typedef enum{AC_MUXPOS_PIN0_gc=0,AC_MUXPOS_PIN1_gc=0x08,AC_MUXPOS_PIN2_gc=0x10,AC_MUXPOS_PIN3_gc=0x18}AC_MUXPOS_t;
+#define AC_INVERT_bm 0x80
+#define AC_INVERT_bp 7
+#define AC_CMP_bm 0x01
+#define AC_CMP_bp 0
+#define AC_STATE_bm 0x10
+/* DAC */
+typedef struct{ register8_t CTRLA,DATA; }DAC_t;
+extern DAC_t DAC0, DAC1, DAC2;
+#define DAC_ENABLE_bm 0x01
+#define DAC_ENABLE_bp 0
+#define DAC_OUTEN_bm 0x40
+#define DAC_OUTEN_bp 6
+#define DAC_RUNSTDBY_bm 0x80
+#define DAC_RUNSTDBY_bp 7
+
+/* TWI */
+typedef struct{ register8_t CTRLA,DUALCTRL,DBGCTRL,MCTRLA,MCTRLB,MSTATUS,MBAUD,MADDR,MDATA,SCTRLA,SCTRLB,SSTATUS,SADDR,SDATA,SADDRMASK; }TWI_t;
+extern TWI_t TWI0;
+#define TWI_FMPEN_bm 0x02
+#define TWI_FMPEN_bp 1
+#define TWI_SDASETUP_bm 0x10
+#define TWI_RIEN_bm 0x80
+#define TWI_RIEN_bp 7
+#define TWI_WIEN_bm 0x40
+#define TWI_WIEN_bp 6
+#define TWI_QCEN_bm 0x10
+#define TWI_SMEN_bm 0x02
+#define TWI_SMEN_bp 1
+#define TWI_ENABLE_bm 0x01
+#define TWI_ENABLE_bp 0
+typedef enum{TWI_TIMEOUT_DISABLED_gc=0,TWI_TIMEOUT_50US_gc=4,TWI_TIMEOUT_100US_gc=8,TWI_TIMEOUT_200US_gc=12}TWI_TIMEOUT_t;
+#define TWI_FLUSH_bm 0x08
+#define TWI_ACKACT_bm 0x04
+#define TWI_ACKACT_bp 2
+typedef enum{TWI_MCMD_NOACT_gc=0,TWI_MCMD_REPSTART_gc,TWI_MCMD_RECVTRANS_gc,TWI_MCMD_STOP_gc}TWI_MCMD_t;
+#define TWI_RIF_bm 0x80
+#define TWI_WIF_bm 0x40
+#define TWI_CLKHOLD_bm 0x20
+#define TWI_RXACK_bm 0x10
+#define TWI_ARBLOST_bm 0x08
+#define TWI_BUSERR_bm 0x04
+#define TWI_BUSSTATE_gm 0x03
+typedef enum{TWI_BUSSTATE_UNKNOWN_gc=0,TWI_BUSSTATE_IDLE_gc,TWI_BUSSTATE_OWNER_gc,TWI_BUSSTATE_BUSY_gc}TWI_BUSSTATE_t;
+#define TWI_DIEN_bm 0x80
+#define TWI_DIEN_bp 7
+#define TWI_APIEN_bm 0x40
+#define TWI_APIEN_bp 6
+#define TWI_PIEN_bm 0x20
+#define TWI_PIEN_bp 5
+#define TWI_PMEN_bm 0x04
+typedef enum{TWI_SCMD_NOACT_gc=0,TWI_SCMD_COMPTRANS_gc=2,TWI_SCMD_RESPONSE_gc=3}TWI_SCMD_t;
+#define TWI_DIF_bm 0x80
+#define TWI_APIF_bm 0x40
+#define TWI_COLL_bm 0x08
+#define TWI_DIR_bm 0x02
+#define TWI_AP_bm 0x01
+
+/* CRCSCAN */
+typedef struct{ register8_t CTRLA,CTRLB,STATUS; }CRCSCAN_t;
+extern CRCSCAN_t CRCSCAN;
+#define CRCSCAN_RESET_bm 0x80
+#define CRCSCAN_RESET_bp 7
+#define CRCSCAN_NMIEN_bm 0x02
+#define CRCSCAN_NMIEN_bp 1
+#define CRCSCAN_ENABLE_bm 0x01
+#define CRCSCAN_ENABLE_bp 0
+#define CRCSCAN_SRC_gm 0x03
+typedef enum{CRCSCAN_SRC_FLASH_gc=0,CRCSCAN_SRC_APPLICATION_gc,CRCSCAN_SRC_BOOT_gc}CRCSCAN_SRC_t;
+#define CRCSCAN_MODE_gm 0x30
+typedef enum{CRCSCAN_MODE_PRIORITY_gc=0}CRCSCAN_MODE_t;
+#define CRCSCAN_OK_bm 0x02
+#define CRCSCAN_BUSY_bm 0x01
+
+#endif //mock_io_H
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
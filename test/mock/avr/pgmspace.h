@@ -0,0 +1,27 @@
+/*!****************************************************************************
+* @file    pgmspace.h
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Host stand-in for <avr/pgmspace.h>, flash is ordinary memory
+*/
+
+#ifndef mock_pgmspace_H
+#define mock_pgmspace_H
+
+/*!****************************************************************************
+* Include
+*/
+#include <stdint.h>
+
+/*!****************************************************************************
+* User macro
+*/
+#define PROGMEM
+#define PSTR(s)                                 (s)
+#define pgm_read_byte(p)                        (*(const uint8_t *)(p))
+#define pgm_read_word(p)                        (*(const uint16_t *)(p))
+#define pgm_read_dword(p)                       (*(const uint32_t *)(p))
+
+#endif //mock_pgmspace_H
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
@@ -0,0 +1,23 @@
+/*!****************************************************************************
+* @file    sleep.h
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Host stand-in for <avr/sleep.h>
+*/
+
+#ifndef mock_sleep_H
+#define mock_sleep_H
+
+/*!****************************************************************************
+* Include
+*/
+#include "sim.h"
+
+/*!****************************************************************************
+* User macro
+*/
+#define sleep_cpu()                             sim_sleep()
+
+#endif //mock_sleep_H
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
@@ -0,0 +1,18 @@
+/*!****************************************************************************
+* @file    wdt.h
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Host stand-in for <avr/wdt.h>, watchdog is not modelled
+*/
+
+#ifndef mock_wdt_H
+#define mock_wdt_H
+
+/*!****************************************************************************
+* User macro
+*/
+#define wdt_reset()                             do{}while(0)
+
+#endif //mock_wdt_H
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
@@ -0,0 +1,830 @@
+/*!****************************************************************************
+* @file    sim.c
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Register-level peripheral models behind the host <avr/io.h>
+* @note     Modelled: CLKCTRL oscillator status, TCA0 and TCB counting in
+*           periodic modes (TCB stopped in sleep as by RUNSTDBY), ADC conversions with accumulation and window
+*           compare, SPI0 master transfers, USART0 frames, NVMCTRL EEPROM
+*           commands, RTC counter and PIT. Other peripherals are plain memory
+*/
+
+/*!****************************************************************************
+* Include
+*/
+#include "sim.h"
+#include <string.h>
+
+/*!****************************************************************************
+* Local define
+*/
+#define SIM_RTC_HZ                              32768UL
+#define SIM_RTC_1K_HZ                           1024UL
+#define SIM_OSC20M_HZ                           20000000UL
+#define SIM_OSC16M_HZ                           16000000UL
+#define SIM_OSC32K_HZ                           32768UL
+#define SIM_USART_FRAME_BITS                    10                              //8N1
+#define SIM_SPI_FRAME_BITS                      8
+#define SIM_ADC_CONV_ADD                        2                               //ADC clocks on top of SAMPLEN and resolution
+#define SIM_ISR_PER_STEP                        1                               //Runs of one vector per step, stops a handler not clearing its flag
+#define SIM_TCB_NUM                             2
+
+/*!****************************************************************************
+* Local macro
+*/
+#define SIM_CLEAR(x)                            memset((void *)&(x), 0, sizeof(x))
+
+/*!****************************************************************************
+* Local typedef
+*/
+typedef struct{
+    void                (*vect)(void);
+    volatile uint16_t   *pReg;                                                  //Flag register
+    uint8_t             *pFlags;                                                //Model copy of the flags
+    register8_t         *pEn;                                                   //Interrupt control register
+    uint8_t             mask;                                                   //Flags served by the vector
+    uint8_t             enShift;                                                //Enable bit position below its flag
+    uint8_t             ack;                                                    //Flags cleared by vector execution
+}simIrq_type;
+
+typedef struct{
+    uint32_t            acc;                                                    //Prescaler remainder
+    uint8_t             flags;
+}simTc_type;
+
+typedef struct{
+    uint32_t            remain;                                                 //Cycles left of conversion
+    uint16_t            in[SIM_ADC_MUX_NUM];
+    uint8_t             flags;
+    bool                busy;
+}simAdc_type;
+
+typedef struct{
+    simSpiSlave_type    slave;
+    uint32_t            remain;
+    uint8_t             tx;
+    uint8_t             flags;
+    bool                busy;
+}simSpi_type;
+
+typedef struct{
+    uint8_t             rx[SIM_RX_SIZE];
+    uint16_t            rxHead;
+    uint16_t            rxTail;
+    uint32_t            rxRemain;                                               //Cycles until next byte is received
+    uint32_t            txRemain;                                               //Cycles until shift register is empty
+    uint8_t             txBuf;
+    uint8_t             flags;
+    bool                txBufFull;
+    bool                rxSeen;                                                 //RXCIF was visible to the previous access
+}simUsart_type;
+
+typedef struct{
+    uint64_t            acc;
+    uint64_t            pitAcc;
+    uint8_t             flags;
+    uint8_t             pitFlags;
+}simRtc_type;
+
+/*!****************************************************************************
+* Local function prototypes
+*/
+void simStep(eSimPer per, uint32_t cyc);
+void simSync(void);
+void simPublish(void);
+void simDispatch(void);
+void simFlagsSync(simReg8_t *pReg, uint8_t *pFlags, uint8_t w1c);
+bool simStrobe(simReg8_t *pReg);
+uint32_t simTicks(uint32_t *pAcc, uint32_t cyc, uint32_t div);
+void simLog(simLog_type *pLog, uint8_t data);
+void simClkctrlRun(void);
+void simTcaRun(uint32_t cyc);
+void simTcbRun(uint8_t n, uint32_t cyc);
+void simAdcRun(uint8_t n, uint32_t cyc);
+void simSpiSync(void);
+void simSpiRun(uint32_t cyc);
+uint32_t simUsartFrameCyc(void);
+void simUsartSync(void);
+void simUsartRun(eSimPer per, uint32_t cyc);
+void simUsartDre(void);
+void simNvmSync(void);
+void simNvmRun(uint32_t cyc);
+void simRtcRun(uint32_t cyc);
+
+/*!****************************************************************************
+* Vectors, resolved to NULL when the test links no handler
+*/
+void TCA0_OVF_vect(void) __attribute__((weak));
+void TCB0_INT_vect(void) __attribute__((weak));
+void TCB1_INT_vect(void) __attribute__((weak));
+void ADC0_RESRDY_vect(void) __attribute__((weak));
+void ADC1_RESRDY_vect(void) __attribute__((weak));
+void SPI0_INT_vect(void) __attribute__((weak));
+void USART0_RXC_vect(void) __attribute__((weak));
+void USART0_DRE_vect(void) __attribute__((weak));
+void USART0_TXC_vect(void) __attribute__((weak));
+void RTC_CNT_vect(void) __attribute__((weak));
+void RTC_PIT_vect(void) __attribute__((weak));
+
+/*!****************************************************************************
+* MEMORY
+*/
+PORT_t simPortA, simPortB, simPortC;
+EVSYS_t EVSYS;
+TCD_t TCD0;
+CPU_t CPU;
+VREF_t VREF;
+WDT_t WDT;
+RSTCTRL_t RSTCTRL;
+SLPCTRL_t SLPCTRL;
+FUSE_t FUSE;
+CCL_t CCL;
+AC_t AC0, AC1, AC2;
+DAC_t DAC0, DAC1, DAC2;
+TWI_t TWI0;
+CRCSCAN_t CRCSCAN;
+CLKCTRL_t simClkctrl;
+TCA_t simTca0;
+TCB_t simTcb[SIM_TCB_NUM];
+ADC_t simAdcReg[SIM_ADC_NUM];
+SPI_t simSpi0;
+USART_t simUsart0;
+NVMCTRL_t simNvmctrl;
+RTC_t simRtcReg;
+void *const simPer[simPerNum] = {
+    &simClkctrl, &simTca0, &simTcb[0], &simTcb[1], &simAdcReg[0], &simAdcReg[1], &simSpi0, &simUsart0, &simNvmctrl, &simRtcReg
+};
+simTc_type simTca;
+simTc_type simTcbSt[SIM_TCB_NUM];
+simAdc_type simAdc[SIM_ADC_NUM];
+simSpi_type simSpi;
+simUsart_type simUsart;
+uint32_t simNvmRemain;
+simRtc_type simRtc;
+uint8_t simSleepCtrl;                                                           //SLPCTRL.CTRLA while core sleeps, 0 awake
+const simIrq_type simIrq[] = {
+    {TCA0_OVF_vect,     &simTca0.SINGLE.INTFLAGS,   &simTca.flags,          &simTca0.SINGLE.INTCTRL,    TCA_SINGLE_OVF_bm,  0,  0},
+    {TCB0_INT_vect,     &simTcb[0].INTFLAGS,        &simTcbSt[0].flags,     &simTcb[0].INTCTRL,         TCB_CAPT_bm,        0,  0},
+    {TCB1_INT_vect,     &simTcb[1].INTFLAGS,        &simTcbSt[1].flags,     &simTcb[1].INTCTRL,         TCB_CAPT_bm,        0,  0},
+    {ADC0_RESRDY_vect,  &simAdcReg[0].INTFLAGS,     &simAdc[0].flags,       &simAdcReg[0].INTCTRL,      ADC_RESRDY_bm,      0,  ADC_RESRDY_bm},
+    {ADC1_RESRDY_vect,  &simAdcReg[1].INTFLAGS,     &simAdc[1].flags,       &simAdcReg[1].INTCTRL,      ADC_RESRDY_bm,      0,  ADC_RESRDY_bm},
+    {SPI0_INT_vect,     &simSpi0.INTFLAGS,          &simSpi.flags,          &simSpi0.INTCTRL,           SPI_IF_bm,          7,  SPI_IF_bm},
+    {USART0_RXC_vect,   &simUsart0.STATUS,          &simUsart.flags,        &simUsart0.CTRLA,           USART_RXCIF_bm,     0,  USART_RXCIF_bm},
+    {USART0_DRE_vect,   &simUsart0.STATUS,          &simUsart.flags,        &simUsart0.CTRLA,           USART_DREIF_bm,     0,  0},
+    {USART0_TXC_vect,   &simUsart0.STATUS,          &simUsart.flags,        &simUsart0.CTRLA,           USART_TXCIF_bm,     0,  0},
+    {RTC_CNT_vect,      &simRtcReg.INTFLAGS,        &simRtc.flags,          &simRtcReg.INTCTRL,         RTC_OVF_bm | RTC_CMP_bm, 0, 0},
+    {RTC_PIT_vect,      &simRtcReg.PITINTFLAGS,     &simRtc.pitFlags,       &simRtcReg.PITINTCTRL,      RTC_PI_bm,          0,  0},
+};
+uint8_t simEeprom[SIM_EEPROM_SIZE] __attribute__((aligned(EEPROM_PAGE_SIZE)));
+simLog_type simSpiLog;
+simLog_type simUsartLog;
+simStat_type simStat;
+const uint8_t simPdivDiv[] = {2, 4, 8, 16, 32, 64, 0, 0, 6, 10, 12, 24, 48};
+const uint16_t simTcaDiv[] = {1, 2, 4, 8, 16, 64, 256, 1024};
+const uint8_t simSpiDiv[] = {4, 16, 64, 128};
+
+/*!****************************************************************************
+* @brief    Bring all registers and models to their reset state
+*/
+void sim_reset(void){
+    SIM_CLEAR(simPortA);
+    SIM_CLEAR(simPortB);
+    SIM_CLEAR(simPortC);
+    SIM_CLEAR(EVSYS);
+    SIM_CLEAR(TCD0);
+    SIM_CLEAR(CPU);
+    SIM_CLEAR(VREF);
+    SIM_CLEAR(WDT);
+    SIM_CLEAR(RSTCTRL);
+    SIM_CLEAR(SLPCTRL);
+    SIM_CLEAR(FUSE);
+    SIM_CLEAR(CCL);
+    SIM_CLEAR(AC0);
+    SIM_CLEAR(AC1);
+    SIM_CLEAR(AC2);
+    SIM_CLEAR(DAC0);
+    SIM_CLEAR(DAC1);
+    SIM_CLEAR(DAC2);
+    SIM_CLEAR(TWI0);
+    SIM_CLEAR(CRCSCAN);
+    SIM_CLEAR(simClkctrl);
+    SIM_CLEAR(simTca0);
+    SIM_CLEAR(simTcb);
+    SIM_CLEAR(simAdcReg);
+    SIM_CLEAR(simSpi0);
+    SIM_CLEAR(simUsart0);
+    SIM_CLEAR(simNvmctrl);
+    SIM_CLEAR(simRtcReg);
+    SIM_CLEAR(simTca);
+    SIM_CLEAR(simTcbSt);
+    SIM_CLEAR(simAdc);
+    SIM_CLEAR(simSpi);
+    SIM_CLEAR(simUsart);
+    SIM_CLEAR(simRtc);
+    simNvmRemain = 0;
+    simSleepCtrl = 0;
+    //Reset values the drivers depend on: 20 MHz oscillator divided by 6
+    FUSE.OSCCFG = FREQSEL_20MHZ_gc;
+    simClkctrl.MCLKCTRLB = CLKCTRL_PDIV_6X_gc | CLKCTRL_PEN_bm;
+    simTca0.SINGLE.PER = 0xFFFF;
+    simRtcReg.PER = 0xFFFF;
+    simNvmctrl.CTRLA = SIM_WR_MARK;
+    simSpi0.DATA = SIM_WR_MARK;
+    simUsart0.TXDATAL = SIM_WR_MARK;
+    memset(simEeprom, 0xFF, sizeof(simEeprom));
+    sim_clearStat();
+    simSync();
+    simPublish();
+}
+
+/*!****************************************************************************
+* @brief    Clear counters and output logs
+*/
+void sim_clearStat(void){
+    memset(&simStat, 0, sizeof(simStat));
+    memset(&simSpiLog, 0, sizeof(simSpiLog));
+    memset(&simUsartLog, 0, sizeof(simUsartLog));
+}
+
+/*!****************************************************************************
+* @brief    Let time pass without register accesses
+* @param    cycles - CLK_PER cycles
+*/
+void sim_run(uint32_t cycles){
+    uint32_t cyc;
+
+    while(cycles != 0){
+        cyc = (cycles > SIM_STEP_CYC) ? SIM_STEP_CYC : cycles;
+        simStep(simPerNum, cyc);
+        cycles -= cyc;
+    }
+}
+
+/*!****************************************************************************
+* @brief    Sleeping core, returns after the first interrupt handler has run
+* @note     Ends after SIM_SLEEP_MAX_US if nothing wakes the core up
+*/
+void sim_sleep(void){
+    uint32_t isr, cyc;
+
+    isr = simStat.isr;
+    cyc = 0;
+    simSleepCtrl = SLPCTRL.CTRLA;
+    while((simStat.isr == isr) && (cyc < sim_usToCyc(SIM_SLEEP_MAX_US))){
+        simStep(simPerNum, SIM_SLEEP_STEP_CYC);
+        cyc += SIM_SLEEP_STEP_CYC;
+    }
+    simSleepCtrl = 0;
+}
+
+/*!****************************************************************************
+* @brief    Peripheral clock from CLKCTRL and FUSE settings
+*/
+uint32_t sim_getClkPerHz(void){
+    uint32_t hz;
+    uint8_t div;
+
+    switch(simClkctrl.MCLKCTRLA & CLKCTRL_CLKSEL_gm){
+        case CLKCTRL_CLKSEL_OSC20M_gc:
+            hz = ((FUSE.OSCCFG & FUSE_FREQSEL_gm) == FREQSEL_16MHZ_gc) ? SIM_OSC16M_HZ : SIM_OSC20M_HZ;
+            break;
+        default:
+            hz = SIM_OSC32K_HZ;
+            break;
+    }
+    if(simClkctrl.MCLKCTRLB & CLKCTRL_PEN_bm){
+        div = simPdivDiv[(simClkctrl.MCLKCTRLB & CLKCTRL_PDIV_gm) >> CLKCTRL_PDIV_gp];
+        if(div != 0) hz /= div;
+    }
+
+    return hz;
+}
+
+/*!****************************************************************************
+* @brief    Set analog input seen by ADC
+* @param    adcNum - 0 or 1
+* @param    muxPos - MUXPOS value
+* @param    value - 10 bit conversion result
+*/
+void sim_setAdcInput(uint8_t adcNum, uint8_t muxPos, uint16_t value){
+    if((adcNum < SIM_ADC_NUM) && (muxPos < SIM_ADC_MUX_NUM)){
+        simAdc[adcNum].in[muxPos] = value & 0x3FF;
+    }
+}
+
+/*!****************************************************************************
+* @brief    Set device answering SPI transfers
+* @param    slave - callback returning MISO byte, NULL for MOSI-MISO loopback
+*/
+void sim_setSpiSlave(simSpiSlave_type slave){
+    simSpi.slave = slave;
+}
+
+/*!****************************************************************************
+* @brief    Queue bytes to arrive at USART0 receiver, one per frame time
+* @param    *pData - bytes
+* @param    size - number of bytes, excess over the queue is dropped
+*/
+void sim_usartRx(const uint8_t *pData, uint16_t size){
+    uint16_t next;
+
+    while(size--){
+        next = (simUsart.rxHead + 1) % SIM_RX_SIZE;
+        if(next == simUsart.rxTail) break;
+        simUsart.rx[simUsart.rxHead] = *pData++;
+        simUsart.rxHead = next;
+    }
+}
+
+/*!****************************************************************************
+* @brief    Access hook of modelled peripheral instances
+* @param    per - peripheral accessed
+* @return   Register block of the peripheral
+*/
+void *sim_access(eSimPer per){
+    simStat.access[per]++;
+    simStep(per, SIM_STEP_CYC);
+
+    return simPer[per];
+}
+
+/*!****************************************************************************
+* @brief    Advance all models
+* @param    per - peripheral being accessed, simPerNum if none
+* @param    cyc - CLK_PER cycles to advance
+*/
+void simStep(eSimPer per, uint32_t cyc){
+    uint8_t i;
+
+    simStat.steps++;
+    simStat.cycles += cyc;
+    simSync();
+    simClkctrlRun();
+    simTcaRun(cyc);
+    for(i = 0; i < SIM_TCB_NUM; i++){
+        simTcbRun(i, cyc);
+    }
+    for(i = 0; i < SIM_ADC_NUM; i++){
+        simAdcRun(i, cyc);
+    }
+    simSpiRun(cyc);
+    simUsartRun(per, cyc);
+    simNvmRun(cyc);
+    simRtcRun(cyc);
+    simPublish();
+    simDispatch();
+}
+
+/*!****************************************************************************
+* @brief    Take stores made by drivers since the previous step
+*/
+void simSync(void){
+    uint8_t i;
+
+    simFlagsSync(&simTca0.SINGLE.INTFLAGS, &simTca.flags, 0xFF);
+    for(i = 0; i < SIM_TCB_NUM; i++){
+        simFlagsSync(&simTcb[i].INTFLAGS, &simTcbSt[i].flags, 0xFF);
+    }
+    for(i = 0; i < SIM_ADC_NUM; i++){
+        simFlagsSync(&simAdcReg[i].INTFLAGS, &simAdc[i].flags, 0xFF);
+    }
+    simSpiSync();
+    simUsartSync();
+    simNvmSync();
+    simFlagsSync(&simRtcReg.INTFLAGS, &simRtc.flags, 0xFF);
+    simFlagsSync(&simRtcReg.PITINTFLAGS, &simRtc.pitFlags, 0xFF);
+}
+
+/*!****************************************************************************
+* @brief    Show flags set by the models in their registers
+*/
+void simPublish(void){
+    uint8_t i;
+
+    for(i = 0; i < sizeof(simIrq) / sizeof(simIrq[0]); i++){
+        *simIrq[i].pReg = *simIrq[i].pFlags | SIM_WR_MARK;
+    }
+}
+
+/*!****************************************************************************
+* @brief    Run handlers of pending interrupts if they are enabled globally
+* @note     Core clears I bit for the handler. Stores made by the handler are
+*           taken before the interrupted access completes
+*/
+void simDispatch(void){
+    const simIrq_type *pIrq;
+    uint8_t i, runs[sizeof(simIrq) / sizeof(simIrq[0])] = {0};
+    bool isRun;
+
+    do{
+        isRun = false;
+        for(i = 0; i < sizeof(simIrq) / sizeof(simIrq[0]); i++){
+            pIrq = &simIrq[i];
+            if(((SREG & CPU_I_bm) == 0) || (pIrq->vect == NULL) || (runs[i] >= SIM_ISR_PER_STEP)){
+                continue;
+            }
+            if((*pIrq->pFlags & (uint8_t)(*pIrq->pEn << pIrq->enShift) & pIrq->mask) == 0){
+                continue;
+            }
+            *pIrq->pFlags &= ~pIrq->ack;
+            *pIrq->pReg = *pIrq->pFlags | SIM_WR_MARK;
+            SREG &= ~CPU_I_bm;
+            //Interrupt wakes the core up
+            simSleepCtrl = 0;
+            pIrq->vect();
+            SREG |= CPU_I_bm;
+            simStat.isr++;
+            runs[i]++;
+            simSync();
+            simPublish();
+            isRun = true;
+        }
+    }while(isRun);
+}
+
+/*!****************************************************************************
+* @brief    Take a store to a flag register and show model flags in it
+* @param    *pReg - register
+* @param    *pFlags - model copy of the flags
+* @param    w1c - flags cleared by writing one
+* @note     A store clears SIM_WR_MARK. A read-modify-write keeps the mark, it
+*           is seen only if it changed the value and then clears everything
+*           it wrote back, as hardware does
+*/
+void simFlagsSync(simReg8_t *pReg, uint8_t *pFlags, uint8_t w1c){
+    uint16_t val = *pReg;
+
+    if(((val & SIM_WR_MARK) == 0) || ((uint8_t)val != *pFlags)){
+        *pFlags &= ~((uint8_t)val & w1c);
+    }
+    *pReg = *pFlags | SIM_WR_MARK;
+}
+
+/*!****************************************************************************
+* @brief    Check strobe register for a store and re-arm it
+* @param    *pReg - register
+* @return   true if the register was written since the previous call
+*/
+bool simStrobe(simReg8_t *pReg){
+    if(*pReg & SIM_WR_MARK){
+        return false;
+    }
+    *pReg |= SIM_WR_MARK;
+
+    return true;
+}
+
+/*!****************************************************************************
+* @brief    Prescale cycles keeping the remainder
+* @param    *pAcc - remainder
+* @param    cyc - input cycles
+* @param    div - prescaler
+* @return   Output ticks
+*/
+uint32_t simTicks(uint32_t *pAcc, uint32_t cyc, uint32_t div){
+    uint32_t ticks;
+
+    *pAcc += cyc;
+    ticks = *pAcc / div;
+    *pAcc %= div;
+
+    return ticks;
+}
+
+/*!****************************************************************************
+* @brief    Microseconds to CLK_PER cycles at current clock
+* @param    us - time
+*/
+uint32_t sim_usToCyc(uint32_t us){
+    return (uint32_t)((uint64_t)us * sim_getClkPerHz() / 1000000UL);
+}
+
+/*!****************************************************************************
+* @brief    Append byte to output log
+*/
+void simLog(simLog_type *pLog, uint8_t data){
+    if(pLog->len < SIM_LOG_SIZE){
+        pLog->buf[pLog->len++] = data;
+    }
+}
+
+/*!****************************************************************************
+* @brief    Oscillators are stable at once, clock switch completes at once
+*/
+void simClkctrlRun(void){
+    uint8_t status = CLKCTRL_OSC20MS_bm | CLKCTRL_OSC32KS_bm;
+
+    if(simClkctrl.XOSC32KCTRLA & CLKCTRL_ENABLE_bm){
+        status |= CLKCTRL_XOSC32KS_bm;
+    }
+    simClkctrl.MCLKSTATUS = status;
+}
+
+/*!****************************************************************************
+* @brief    TCA0 in single mode counting up to PER
+*/
+void simTcaRun(uint32_t cyc){
+    TCA_SINGLE_t *p = &simTca0.SINGLE;
+    uint32_t cnt, top;
+
+    if(!(p->CTRLA & TCA_SINGLE_ENABLE_bm)){
+        return;
+    }
+    cnt = p->CNT + simTicks(&simTca.acc, cyc, simTcaDiv[(p->CTRLA & TCA_SINGLE_CLKSEL_gm) >> TCA_SINGLE_CLKSEL_gp]);
+    top = p->PER;
+    if(cnt > top){
+        simTca.flags |= TCA_SINGLE_OVF_bm;
+        cnt = (cnt - top - 1) % (top + 1);
+    }
+    p->CNT = cnt;
+}
+
+/*!****************************************************************************
+* @brief    TCB in periodic interrupt mode, other modes hold the counter
+* @param    n - instance
+* @note     Stopped in power-down, and in standby without RUNSTDBY
+*/
+void simTcbRun(uint8_t n, uint32_t cyc){
+    TCB_t *p = &simTcb[n];
+    uint32_t cnt, top;
+    uint8_t smode;
+
+    if(!(p->CTRLA & TCB_ENABLE_bm) || ((p->CTRLB & TCB_CNTMODE_gm) != TCB_CNTMODE_INT_gc)){
+        return;
+    }
+    smode = simSleepCtrl & SLPCTRL_SMODE_gm;
+    if((simSleepCtrl & SLPCTRL_SEN_bm) && ((smode == SLPCTRL_SMODE_PDOWN_gc) || ((smode == SLPCTRL_SMODE_STDBY_gc) && !(p->CTRLA & TCB_RUNSTDBY_bm)))){
+        return;
+    }
+    cnt = p->CNT + simTicks(&simTcbSt[n].acc, cyc, ((p->CTRLA & TCB_CLKSEL_gm) == TCB_CLKSEL_CLKDIV2_gc) ? 2 : 1);
+    top = p->CCMP;
+    if(cnt > top){
+        simTcbSt[n].flags |= TCB_CAPT_bm;
+        cnt = (cnt - top - 1) % (top + 1);
+    }
+    p->CNT = cnt;
+}
+
+/*!****************************************************************************
+* @brief    ADC conversion started by STCONV or free running
+* @param    n - instance
+* @note     Conversion takes SAMPLEN + 2 + resolution ADC clocks per sample
+*/
+void simAdcRun(uint8_t n, uint32_t cyc){
+    ADC_t *p = &simAdcReg[n];
+    simAdc_type *pAdc = &simAdc[n];
+    uint32_t res, clocks;
+    bool is8bit, isIn;
+
+    if(!(p->CTRLA & ADC_ENABLE_bm)){
+        pAdc->busy = false;
+        return;
+    }
+    is8bit = (p->CTRLA & ADC_RESSEL_bm) != 0;
+    if(!pAdc->busy && ((p->COMMAND & ADC_STCONV_bm) || (p->CTRLA & ADC_FREERUN_bm))){
+        clocks = (p->SAMPCTRL & ADC_SAMPLEN_gm) + SIM_ADC_CONV_ADD + (is8bit ? 8 : 10);
+        pAdc->remain = clocks * (2UL << (p->CTRLC & ADC_PRESC_gm)) << (p->CTRLB & ADC_SAMPNUM_gm);
+        pAdc->flags &= ~ADC_RESRDY_bm;
+        pAdc->busy = true;
+        return;
+    }
+    if(!pAdc->busy){
+        return;
+    }
+    if(cyc < pAdc->remain){
+        pAdc->remain -= cyc;
+        return;
+    }
+    pAdc->busy = false;
+    res = pAdc->in[p->MUXPOS & ADC_MUXPOS_gm];
+    if(is8bit) res >>= 2;
+    res <<= (p->CTRLB & ADC_SAMPNUM_gm);
+    p->RES = res;
+    p->COMMAND &= ~ADC_STCONV_bm;
+    pAdc->flags |= ADC_RESRDY_bm;
+    switch(p->CTRLE & ADC_WINCM_gm){
+        case ADC_WINCM_BELOW_gc:
+            isIn = res < p->WINLT;
+            break;
+        case ADC_WINCM_ABOVE_gc:
+            isIn = res > p->WINHT;
+            break;
+        case ADC_WINCM_INSIDE_gc:
+            isIn = (res > p->WINLT) && (res < p->WINHT);
+            break;
+        case ADC_WINCM_OUTSIDE_gc:
+            isIn = (res < p->WINLT) || (res > p->WINHT);
+            break;
+        default:
+            isIn = false;
+            break;
+    }
+    if(isIn){
+        pAdc->flags |= ADC_WCMP_bm;
+    }
+}
+
+/*!****************************************************************************
+* @brief    Store to DATA starts a master transfer and clears IF
+*/
+void simSpiSync(void){
+    if(simStrobe(&simSpi0.DATA)){
+        simSpi.flags &= ~SPI_IF_bm;
+        if((simSpi0.CTRLA & SPI_ENABLE_bm) && (simSpi0.CTRLA & SPI_MASTER_bm)){
+            simSpi.tx = (uint8_t)simSpi0.DATA;
+            simSpi.remain = SIM_SPI_FRAME_BITS * simSpiDiv[(simSpi0.CTRLA & SPI_PRESC_gm) >> SPI_PRESC_gp];
+            if(simSpi0.CTRLA & SPI_CLK2X_bm) simSpi.remain >>= 1;
+            simSpi.busy = true;
+        }
+    }
+    simFlagsSync(&simSpi0.INTFLAGS, &simSpi.flags, 0);
+}
+
+/*!****************************************************************************
+* @brief    Shift the transfer, MISO byte is put to DATA at its end
+*/
+void simSpiRun(uint32_t cyc){
+    uint8_t rx;
+
+    if(!simSpi.busy){
+        return;
+    }
+    if(cyc < simSpi.remain){
+        simSpi.remain -= cyc;
+        return;
+    }
+    simSpi.busy = false;
+    simLog(&simSpiLog, simSpi.tx);
+    rx = (simSpi.slave != NULL) ? simSpi.slave(simSpi.tx) : simSpi.tx;
+    simSpi0.DATA = rx | SIM_WR_MARK;
+    simSpi.flags |= SPI_IF_bm;
+}
+
+/*!****************************************************************************
+* @brief    Frame time from BAUD: 64 * f / (S * BAUD) bits per second
+*/
+uint32_t simUsartFrameCyc(void){
+    uint32_t s = ((simUsart0.CTRLB & USART_RXMODE_gm) == USART_RXMODE_CLK2X_gc) ? 8 : 16;
+
+    return (uint32_t)SIM_USART_FRAME_BITS * s * simUsart0.BAUD / 64;
+}
+
+/*!****************************************************************************
+* @brief    Store to TXDATAL goes to the shift register or the buffer
+*/
+void simUsartSync(void){
+    uint8_t data;
+
+    if(simStrobe(&simUsart0.TXDATAL) && (simUsart0.CTRLB & USART_TXEN_bm)){
+        data = (uint8_t)simUsart0.TXDATAL;
+        if(simUsart.txRemain == 0){
+            simLog(&simUsartLog, data);
+            simUsart.txRemain = simUsartFrameCyc() + 1;
+            simUsart.flags &= ~USART_TXCIF_bm;
+        }else if(!simUsart.txBufFull){
+            simUsart.txBuf = data;
+            simUsart.txBufFull = true;
+        }
+    }
+    simUsartDre();
+    simFlagsSync(&simUsart0.STATUS, &simUsart.flags, USART_TXCIF_bm);
+}
+
+/*!****************************************************************************
+* @brief    Transmit frames and deliver queued receive bytes
+* @param    per - peripheral being accessed
+* @note     Data read clears RXCIF: a received byte counts as read at the
+*           USART0 access following the one which could see RXCIF
+*/
+void simUsartRun(eSimPer per, uint32_t cyc){
+    if((per == simPerUsart0) && simUsart.rxSeen){
+        simUsart.flags &= ~USART_RXCIF_bm;
+        simUsart.rxSeen = false;
+    }
+    //Transmitter
+    if(simUsart.txRemain != 0){
+        if(cyc < simUsart.txRemain){
+            simUsart.txRemain -= cyc;
+        }else if(simUsart.txBufFull){
+            simLog(&simUsartLog, simUsart.txBuf);
+            simUsart.txBufFull = false;
+            simUsart.txRemain = simUsartFrameCyc() + 1;
+        }else{
+            simUsart.txRemain = 0;
+            simUsart.flags |= USART_TXCIF_bm;
+        }
+    }
+    //Receiver
+    if((simUsart0.CTRLB & USART_RXEN_bm) && (simUsart.rxHead != simUsart.rxTail)){
+        if(simUsart.rxRemain == 0){
+            simUsart.rxRemain = simUsartFrameCyc() + 1;
+        }
+        if(cyc < simUsart.rxRemain){
+            simUsart.rxRemain -= cyc;
+        }else{
+            simUsart.rxRemain = 0;
+            simUsart0.RXDATAL = simUsart.rx[simUsart.rxTail];
+            simUsart.rxTail = (simUsart.rxTail + 1) % SIM_RX_SIZE;
+            simUsart.flags |= USART_RXCIF_bm;
+        }
+    }
+    simUsartDre();
+    if((per == simPerUsart0) && (simUsart.flags & USART_RXCIF_bm)){
+        simUsart.rxSeen = true;
+    }
+}
+
+/*!****************************************************************************
+* @brief    DREIF is set while transmit buffer is empty
+*/
+void simUsartDre(void){
+    if((simUsart0.CTRLB & USART_TXEN_bm) && !simUsart.txBufFull){
+        simUsart.flags |= USART_DREIF_bm;
+    }else{
+        simUsart.flags &= ~USART_DREIF_bm;
+    }
+}
+
+/*!****************************************************************************
+* @brief    Store to CTRLA runs NVMCTRL command
+* @note     EEPROM data is written through the mapped address at once, the
+*           command only makes EEBUSY last for the write time
+*/
+void simNvmSync(void){
+    uint8_t cmd;
+
+    if(!simStrobe(&simNvmctrl.CTRLA)){
+        return;
+    }
+    cmd = simNvmctrl.CTRLA & 0x07;
+    simNvmctrl.CTRLA = SIM_WR_MARK;
+    if((cmd == NVMCTRL_CMD_NONE_gc) || (simNvmctrl.STATUS & NVMCTRL_EEBUSY_bm)){
+        return;
+    }
+    if(simStat.nvmCmd[cmd] < UINT16_MAX){
+        simStat.nvmCmd[cmd]++;
+    }
+    if(cmd == NVMCTRL_CMD_EEERASE_gc){
+        memset(simEeprom, 0xFF, sizeof(simEeprom));
+        simNvmRemain = sim_usToCyc(SIM_EE_ERASE_US);
+    }else{
+        simNvmRemain = sim_usToCyc(SIM_EE_PAGE_US);
+    }
+    simNvmctrl.STATUS |= NVMCTRL_EEBUSY_bm;
+}
+
+/*!****************************************************************************
+* @brief    Count down EEPROM write time
+*/
+void simNvmRun(uint32_t cyc){
+    if(simNvmRemain == 0){
+        return;
+    }
+    if(cyc < simNvmRemain){
+        simNvmRemain -= cyc;
+        return;
+    }
+    simNvmRemain = 0;
+    simNvmctrl.STATUS &= ~NVMCTRL_EEBUSY_bm;
+}
+
+/*!****************************************************************************
+* @brief    RTC counter with compare and overflow, PIT, registers never busy
+*/
+void simRtcRun(uint32_t cyc){
+    RTC_t *p = &simRtcReg;
+    uint64_t div, ticks, cnt;
+    uint32_t rtcHz, per;
+
+    p->STATUS = 0;
+    p->PITSTATUS = 0;
+    rtcHz = ((p->CLKSEL & RTC_CLKSEL_gm) == RTC_CLKSEL_INT1K_gc) ? SIM_RTC_1K_HZ : SIM_RTC_HZ;
+    if(p->CTRLA & RTC_RTCEN_bm){
+        div = (uint64_t)sim_getClkPerHz() << ((p->CTRLA & RTC_PRESCALER_gm) >> RTC_PRESCALER_gp);
+        simRtc.acc += (uint64_t)cyc * rtcHz;
+        ticks = simRtc.acc / div;
+        simRtc.acc %= div;
+        cnt = p->CNT;
+        if((ticks != 0) && (p->CMP > cnt) && (p->CMP <= cnt + ticks)){
+            simRtc.flags |= RTC_CMP_bm;
+        }
+        cnt += ticks;
+        if(cnt > p->PER){
+            simRtc.flags |= RTC_OVF_bm;
+            cnt = (cnt - p->PER - 1) % ((uint32_t)p->PER + 1);
+        }
+        p->CNT = cnt;
+    }
+    if((p->PITCTRLA & RTC_PITEN_bm) && (p->PITCTRLA & RTC_PERIOD_gm)){
+        per = 2UL << ((p->PITCTRLA & RTC_PERIOD_gm) >> RTC_PERIOD_gp);
+        simRtc.pitAcc += (uint64_t)cyc * rtcHz;
+        div = (uint64_t)sim_getClkPerHz() * per;
+        if(simRtc.pitAcc >= div){
+            simRtc.pitAcc %= div;
+            simRtc.pitFlags |= RTC_PI_bm;
+        }
+    }
+}
+
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
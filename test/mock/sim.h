@@ -0,0 +1,80 @@
+/*!****************************************************************************
+* @file    sim.h
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Register-level peripheral models behind the host <avr/io.h>
+* @note     Time is counted in CLK_PER cycles and advances by a fixed step on
+*           every access to a modelled peripheral, so wait loops terminate
+*           and the number of polls a driver needs is reproducible. Flags
+*           which hardware clears on a read are cleared when the next
+*           operation is started, or on vector execution
+*/
+
+#ifndef sim_H
+#define sim_H
+
+/*!****************************************************************************
+* Include
+*/
+#include <avr/io.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*!****************************************************************************
+* User define
+*/
+#define SIM_STEP_CYC                            4                               //CLK_PER cycles per register access
+#define SIM_LOG_SIZE                            256                             //Bytes kept of SPI and USART output
+#define SIM_RX_SIZE                             256                             //USART receive queue
+#define SIM_EEPROM_SIZE                         256
+#define SIM_EE_PAGE_US                          4000                            //Page erase / write cycle
+#define SIM_EE_ERASE_US                         4000                            //Whole EEPROM erase
+#define SIM_SLEEP_STEP_CYC                      64                              //Time step while core sleeps
+#define SIM_SLEEP_MAX_US                        10000000UL                      //Sleep without wake-up source ends here
+#define SIM_ADC_NUM                             2
+#define SIM_ADC_MUX_NUM                         32
+
+/*!****************************************************************************
+* User macro
+*/
+#define SIM_EEPROM(cell)                        (&simEeprom[cell])              //Mapped EEPROM address for eeprom_read/write
+
+/*!****************************************************************************
+* User typedef
+*/
+typedef uint8_t (*simSpiSlave_type)(uint8_t mosi);                              //Returns MISO byte of the transfer
+
+typedef struct{
+    uint8_t             buf[SIM_LOG_SIZE];
+    uint16_t            len;                                                    //Bytes logged, saturates at SIM_LOG_SIZE
+}simLog_type;
+
+typedef struct{
+    uint64_t            cycles;                                                 //CLK_PER cycles elapsed
+    uint32_t            steps;                                                  //Model steps, each access is one
+    uint32_t            access[simPerNum];                                      //Accesses per modelled peripheral
+    uint32_t            isr;                                                    //Interrupt handlers run
+    uint16_t            nvmCmd[8];                                              //NVMCTRL commands by code
+}simStat_type;
+
+/*!****************************************************************************
+* Prototypes for the functions
+*/
+extern uint8_t simEeprom[SIM_EEPROM_SIZE];
+extern simLog_type simSpiLog;
+extern simLog_type simUsartLog;
+extern simStat_type simStat;
+
+void sim_reset(void);
+void sim_clearStat(void);
+void sim_run(uint32_t cycles);
+void sim_sleep(void);
+uint32_t sim_getClkPerHz(void);
+uint32_t sim_usToCyc(uint32_t us);
+void sim_setAdcInput(uint8_t adcNum, uint8_t muxPos, uint16_t value);
+void sim_setSpiSlave(simSpiSlave_type slave);
+void sim_usartRx(const uint8_t *pData, uint16_t size);
+
+#endif //sim_H
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
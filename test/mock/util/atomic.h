@@ -0,0 +1,44 @@
+/*!****************************************************************************
+* @file    atomic.h
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Host stand-in for <util/atomic.h>
+* @note     Clears SREG I bit for the block so models hold interrupts pending,
+*           the saved SREG is restored on any exit from the block
+*/
+
+#ifndef mock_atomic_H
+#define mock_atomic_H
+
+/*!****************************************************************************
+* Include
+*/
+#include <avr/io.h>
+
+/*!****************************************************************************
+* User define
+*/
+#define ATOMIC_RESTORESTATE                     0
+#define ATOMIC_FORCEON                          1
+
+/*!****************************************************************************
+* User macro
+*/
+#define ATOMIC_BLOCK(type)                      for(uint8_t simSregSave __attribute__((__cleanup__(simAtomicExit))) = SREG, \
+                                                    simAtomicDo = simAtomicEnter(); simAtomicDo; simAtomicDo = 0)
+
+/*!****************************************************************************
+* Prototypes for the functions
+*/
+static __inline__ uint8_t simAtomicEnter(void){
+    SREG &= (uint8_t)~CPU_I_bm;
+    return 1;
+}
+
+static __inline__ void simAtomicExit(const uint8_t *pSreg){
+    SREG = *pSreg;
+}
+
+#endif //mock_atomic_H
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
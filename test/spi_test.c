@@ -0,0 +1,114 @@
+/*!****************************************************************************
+* @file    spi_test.c
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   SPI master transfers against the register-level model
+*/
+
+/*!****************************************************************************
+* Include
+*/
+#include <string.h>
+#include "spi.h"
+#include "clock.h"
+#include "sim.h"
+#include "test_check.h"
+
+/*!****************************************************************************
+* Local define
+*/
+#define TEST_SIZE                               16
+#define TEST_POLL_MAX                           64                              //SPI0 accesses per byte, SCK at CLK_PER / 32
+
+/*!****************************************************************************
+* MEMORY
+*/
+static uint8_t testTx[TEST_SIZE];
+static uint8_t testRx[TEST_SIZE];
+
+/*!****************************************************************************
+* @brief    Slave answering inverted MOSI byte
+*/
+static uint8_t testSlave(uint8_t mosi){
+    return (uint8_t)~mosi;
+}
+
+/*!****************************************************************************
+* @brief    Full duplex transfer reaches the slave and comes back in order
+*/
+static void testTransfer(void){
+    uint32_t hz;
+    uint8_t i;
+
+    for(i = 0; i < TEST_SIZE; i++){
+        testTx[i] = i * 17;
+    }
+    sim_setSpiSlave(testSlave);
+    sim_clearStat();
+    CHECK(spi_transmitReceive(testTx, testRx, TEST_SIZE) == drvNoError);
+    CHECK(simSpiLog.len == TEST_SIZE);
+    CHECK(memcmp(simSpiLog.buf, testTx, TEST_SIZE) == 0);
+    for(i = 0; i < TEST_SIZE; i++){
+        CHECK((uint8_t)(testRx[i] ^ testTx[i]) == 0xFF);
+    }
+    //Busy waiting budget: SCK is the highest not above SPI_SCK_HZ
+    CHECK(clock_getHz(&hz) == drvNoError);
+    CHECK(simStat.cycles >= (uint64_t)TEST_SIZE * 8 * (hz / SPI_SCK_HZ));
+    CHECK(simStat.access[simPerSpi0] <= TEST_SIZE * TEST_POLL_MAX);
+    //Receive sends zeros
+    sim_setSpiSlave(NULL);
+    sim_clearStat();
+    CHECK(spi_receive(testRx, TEST_SIZE) == drvNoError);
+    CHECK(simSpiLog.len == TEST_SIZE);
+    for(i = 0; i < TEST_SIZE; i++){
+        CHECK(testRx[i] == 0);
+    }
+}
+
+/*!****************************************************************************
+* @brief    Transfer that never completes ends on timeout and is counted
+*/
+static void testTimeout(void){
+    uint16_t count;
+
+    timeout_clearCounts();
+    //Slave mode: the model starts no transfer
+    SPI0.CTRLA &= ~SPI_MASTER_bm;
+    CHECK(spi_transmitReceive(testTx, testRx, 1) == drvHwError);
+    CHECK(timeout_getCount(timeoutSiteSpiTxRx, &count) == drvNoError);
+    CHECK(count == 1);
+    SPI0.CTRLA |= SPI_MASTER_bm;
+    CHECK(spi_transmitReceive(testTx, testRx, 1) == drvNoError);
+}
+
+/*!****************************************************************************
+* @brief    Byte time at a slow clock is far over a millisecond, budget follows
+*/
+static void testSlowSck(void){
+    uint16_t count;
+
+    timeout_clearCounts();
+    CHECK(clock_set(CLKCTRL_CLKSEL_OSCULP32K_gc, CLKCTRL_PDIV_2X_gc, false) == drvNoError);
+    CHECK(spi_setSck(256) == drvNoError);
+    CHECK((SPI0.CTRLA & SPI_PRESC_gm) == SPI_PRESC_DIV128_gc);
+    CHECK(spi_transmitReceive(testTx, testRx, 2) == drvNoError);
+    CHECK(timeout_getCount(timeoutSiteSpiTxRx, &count) == drvNoError);
+    CHECK(count == 0);
+    CHECK(spi_setSck(SPI_SCK_HZ) == drvNoError);
+    CHECK(clock_set(CLKCTRL_CLKSEL_OSC20M_gc, CLKCTRL_PDIV_6X_gc, true) == drvNoError);
+}
+
+int main(void){
+    sim_reset();
+    sei();
+    CHECK(spi_init() == drvNoError);
+    CHECK(SPI0.CTRLA & SPI_ENABLE_bm);
+    testTransfer();
+    testTimeout();
+    testSlowSck();
+
+    return TEST_RESULT("spi_test");
+}
+
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
@@ -0,0 +1,139 @@
+/*!****************************************************************************
+* @file    swtimer_test.c
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Software timer wheel on the modelled TCB and its interrupt
+*/
+
+/*!****************************************************************************
+* Include
+*/
+#include "swtimer.h"
+#include "sleepctrl.h"
+#include "sim.h"
+#include "test_check.h"
+
+/*!****************************************************************************
+* Local define
+*/
+#define TEST_PERIOD_TICKS                       10
+#define TEST_PERIODS                            5
+#define TEST_SLEEP_MAX                          (2 * TEST_PERIOD_TICKS)         //Sleeps until the timer must have expired
+
+/*!****************************************************************************
+* MEMORY
+*/
+static uint16_t testCalls;
+static uint32_t testUs;
+
+/*!****************************************************************************
+* @brief    Count expiries
+*/
+static void testCb(void *pArg){
+    (void)pArg;
+    testCalls++;
+}
+
+/*!****************************************************************************
+* @brief    Time source advancing on every call
+*/
+static eDrvError testTimeSrc(uint32_t *pUs){
+    testUs += SWTIMER_TICK_US;
+    *pUs = testUs;
+    return drvNoError;
+}
+
+/*!****************************************************************************
+* @brief    Periodic timer expires once per period, time stamps follow model
+*/
+static void testPeriodic(void){
+    static swTimer_type tim;
+    uint64_t stamp0, stamp1;
+    uint32_t periodCyc;
+
+    periodCyc = sim_usToCyc(TEST_PERIOD_TICKS * SWTIMER_TICK_US);
+    CHECK(swtimer_getStamp(&stamp0) == drvNoError);
+    CHECK(swtimer_start(&tim, TEST_PERIOD_TICKS, TEST_PERIOD_TICKS, testCb, NULL) == drvNoError);
+    sim_run(TEST_PERIODS * periodCyc + periodCyc / 2);
+    CHECK(testCalls == TEST_PERIODS);
+    CHECK(swtimer_getStamp(&stamp1) == drvNoError);
+    CHECK(SWTIMER_STAMP_TO_US(stamp1 - stamp0) >= TEST_PERIODS * TEST_PERIOD_TICKS * SWTIMER_TICK_US);
+    CHECK(swtimer_cancel(&tim) == drvNoError);
+    //No callbacks while interrupts are disabled, one-shot runs once after
+    testCalls = 0;
+    CHECK(swtimer_start(&tim, TEST_PERIOD_TICKS, 0, testCb, NULL) == drvNoError);
+    cli();
+    sim_run(2 * periodCyc);
+    CHECK(testCalls == 0);
+    sei();
+    sim_run(2 * periodCyc);
+    CHECK(testCalls == 1);
+}
+
+/*!****************************************************************************
+* @brief    Sleep is woken up by the timer, armed timers limit sleep to idle
+*/
+static void testSleep(void){
+    static swTimer_type tim;
+    volatile uint8_t flags = 0;
+    SLPCTRL_SMODE_t mode;
+    sleepStat_type stat;
+    uint64_t start;
+    uint16_t count;
+    uint8_t i;
+
+    testCalls = 0;
+    CHECK(sleepctrl_clearStat() == drvNoError);
+    CHECK(swtimer_start(&tim, TEST_PERIOD_TICKS, 0, testCb, NULL) == drvNoError);
+    start = simStat.cycles;
+    while(testCalls == 0){
+        CHECK(sleepctrl_sleepIf(SLPCTRL_SMODE_IDLE_gc, &flags, 0xFF) == drvNoError);
+    }
+    //Started within a tick, so up to one tick short
+    CHECK(simStat.cycles - start >= sim_usToCyc((TEST_PERIOD_TICKS - 1) * SWTIMER_TICK_US));
+    CHECK(sleepctrl_getStat(SLPCTRL_SMODE_IDLE_gc, &stat) == drvNoError);
+    CHECK(stat.count != 0);
+    CHECK(stat.timeUs >= (TEST_PERIOD_TICKS - 1) * SWTIMER_TICK_US);
+    //Armed timer keeps the core in idle, wheel TCB would stop in standby
+    count = stat.count;
+    testCalls = 0;
+    CHECK(swtimer_start(&tim, TEST_PERIOD_TICKS, 0, testCb, NULL) == drvNoError);
+    CHECK(sleepctrl_getMode(&mode) == drvNoError);
+    CHECK(mode == SLPCTRL_SMODE_IDLE_gc);
+    for(i = 0; (testCalls == 0) && (i < TEST_SLEEP_MAX); i++){
+        CHECK(sleepctrl_sleepIf(SLPCTRL_SMODE_STDBY_gc, &flags, 0xFF) == drvNoError);
+    }
+    CHECK(testCalls == 1);
+    CHECK(sleepctrl_getStat(SLPCTRL_SMODE_IDLE_gc, &stat) == drvNoError);
+    CHECK(stat.count > count);
+    CHECK(sleepctrl_getStat(SLPCTRL_SMODE_STDBY_gc, &stat) == drvNoError);
+    CHECK(stat.count == 0);
+    //Empty wheel lifts the limit
+    CHECK(sleepctrl_getMode(&mode) == drvNoError);
+    CHECK(mode == SLPCTRL_SMODE_PDOWN_gc);
+    //Nothing wakes standby up, model ends the sleep. Only a source set by the user times it
+    CHECK(sleepctrl_sleepIf(SLPCTRL_SMODE_STDBY_gc, &flags, 0xFF) == drvNoError);
+    CHECK(sleepctrl_getStat(SLPCTRL_SMODE_STDBY_gc, &stat) == drvNoError);
+    CHECK(stat.count == 1);
+    CHECK(stat.timeUs == 0);
+    testUs = 0;
+    CHECK(sleepctrl_setTimeSource(testTimeSrc) == drvNoError);
+    CHECK(sleepctrl_sleepIf(SLPCTRL_SMODE_STDBY_gc, &flags, 0xFF) == drvNoError);
+    CHECK(sleepctrl_getStat(SLPCTRL_SMODE_STDBY_gc, &stat) == drvNoError);
+    CHECK(stat.count == 2);
+    CHECK(stat.timeUs != 0);
+    CHECK(sleepctrl_setTimeSource(NULL) == drvNoError);
+}
+
+int main(void){
+    sim_reset();
+    sei();
+    CHECK(swtimer_init() == drvNoError);
+    testPeriodic();
+    testSleep();
+
+    return TEST_RESULT("swtimer_test");
+}
+
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
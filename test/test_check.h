@@ -0,0 +1,48 @@
+/*!****************************************************************************
+* @file    test_check.h
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Check macro shared by host unit tests
+*/
+
+#ifndef test_check_H
+#define test_check_H
+
+/*!****************************************************************************
+* Include
+*/
+#include <stdio.h>
+
+/*!****************************************************************************
+* User macro
+*/
+#define CHECK(cond)                             testCheck((cond), #cond, __LINE__)
+#define TEST_RESULT(name)                       testResult(name)
+
+/*!****************************************************************************
+* MEMORY
+*/
+static int testFails;
+
+/*!****************************************************************************
+* @brief    Count and report failed check
+*/
+static inline void testCheck(int cond, const char *pExpr, int line){
+    if(!cond){
+        printf("FAIL line %d: %s\n", line, pExpr);
+        testFails++;
+    }
+}
+
+/*!****************************************************************************
+* @brief    Report result of the whole test
+* @return   Process exit code
+*/
+static inline int testResult(const char *pName){
+    printf("%s: %s\n", pName, (testFails == 0) ? "OK" : "FAILED");
+    return (testFails == 0) ? 0 : 1;
+}
+
+#endif //test_check_H
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
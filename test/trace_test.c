@@ -0,0 +1,159 @@
+/*!****************************************************************************
+* @file    trace_test.c
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   Event trace recording, wrap and dump format against the models
+*/
+
+/*!****************************************************************************
+* Include
+*/
+#include <string.h>
+#include "trace.h"
+#include "spi.h"
+#include "clock.h"
+#include "crc.h"
+#include "sim.h"
+#include "test_check.h"
+
+/*!****************************************************************************
+* Local define
+*/
+#define TEST_SIZE                               4
+#define TEST_DUMP_SIZE                          (TRACE_HDR_SIZE + 3 * TRACE_BUF_SIZE + 2)
+#define TEST_BAUD                               19200
+
+/*!****************************************************************************
+* MEMORY
+*/
+static uint8_t testTx[TEST_SIZE];
+static uint8_t testRx[TEST_SIZE];
+static uint8_t testDump[TEST_DUMP_SIZE];
+static uint16_t testDumpLen;
+
+/*!****************************************************************************
+* @brief    Dump sink keeping bytes in memory
+*/
+static eDrvError testOut(uint8_t *pData, uint16_t size){
+    if(testDumpLen + size > TEST_DUMP_SIZE){
+        return drvHwError;
+    }
+    memcpy(&testDump[testDumpLen], pData, size);
+    testDumpLen += size;
+    return drvNoError;
+}
+
+/*!****************************************************************************
+* @brief    Dump and check framing
+* @return   Events in the dump
+*/
+static uint8_t testDumpCheck(void){
+    uint32_t hz, dumpHz;
+    uint16_t crc;
+    uint8_t num;
+
+    testDumpLen = 0;
+    CHECK(trace_dump(testOut) == drvNoError);
+    CHECK(testDump[0] == TRACE_MAGIC0);
+    CHECK(testDump[1] == TRACE_MAGIC1);
+    CHECK(testDump[2] == TRACE_FMT_VER);
+    num = testDump[3];
+    CHECK(testDumpLen == TRACE_HDR_SIZE + 3 * num + 2);
+    CHECK(clock_getHz(&hz) == drvNoError);
+    memcpy(&dumpHz, &testDump[4], sizeof(dumpHz));
+    CHECK(dumpHz == hz / TRACE_CLK_DIV);
+    crc = CRC16_INIT;
+    crc_calc16(testDump, testDumpLen - 2, &crc);
+    CHECK(testDump[testDumpLen - 2] == (uint8_t)(crc >> 8));
+    CHECK(testDump[testDumpLen - 1] == (uint8_t)crc);
+    return num;
+}
+
+/*!****************************************************************************
+* @brief    Driver scope records begin and end with rising stamps
+*/
+static void testScope(void){
+    uint16_t begin, end;
+
+    CHECK(trace_clear() == drvNoError);
+    CHECK(spi_transmitReceive(testTx, testRx, TEST_SIZE) == drvNoError);
+    traceEvent(traceIdUser);
+    CHECK(traceHead == 3);
+    CHECK(traceBuf[0].id == traceIdSpiTxRx);
+    CHECK(traceBuf[1].id == (traceIdSpiTxRx | TRACE_END));
+    CHECK(traceBuf[2].id == traceIdUser);
+    begin = traceBuf[0].stamp;
+    end = traceBuf[1].stamp;
+    //At least 8 SCK per byte, stamp counts CLK_PER / TRACE_CLK_DIV
+    CHECK((uint16_t)(end - begin) >= TEST_SIZE * 8 * 2 / TRACE_CLK_DIV);
+    CHECK(testDumpCheck() == 3);
+    CHECK(memcmp(&testDump[TRACE_HDR_SIZE], (uint8_t[]){traceIdSpiTxRx, (uint8_t)begin, (uint8_t)(begin >> 8)}, 3) == 0);
+}
+
+/*!****************************************************************************
+* @brief    Counter wrap is recorded, full buffer is dumped oldest first
+*/
+static void testWrap(void){
+    bool isWrap;
+    uint8_t i;
+
+    CHECK(trace_clear() == drvNoError);
+    sim_run((UINT16_MAX + 1UL) * TRACE_CLK_DIV + 64);
+    //Timeouts keep swtimer interrupts running in between
+    isWrap = false;
+    for(i = 0; i < traceHead; i++){
+        isWrap |= (traceBuf[i].id == traceIdWrap);
+    }
+    CHECK(isWrap);
+    //Overwrite all events and check order across the buffer end
+    cli();
+    for(i = 0; i < TRACE_BUF_SIZE + 1; i++){
+        traceEvent(traceIdUser + (i & 0x3F));
+    }
+    CHECK(testDumpCheck() == TRACE_BUF_SIZE);
+    for(i = 0; i < TRACE_BUF_SIZE; i++){
+        CHECK(testDump[TRACE_HDR_SIZE + 3 * i] == traceIdUser + ((i + 1) & 0x3F));
+    }
+    //Recording goes on after the dump
+    traceEvent(traceIdUser);
+    CHECK(traceBuf[(traceHead - 1) & TRACE_BUF_MASK].id == traceIdUser);
+    sei();
+}
+
+/*!****************************************************************************
+* @brief    Bit-banged dump takes 10 bits per byte
+*/
+static void testPin(void){
+    uint8_t data[2] = {0x55, 0xA5};
+    uint64_t start;
+
+    CHECK(trace_setPin(&PORTB, 8, TEST_BAUD) == drvBadParameter);
+    CHECK(trace_setPin(&PORTB, 2, 0) == drvBadParameter);
+    CHECK(trace_setPin(&PORTB, 2, TEST_BAUD) == drvNoError);
+    start = simStat.cycles;
+    CHECK(trace_pinTransmit(data, sizeof(data)) == drvNoError);
+    CHECK(simStat.cycles - start >= 2ULL * 10 * TRACE_CLK_DIV * (sim_getClkPerHz() / TRACE_CLK_DIV / TEST_BAUD));
+    //Stop bit leaves line idle
+    CHECK(PORTB.OUTSET == (1 << 2));
+}
+
+int main(void){
+    uint8_t i;
+
+    sim_reset();
+    sei();
+    for(i = 0; i < TEST_SIZE; i++){
+        testTx[i] = i;
+    }
+    CHECK(spi_init() == drvNoError);
+    CHECK(trace_init() == drvNoError);
+    CHECK(trace_dump(NULL) == drvBadParameter);
+    testScope();
+    testWrap();
+    testPin();
+
+    return TEST_RESULT("trace_test");
+}
+
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
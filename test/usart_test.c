@@ -0,0 +1,71 @@
+/*!****************************************************************************
+* @file    usart_test.c
+* @author  4eef
+* @version V1.0
+* @date    19.10.2026, 4eef
+* @brief   USART0 frames against the register-level model
+*/
+
+/*!****************************************************************************
+* Include
+*/
+#include <string.h>
+#include "usart.h"
+#include "sim.h"
+#include "test_check.h"
+
+/*!****************************************************************************
+* Local define
+*/
+#define TEST_BAUD                               115200UL
+#define TEST_SIZE                               8
+
+/*!****************************************************************************
+* MEMORY
+*/
+static uint8_t testTx[TEST_SIZE] = "tinyAVR!";
+static uint8_t testRx[TEST_SIZE];
+
+/*!****************************************************************************
+* @brief    Transmit returns when the last frame is out, frames back to back
+*/
+static void testTransmit(void){
+    uint32_t frameCyc;
+
+    frameCyc = USART_FRAME_BITS * sim_getClkPerHz() / TEST_BAUD;
+    sim_clearStat();
+    CHECK(usart_transmit(testTx, TEST_SIZE) == drvNoError);
+    CHECK(simUsartLog.len == TEST_SIZE);
+    CHECK(memcmp(simUsartLog.buf, testTx, TEST_SIZE) == 0);
+    CHECK(simStat.cycles >= (uint64_t)TEST_SIZE * frameCyc * 99 / 100);
+    CHECK(simStat.cycles <= (uint64_t)(TEST_SIZE + 1) * frameCyc);
+}
+
+/*!****************************************************************************
+* @brief    Receive takes each byte once, missing bytes end on timeout
+*/
+static void testReceive(void){
+    uint16_t count;
+
+    sim_usartRx(testTx, TEST_SIZE);
+    memset(testRx, 0, sizeof(testRx));
+    CHECK(usart_receive(testRx, TEST_SIZE) == drvNoError);
+    CHECK(memcmp(testRx, testTx, TEST_SIZE) == 0);
+    timeout_clearCounts();
+    sim_usartRx(testTx, 1);
+    CHECK(usart_receive(testRx, 2) == drvHwError);
+    CHECK(timeout_getCount(timeoutSiteUsartRx, &count) == drvNoError);
+    CHECK(count == 1);
+}
+
+int main(void){
+    sim_reset();
+    sei();
+    CHECK(usart_init(TEST_BAUD) == drvNoError);
+    testTransmit();
+    testReceive();
+
+    return TEST_RESULT("usart_test");
+}
+
+/***************** (C) COPYRIGHT ************** END OF FILE ******** 4eef ****/
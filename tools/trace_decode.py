@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+# Decode a trace_dump() stream into a timeline
+#
+# trace_decode.py dump.bin [--header inc/trace.h] [--csv]
+#
+# Event names come from eTraceId in trace.h. Stamps are 16-bit and are
+# unwrapped on traceIdWrap events (TRACE_WRAP_EN); without them a stamp below
+# the previous one is taken as one wrap, so longer gaps are lost. Times are
+# relative to the oldest event, scope end events get the duration since
+# their begin event.
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+MAGIC = b'TR'
+FMT_VER = 1
+HDR_SIZE = 8
+END = 0x80
+WRAP = 1
+USER = 0x40
+
+
+def crc16(data, crc=0xFFFF):
+    # CRC-16/CCITT-FALSE, as crc_calc16()
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xFFFF
+    return crc
+
+
+def read_names(header):
+    with open(header) as f:
+        text = f.read()
+    body = re.search(r'typedef enum\{(.*?)\}eTraceId;', text, re.S).group(1)
+    names = {}
+    value = 0
+    for line in body.splitlines():
+        m = re.match(r'\s*traceId(\w+)\s*(?:=\s*(\w+))?\s*,', line)
+        if not m:
+            continue
+        if m.group(2):
+            value = int(m.group(2), 0)
+        names[value] = m.group(1)
+        value += 1
+    return names
+
+
+def event_name(names, eid):
+    base = eid & ~END
+    if base in names:
+        name = names[base]
+    elif base >= USER:
+        name = 'User%d' % (base - USER)
+    else:
+        name = 'Id%d' % base
+    return name + ('.end' if eid & END else '')
+
+
+def decode(data, names):
+    if len(data) < HDR_SIZE + 2 or data[:2] != MAGIC:
+        raise ValueError('not a trace dump')
+    if data[2] != FMT_VER:
+        raise ValueError('format version %d is not supported' % data[2])
+    num = data[3]
+    hz = struct.unpack_from('<I', data, 4)[0]
+    size = HDR_SIZE + 3 * num
+    if len(data) < size + 2:
+        raise ValueError('dump is truncated, %d of %d bytes' % (len(data), size + 2))
+    if crc16(data[:size]) != struct.unpack_from('>H', data, size)[0]:
+        raise ValueError('CRC mismatch')
+    raw = [struct.unpack_from('<BH', data, HDR_SIZE + 3 * i) for i in range(num)]
+    has_wrap = any(eid == WRAP for eid, _ in raw)
+    events = []
+    open_scopes = {}
+    base = 0
+    pending = False
+    prev = None
+    first = None
+    for eid, stamp in raw:
+        if not has_wrap:
+            # Gaps are taken as shorter than one counter period
+            if prev is not None and stamp < prev:
+                base += 0x10000
+        elif eid == WRAP:
+            # Event seen after the wrap but before its interrupt already counted it
+            if pending:
+                pending = False
+            elif prev is not None:
+                base += 0x10000
+        elif prev is not None and stamp < prev and not pending:
+            base += 0x10000
+            pending = True
+        prev = stamp
+        ticks = base + stamp
+        if first is None:
+            first = ticks
+        us = (ticks - first) * 1e6 / hz
+        duration = None
+        if eid & END:
+            begin = open_scopes.pop(eid & ~END, None)
+            if begin is not None:
+                duration = us - begin
+        elif eid != WRAP:
+            open_scopes[eid] = us
+        events.append((us, event_name(names, eid), duration))
+    return hz, events
+
+
+def main():
+    ap = argparse.ArgumentParser(description='Trace dump to timeline')
+    ap.add_argument('dump')
+    ap.add_argument('--header', default=os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'inc', 'trace.h'))
+    ap.add_argument('--csv', action='store_true')
+    args = ap.parse_args()
+
+    with open(args.dump, 'rb') as f:
+        data = f.read()
+    # Serial capture may hold bytes before the dump
+    start = data.find(MAGIC + bytes([FMT_VER]))
+    if start < 0:
+        sys.exit('trace_decode: no dump found')
+    try:
+        hz, events = decode(data[start:], read_names(args.header))
+    except ValueError as e:
+        sys.exit('trace_decode: %s' % e)
+    if args.csv:
+        print('time_us,event,duration_us')
+        for us, name, duration in events:
+            print('%.3f,%s,%s' % (us, name, '' if duration is None else '%.3f' % duration))
+        return
+    print('%d events, stamp clock %d Hz' % (len(events), hz))
+    for us, name, duration in events:
+        line = '%12.3f us  %s' % (us, name)
+        if duration is not None:
+            line += '  (%.3f us)' % duration
+        print(line)
+
+
+if __name__ == '__main__':
+    main()